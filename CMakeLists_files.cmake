@@ -47,6 +47,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/flow/ExtraConvergenceOutputThread.cpp
   opm/simulators/flow/FlowMainEbos.cpp
   opm/simulators/flow/KeywordValidation.cpp
+  opm/simulators/flow/LoadBalanceMonitor.cpp
   opm/simulators/flow/LogOutputHelper.cpp
   opm/simulators/flow/Main.cpp
   opm/simulators/flow/NonlinearSolverEbos.cpp
@@ -74,6 +75,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/linalg/setupPropertyTree.cpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.cpp
   opm/simulators/timestepping/AdaptiveTimeSteppingEbos.cpp
+  opm/simulators/timestepping/ConvergenceRateModel.cpp
   opm/simulators/timestepping/TimeStepControl.cpp
   opm/simulators/timestepping/SimulatorTimer.cpp
   opm/simulators/timestepping/SimulatorTimerInterface.cpp
@@ -81,13 +83,18 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/utils/ComponentName.cpp
   opm/simulators/utils/compressPartition.cpp
   opm/simulators/utils/DeferredLogger.cpp
+  opm/simulators/utils/DeltaCheckpoint.cpp
+  opm/simulators/utils/FusedReduction.cpp
   opm/simulators/utils/gatherDeferredLogger.cpp
+  opm/simulators/utils/MemoryUsage.cpp
   opm/simulators/utils/ParallelFileMerger.cpp
   opm/simulators/utils/ParallelRestart.cpp
   opm/simulators/utils/PartiallySupportedFlowKeywords.cpp
   opm/simulators/utils/PressureAverage.cpp
   opm/simulators/utils/readDeck.cpp
   opm/simulators/utils/SerializationPackers.cpp
+  opm/simulators/utils/TimerTree.cpp
+  opm/simulators/utils/TwoLevelGather.cpp
   opm/simulators/utils/UnsupportedFlowKeywords.cpp
   opm/simulators/wells/ALQState.cpp
   opm/simulators/wells/BlackoilWellModelConstraints.cpp
@@ -241,7 +248,9 @@ if(MPI_FOUND)
                                 opm/simulators/utils/SetupZoltanParams.cpp)
 endif()
 if(HDF5_FOUND)
-  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/HDF5File.cpp)
+  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/HDF5CheckpointWriter.cpp
+                                opm/simulators/utils/HDF5File.cpp
+                                opm/simulators/utils/ParallelCellDataWriter.cpp)
 endif()
 
 # originally generated with the command:
@@ -250,12 +259,18 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_ALQState.cpp
   tests/test_aquifergridutils.cpp
   tests/test_blackoil_amg.cpp
+  tests/test_cachedfluxes.cpp
   tests/test_convergenceoutputconfiguration.cpp
+  tests/test_convergenceratemodel.cpp
   tests/test_convergencereport.cpp
   tests/test_deferredlogger.cpp
+  tests/test_DeltaCheckpoint.cpp
+  tests/test_DeterministicReduction.cpp
   tests/test_dilu.cpp
   tests/test_eclinterregflows.cpp
+  tests/test_ecltablesegmentcache.cpp
   tests/test_equil.cc
+  tests/test_explicitquantities.cpp
   tests/test_extractMatrix.cpp
   tests/test_flexiblesolver.cpp
   tests/test_glift1.cpp
@@ -278,6 +293,7 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_timer.cpp
   tests/test_vfpproperties.cpp
   tests/test_wellmodel.cpp
+  tests/test_wellperfdata.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
   )
@@ -328,6 +344,7 @@ endif()
 if(HDF5_FOUND)
   list(APPEND TEST_SOURCE_FILES tests/test_HDF5File.cpp)
   list(APPEND TEST_SOURCE_FILES tests/test_HDF5Serializer.cpp)
+  list(APPEND TEST_SOURCE_FILES tests/test_ParallelCellDataWriter.cpp)
 endif()
 
 list (APPEND TEST_DATA_FILES
@@ -373,6 +390,9 @@ list (APPEND TEST_DATA_FILES
   tests/options_flexiblesolver.json
   tests/options_flexiblesolver_simple.json
   tests/GLIFT1.DATA
+  tests/GLIFT_CONCURRENT.DATA
+  tests/explicit_quantities.DATA
+  tests/cached_fluxes.DATA
   tests/include/flowl_b_vfp.ecl
   tests/include/flowl_c_vfp.ecl
   tests/include/permx_model5.grdecl
@@ -419,6 +439,7 @@ list (APPEND PUBLIC_HEADER_FILES
   ebos/eclproblem.hh
   ebos/eclproblem_properties.hh
   ebos/eclsolutioncontainers.hh
+  ebos/ecltablesegmentcache.hh
   ebos/ecltimesteppingparams.hh
   ebos/eclthresholdpressure.hh
   ebos/ecltracermodel.hh
@@ -443,6 +464,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/NonlinearSolverEbos.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/KeywordValidation.hpp
+  opm/simulators/flow/LoadBalanceMonitor.hpp
   opm/simulators/flow/LogOutputHelper.hpp
   opm/simulators/flow/ValidationFunctions.hpp
   opm/simulators/flow/partitionCells.hpp
@@ -508,6 +530,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/PreconditionerFactory.hpp
   opm/simulators/linalg/PreconditionerWithUpdate.hpp
   opm/simulators/linalg/PropertyTree.hpp
+  opm/simulators/linalg/ReusableUMFPack.hpp
   opm/simulators/linalg/SmallDenseMatrixUtils.hpp
   opm/simulators/linalg/WellOperators.hpp
   opm/simulators/linalg/WriteSystemMatrixHelper.hpp
@@ -517,6 +540,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/setupPropertyTree.hpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp
   opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp
+  opm/simulators/timestepping/ConvergenceRateModel.hpp
   opm/simulators/timestepping/ConvergenceReport.hpp
   opm/simulators/timestepping/TimeStepControl.hpp
   opm/simulators/timestepping/TimeStepControlInterface.hpp
@@ -528,13 +552,19 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/utils/ParallelFileMerger.hpp
   opm/simulators/utils/DeferredLoggingErrorHelpers.hpp
   opm/simulators/utils/DeferredLogger.hpp
+  opm/simulators/utils/DeltaCheckpoint.hpp
+  opm/simulators/utils/DeterministicReduction.hpp
+  opm/simulators/utils/FusedReduction.hpp
   opm/simulators/utils/gatherDeferredLogger.hpp
+  opm/simulators/utils/MemoryUsage.hpp
   opm/simulators/utils/moduleVersion.hpp
   opm/simulators/utils/ParallelEclipseState.hpp
   opm/simulators/utils/ParallelNLDDPartitioningZoltan.hpp
   opm/simulators/utils/ParallelRestart.hpp
   opm/simulators/utils/PropsDataHandle.hpp
   opm/simulators/utils/SerializationPackers.hpp
+  opm/simulators/utils/TimerTree.hpp
+  opm/simulators/utils/TwoLevelGather.hpp
   opm/simulators/utils/VectorVectorDataHandle.hpp
   opm/simulators/utils/PressureAverage.hpp
   opm/simulators/utils/readDeck.hpp
@@ -613,12 +643,17 @@ endif()
 if(HDF5_FOUND)
   list(APPEND PUBLIC_HEADER_FILES
     ebos/hdf5serializer.hh
+    opm/simulators/utils/HDF5CheckpointWriter.hpp
     opm/simulators/utils/HDF5File.hpp
+    opm/simulators/utils/ParallelCellDataWriter.hpp
   )
 endif()
 
 list (APPEND EXAMPLE_SOURCE_FILES
+  examples/delta_checkpoint_benchmark.cpp
+  examples/linear_solver_benchmark.cpp
   examples/printvfp.cpp
+  examples/well_kernel_benchmark.cpp
 )
 if(HDF5_FOUND)
   list (APPEND EXAMPLE_SOURCE_FILES
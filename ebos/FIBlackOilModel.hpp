@@ -33,7 +33,9 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <cstddef>
 #include <stdexcept>
+#include <vector>
 
 namespace Opm
 {
@@ -48,6 +50,7 @@ class FIBlackOilModel : public BlackOilModel<TypeTag>
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Element = typename GridView::template Codim<0>::Entity;
     using ElementIterator = typename GridView::template Codim<0>::Iterator;
+    using EntitySeed = typename Element::EntitySeed;
     enum {
         numEq = getPropValue<TypeTag, Properties::NumEq>(),
         historySize = getPropValue<TypeTag, Properties::TimeDiscHistorySize>(),
@@ -111,6 +114,43 @@ public:
         OPM_END_PARALLEL_TRY_CATCH("InvalideAndUpdateIntensiveQuantitiesOverlap: state error", this->simulator_.vanguard().grid().comm());
     }
 
+    /*!
+     * \brief Invalidate and update the intensive quantities of the given cells only.
+     *
+     * The cached intensive quantities of all other cells are left untouched.
+     *
+     * \param timeIdx The index of the time level
+     * \param cells The element indices of the cells to update
+     */
+    void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx, const std::vector<unsigned>& cells) const
+    {
+        const auto& seeds = this->elementSeeds();
+        const auto& grid = this->gridView_.grid();
+        OPM_BEGIN_PARALLEL_TRY_CATCH()
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(this->simulator_);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for (std::size_t i = 0; i < cells.size(); ++i) {
+                const Element elem = grid.entity(seeds[cells[i]]);
+                elemCtx.updatePrimaryStencil(elem);
+                // Mark cache for this element as invalid.
+                const std::size_t numPrimaryDof = elemCtx.numPrimaryDof(timeIdx);
+                for (unsigned dofIdx = 0; dofIdx < numPrimaryDof; ++dofIdx) {
+                    const unsigned globalIndex = elemCtx.globalSpaceIndex(dofIdx, timeIdx);
+                    this->setIntensiveQuantitiesCacheEntryValidity(globalIndex, timeIdx, false);
+                }
+                // Update for this element.
+                elemCtx.updatePrimaryIntensiveQuantities(timeIdx);
+            }
+        }
+        OPM_END_PARALLEL_TRY_CATCH("InvalideAndUpdateIntensiveQuantities: state error", this->simulator_.vanguard().grid().comm());
+    }
+
     template <class GridSubDomain>
     void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx, const GridSubDomain& gridSubDomain) const
     {
@@ -169,6 +209,36 @@ public:
         }
         return *intquant;
     }
+
+    /*!
+     * \brief Return the heap memory held by the intensive quantity cache of all
+     *        time levels, in bytes.
+     */
+    std::size_t intensiveQuantityCacheMemoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (unsigned timeIdx = 0; timeIdx < historySize; ++timeIdx) {
+            bytes += this->intensiveQuantityCache_[timeIdx].capacity() * sizeof(IntensiveQuantities)
+                + this->intensiveQuantityCacheUpToDate_[timeIdx].capacity()
+                  * sizeof(this->intensiveQuantityCacheUpToDate_[timeIdx][0]);
+        }
+        return bytes;
+    }
+
+private:
+    // Seeds of all elements, indexed by element index. Built on first use.
+    const std::vector<EntitySeed>& elementSeeds() const
+    {
+        if (elementSeeds_.size() != static_cast<std::size_t>(this->gridView_.size(/*codim=*/0))) {
+            elementSeeds_.resize(this->gridView_.size(/*codim=*/0));
+            for (const auto& elem : elements(this->gridView_)) {
+                elementSeeds_[this->elementMapper().index(elem)] = elem.seed();
+            }
+        }
+        return elementSeeds_;
+    }
+
+    mutable std::vector<EntitySeed> elementSeeds_;
 };
 } // namespace Opm
 #endif // FI_BLACK_OIL_MODEL_HPP
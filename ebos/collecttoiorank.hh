@@ -34,6 +34,7 @@
 #include <opm/output/data/Wells.hpp>
 
 #include <opm/simulators/flow/EclInterRegFlows.hpp>
+#include <opm/simulators/utils/TwoLevelGather.hpp>
 
 #include <array>
 #include <cstddef>
@@ -73,7 +74,8 @@ public:
                         const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                         const std::set<std::string>& fipRegionsInterregFlow = {});
 
-    // gather solution to rank 0 for EclipseWriter
+    // gather solution to rank 0 for EclipseWriter, the restart fields are
+    // sent in single precision if singlePrecisionRestart is true
     void collect(const data::Solution&                                localCellData,
                  const std::map<std::pair<std::string, int>, double>& localBlockData,
                  const data::Wells&                                   localWellData,
@@ -83,7 +85,8 @@ public:
                  const WellTestState&                                 localWellTestState,
                  const EclInterRegFlowMap&                            interRegFlows,
                  const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFlowsn,
-                 const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFloresn);
+                 const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFloresn,
+                 bool singlePrecisionRestart = false);
 
     const std::map<std::pair<std::string, int>, double>& globalBlockData() const
     { return globalBlockData_; }
@@ -142,8 +145,19 @@ public:
 
     bool isCartIdxOnThisRank(int cartIdx) const;
 
+    // free the collected cell data and NNC flows once they are written
+    void releaseGlobalCellData();
+
+    // heap memory held by the collected data and the index maps, in bytes
+    std::size_t memoryUsage() const;
+
+    // collect with a node aware gather instead of point-to-point messages
+    void setGatherMethod(GatherMethod method)
+    { gatherMethod_ = method; }
+
 protected:
     P2PCommunicatorType toIORankComm_;
+    GatherMethod gatherMethod_ = GatherMethod::Flat;
     EclInterRegFlowMap globalInterRegFlows_;
     IndexMapType globalCartesianIndex_;
     IndexMapType localIndexMap_;
@@ -28,6 +28,8 @@
 
 #include <opm/grid/common/CartesianIndexMapper.hpp>
 
+#include <opm/simulators/utils/MemoryUsage.hpp>
+
 #include <dune/common/version.hh>
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/mcmgmapper.hh>
@@ -280,17 +282,22 @@ class PackUnPackCellData : public P2PCommunicatorType::DataHandleInterface
     const IndexMapType& localIndexMap_;
     const IndexMapStorageType& indexMaps_;
 
+    // send restart fields in single precision
+    bool singlePrecision_;
+
 public:
     PackUnPackCellData(const data::Solution& localCellData,
                        data::Solution& globalCellData,
                        const IndexMapType& localIndexMap,
                        const IndexMapStorageType& indexMaps,
                        std::size_t globalSize,
-                       bool isIORank)
+                       bool isIORank,
+                       bool singlePrecision = false)
         : localCellData_(localCellData)
         , globalCellData_(globalCellData)
         , localIndexMap_(localIndexMap)
         , indexMaps_(indexMaps)
+        , singlePrecision_(singlePrecision)
     {
         if (isIORank) {
             // add missing data to global cell data
@@ -323,7 +330,12 @@ public:
             const auto& data = pair.second.data;
 
             // write all data from local data to buffer
-            write(buffer, localIndexMap_, data);
+            if (reducePrecision(pair.second)) {
+                write<float>(buffer, localIndexMap_, data);
+            }
+            else {
+                write(buffer, localIndexMap_, data);
+            }
         }
     }
 
@@ -336,7 +348,12 @@ public:
             auto& data = globalCellData_.data(key);
 
             //write all data from local cell data to buffer
-            read(buffer, indexMap, data);
+            if (reducePrecision(pair.second)) {
+                read<float>(buffer, indexMap, data);
+            }
+            else {
+                read(buffer, indexMap, data);
+            }
         }
     }
 
@@ -345,7 +362,16 @@ public:
     { doUnpack(indexMaps_[link], buffer); }
 
 protected:
-    template <class Vector>
+    // Only the ECLIPSE restart fields are reduced, the OPM extended
+    // fields keep their full precision.
+    bool reducePrecision(const data::CellData& cellData) const
+    {
+        return singlePrecision_ &&
+            (cellData.target == data::TargetType::RESTART_SOLUTION ||
+             cellData.target == data::TargetType::RESTART_AUXILIARY);
+    }
+
+    template <class Value = double, class Vector>
     void write(MessageBufferType& buffer,
                const IndexMapType& localIndexMap,
                const Vector& vector,
@@ -359,11 +385,11 @@ protected:
         {
             unsigned int index = localIndexMap[i] * stride + offset;
             assert(index < vector.size());
-            buffer.write(vector[index]);
+            buffer.write(static_cast<Value>(vector[index]));
         }
     }
 
-    template <class Vector>
+    template <class Value = double, class Vector>
     void read(MessageBufferType& buffer,
               const IndexMapType& indexMap,
               Vector& vector,
@@ -376,7 +402,9 @@ protected:
         for (unsigned int i=0; i<size; ++i) {
             unsigned int index = indexMap[i] * stride + offset;
             assert(index < vector.size());
-            buffer.read(vector[index]);
+            Value value;
+            buffer.read(value);
+            vector[index] = value;
         }
     }
 };
@@ -840,6 +868,52 @@ public:
     }
 };
 
+/// \brief Gather the data of several handles on the I/O rank with a
+///        two-level gather instead of point-to-point messages.
+///
+/// The data of all handles are packed into a single buffer per rank,
+/// and unpacked on the I/O rank in rank order, using the same links as
+/// the point-to-point communicator.
+template <class Communication>
+void gatherToIORank(const std::vector<P2PCommunicatorType::DataHandleInterface*>& handles,
+                    const int ioRank,
+                    const Communication& comm)
+{
+    MessageBufferType buffer;
+    if (comm.rank() != ioRank) {
+        for (auto* handle : handles) {
+            handle->pack(0, buffer);
+        }
+    }
+
+    const auto packed = buffer.buffer();
+    const std::vector<char> local(packed.first, packed.first + packed.second);
+    std::vector<int> displ;
+    const auto global = gatherBuffers(local, displ, ioRank, comm, GatherMethod::TwoLevel);
+
+    if (comm.rank() != ioRank) {
+        return;
+    }
+
+    for (int rank = 0; rank < comm.size(); ++rank) {
+        if (rank == ioRank) {
+            continue;
+        }
+
+        MessageBufferType recv;
+        recv.resize(displ[rank + 1] - displ[rank]);
+        recv.resetReadPosition();
+        std::copy(global.begin() + displ[rank], global.begin() + displ[rank + 1],
+                  recv.buffer().first);
+
+        // Links enumerate the sending ranks in increasing order.
+        const int link = rank < ioRank ? rank : rank - 1;
+        for (auto* handle : handles) {
+            handle->unpack(link, recv);
+        }
+    }
+}
+
 template <class Grid, class EquilGrid, class GridView>
 CollectDataToIORank<Grid,EquilGrid,GridView>::
 CollectDataToIORank(const Grid& grid, const EquilGrid* equilGrid,
@@ -974,7 +1048,8 @@ collect(const data::Solution&                                localCellData,
         const WellTestState&                                 localWellTestState,
         const EclInterRegFlowMap&                            localInterRegFlows,
         const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFlowsn,
-        const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFloresn)
+        const std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3>& localFloresn,
+        const bool singlePrecisionRestart)
 {
     globalCellData_ = {};
     globalBlockData_.clear();
@@ -998,7 +1073,8 @@ collect(const data::Solution&                                localCellData,
         this->localIndexMap_,
         this->indexMaps_,
         this->numCells(),
-        this->isIORank()
+        this->isIORank(),
+        singlePrecisionRestart
     };
 
     if (! isParallel()) {
@@ -1070,16 +1146,31 @@ collect(const data::Solution&                                localCellData,
         this->isIORank()
     };
 
-    toIORankComm_.exchange(packUnpackCellData);
-    toIORankComm_.exchange(packUnpackWellData);
-    toIORankComm_.exchange(packUnpackGroupAndNetworkData);
-    toIORankComm_.exchange(packUnpackBlockData);
-    toIORankComm_.exchange(packUnpackWBPData);
-    toIORankComm_.exchange(packUnpackAquiferData);
-    toIORankComm_.exchange(packUnpackWellTestState);
-    toIORankComm_.exchange(packUnpackInterRegFlows);
-    toIORankComm_.exchange(packUnpackFlowsn);
-    toIORankComm_.exchange(packUnpackFloresn);
+    if (gatherMethod_ == GatherMethod::TwoLevel) {
+        gatherToIORank({&packUnpackCellData,
+                        &packUnpackWellData,
+                        &packUnpackGroupAndNetworkData,
+                        &packUnpackBlockData,
+                        &packUnpackWBPData,
+                        &packUnpackAquiferData,
+                        &packUnpackWellTestState,
+                        &packUnpackInterRegFlows,
+                        &packUnpackFlowsn,
+                        &packUnpackFloresn},
+                       ioRank, toIORankComm_);
+    }
+    else {
+        toIORankComm_.exchange(packUnpackCellData);
+        toIORankComm_.exchange(packUnpackWellData);
+        toIORankComm_.exchange(packUnpackGroupAndNetworkData);
+        toIORankComm_.exchange(packUnpackBlockData);
+        toIORankComm_.exchange(packUnpackWBPData);
+        toIORankComm_.exchange(packUnpackAquiferData);
+        toIORankComm_.exchange(packUnpackWellTestState);
+        toIORankComm_.exchange(packUnpackInterRegFlows);
+        toIORankComm_.exchange(packUnpackFlowsn);
+        toIORankComm_.exchange(packUnpackFloresn);
+    }
 
 #ifndef NDEBUG
     // make sure every process is on the same page
@@ -1124,5 +1215,31 @@ isCartIdxOnThisRank(int cartIdx) const
         && (*candidate == cartIdx);
 }
 
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataToIORank<Grid,EquilGrid,GridView>::
+releaseGlobalCellData()
+{
+    this->globalCellData_ = {};
+    this->globalFlowsn_ = {};
+    this->globalFloresn_ = {};
+}
+
+template <class Grid, class EquilGrid, class GridView>
+std::size_t CollectDataToIORank<Grid,EquilGrid,GridView>::
+memoryUsage() const
+{
+    // data::Solution is a map from keyword to data::CellData.
+    std::size_t cellData = this->globalCellData_.size()
+        * (sizeof(typename data::Solution::value_type) + 4 * sizeof(void*));
+    for (const auto& [name, cells] : this->globalCellData_) {
+        cellData += heapBytes(name) + heapBytes(cells.data);
+    }
+
+    return cellData
+        + totalHeapBytes(globalCartesianIndex_, localIndexMap_, indexMaps_,
+                         globalRanks_, globalBlockData_, localIdxToGlobalIdx_,
+                         globalFlowsn_, globalFloresn_, sortedCartesianIdx_);
+}
+
 } // end namespace Opm
 #endif
@@ -348,10 +348,14 @@ private:
                 damarisOutputModule_->processElementFlows(elemCtx);
             }
         }
-        {
+        if (!damarisOutputModule_->getBlockData().empty()) {
         OPM_TIMEBLOCK(prepareBlockData);
         for (const auto& elem : elements(gridView)) {
             elemCtx.updatePrimaryStencil(elem);
+            const auto globalDofIdx = elemCtx.globalSpaceIndex(/*dofIdx=*/0, /*timeIdx=*/0);
+            if (!damarisOutputModule_->isBlockDataCell(simulator_.vanguard().cartesianIndex(globalDofIdx))) {
+                continue;
+            }
             elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
             damarisOutputModule_->processElementBlockData(elemCtx);
         }
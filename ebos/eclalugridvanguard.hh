@@ -156,11 +156,8 @@ public:
      */
     void releaseEquilGrid()
     {
-        delete equilCartesianIndexMapper_;
-        equilCartesianIndexMapper_ = nullptr;
-
-        delete equilGrid_;
-        equilGrid_ = nullptr;
+        equilCartesianIndexMapper_.reset();
+        equilGrid_.reset();
     }
 
     /*!
@@ -46,6 +46,7 @@
 #include <opm/models/utils/signum.hh>
 
 #include <array>
+#include <cmath>
 
 namespace Opm {
 
@@ -334,20 +335,21 @@ public:
         }
 
         // do the gravity correction: compute the hydrostatic pressure for the
-        // external at the depth of the internal one
-        const Evaluation& rhoIn = intQuantsIn.fluidState().density(phaseIdx);
+        // external at the depth of the internal one. EvalType is either Evaluation or,
+        // if no derivatives are needed, Scalar.
+        const auto& rhoIn = intQuantsIn.fluidState().density(phaseIdx);
         Scalar rhoEx = Toolbox::value(intQuantsEx.fluidState().density(phaseIdx));
-        Evaluation rhoAvg = (rhoIn + rhoEx)/2;
+        EvalType rhoAvg = (decay<EvalType>(rhoIn) + rhoEx)/2;
 
-        const Evaluation& pressureInterior = intQuantsIn.fluidState().pressure(phaseIdx);
-        Evaluation pressureExterior = Toolbox::value(intQuantsEx.fluidState().pressure(phaseIdx));
+        const auto& pressureInterior = intQuantsIn.fluidState().pressure(phaseIdx);
+        EvalType pressureExterior = Toolbox::value(intQuantsEx.fluidState().pressure(phaseIdx));
         if (enableExtbo) // added stability; particulary useful for solvent migrating in pure water
                          // where the solvent fraction displays a 0/1 behaviour ...
-            pressureExterior += Toolbox::value(rhoAvg)*(distZg);
+            pressureExterior += getValue(rhoAvg)*(distZg);
         else
             pressureExterior += rhoAvg*(distZg);
 
-        pressureDifference = pressureExterior - pressureInterior;
+        pressureDifference = pressureExterior - decay<EvalType>(pressureInterior);
 
         // decide the upstream index for the phase. for this we make sure that the
         // degree of freedom which is regarded upstream if both pressures are equal
@@ -392,7 +394,7 @@ public:
         // datasets. (and even there, its physical justification is quite
         // questionable IMO.)
         if (thpres > 0.0) {
-            if (std::abs(Toolbox::value(pressureDifference)) > thpres) {
+            if (std::abs(getValue(pressureDifference)) > thpres) {
                 if (pressureDifference < 0.0)
                     pressureDifference += thpres;
                 else
@@ -404,6 +406,65 @@ public:
         }
     }
 
+    /*!
+     * \brief Compute the volumetric rates of the phases across an interior face
+     *        from the values of the intensive quantities [m^3/s]
+     *
+     * This evaluates the same fluxes as volumeAndPhasePressureDifferences() without
+     * derivatives and without an element context, e.g., to get the fluxes of the last
+     * linearization for output. The rates are positive for flow from the interior to
+     * the exterior degree of freedom.
+     */
+    template <class Problem>
+    static void phaseVolumeRates(std::array<bool, numPhases>& upwindIsInterior,
+                                 std::array<Scalar, numPhases>& volumeRates,
+                                 const Problem& problem,
+                                 const IntensiveQuantities& intQuantsIn,
+                                 const IntensiveQuantities& intQuantsEx,
+                                 const unsigned globalIndexIn,
+                                 const unsigned globalIndexEx,
+                                 const FaceDir::DirEnum facedir)
+    {
+        const Scalar trans = problem.transmissibility(globalIndexIn, globalIndexEx);
+        const Scalar thpres = problem.thresholdPressure(globalIndexIn, globalIndexEx);
+        const Scalar distZg = (problem.dofCenterDepth(globalIndexIn) - problem.dofCenterDepth(globalIndexEx))
+            * problem.gravity()[dimWorld - 1];
+        const Scalar Vin = problem.model().dofTotalVolume(globalIndexIn);
+        const Scalar Vex = problem.model().dofTotalVolume(globalIndexEx);
+
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            upwindIsInterior[phaseIdx] = true;
+            volumeRates[phaseIdx] = 0.0;
+            if (!FluidSystem::phaseIsActive(phaseIdx))
+                continue;
+
+            short upIdx;
+            short dnIdx;
+            Scalar pressureDifference;
+            calculatePhasePressureDiff_(upIdx,
+                                        dnIdx,
+                                        pressureDifference,
+                                        intQuantsIn,
+                                        intQuantsEx,
+                                        phaseIdx,
+                                        /*interiorDofIdx=*/0,
+                                        /*exteriorDofIdx=*/1,
+                                        Vin,
+                                        Vex,
+                                        globalIndexIn,
+                                        globalIndexEx,
+                                        distZg,
+                                        thpres);
+            if (pressureDifference == 0)
+                continue;
+
+            upwindIsInterior[phaseIdx] = (upIdx == 0);
+            const IntensiveQuantities& up = upwindIsInterior[phaseIdx] ? intQuantsIn : intQuantsEx;
+            volumeRates[phaseIdx] = pressureDifference*Toolbox::value(up.mobility(phaseIdx, facedir))
+                *Toolbox::value(up.rockCompTransMultiplier())*(-trans);
+        }
+    }
+
 protected:
     /*!
      * \brief Update the required gradients for interior faces
@@ -39,6 +39,7 @@
 #include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
 
+#include <opm/simulators/utils/MemoryUsage.hpp>
 #include <opm/simulators/utils/PressureAverage.hpp>
 
 #include <algorithm>
@@ -191,6 +192,21 @@ EclGenericOutputBlackoilModule(const EclipseState& eclState,
         this->regionNodes_[phase] = summaryConfig_.keywords(key_pattern);
     }
 
+    // Summary vectors evaluated from the fluid in place region sums.  All
+    // region vectors are included to be on the safe side.
+    const auto phases = Inplace::phases();
+    this->summaryNeedsInplace_ =
+        std::any_of(summaryConfig_.begin(), summaryConfig_.end(),
+                    [](const SummaryConfigNode& node)
+                    { return node.category() == SummaryConfigNode::Category::Region; }) ||
+        std::any_of(phases.begin(), phases.end(),
+                    [this](const Inplace::Phase phase)
+                    { return this->summaryConfig_.hasKeyword("F" + EclString(phase)); }) ||
+        summaryConfig_.hasKeyword("FHPV") ||
+        summaryConfig_.hasKeyword("FOE")  ||
+        summaryConfig_.hasKeyword("FPR")  ||
+        summaryConfig_.hasKeyword("FPRP");
+
     // Check for any BFLOW[I|J|K] summary keys
     blockFlows_ = summaryConfig_.keywords("BFLOW*").size() > 0;
 
@@ -226,6 +242,38 @@ template<class FluidSystem, class Scalar>
 EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 ~EclGenericOutputBlackoilModule() = default;
 
+template<class FluidSystem, class Scalar>
+std::size_t EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+memoryUsage() const
+{
+    return totalHeapBytes(fip_, regions_, regionNodes_, RPRNodes_, RPRPNodes_,
+                          failedCellsPb_, failedCellsPd_, gasFormationVolumeFactor_,
+                          hydrocarbonPoreVolume_, pressureTimesPoreVolume_,
+                          pressureTimesHydrocarbonVolume_, dynamicPoreVolume_,
+                          fluidPressure_, temperature_, rs_, rsw_, rv_, rvw_,
+                          overburdenPressure_, oilSaturationPressure_, drsdtcon_,
+                          sSol_, cPolymer_, cFoam_, cSalt_, pSalt_, permFact_,
+                          extboX_, extboY_, extboZ_, mFracOil_, mFracGas_,
+                          mFracCo2_, soMax_, pcSwMdcOw_, krnSwMdcOw_, pcSwMdcGo_,
+                          krnSwMdcGo_, ppcw_, gasDissolutionFactor_,
+                          oilVaporizationFactor_, bubblePointPressure_,
+                          dewPointPressure_, rockCompPorvMultiplier_, swMax_,
+                          minimumOilPressure_, saturatedOilFormationVolumeFactor_,
+                          rockCompTransMultiplier_, cMicrobes_, cOxygen_, cUrea_,
+                          cBiofilm_, cCalcite_, pcow_, pcog_, mechPotentialForce_,
+                          mechPotentialPressForce_, mechPotentialTempForce_, dispX_,
+                          dispY_, dispZ_, stressXX_, stressYY_, stressZZ_,
+                          stressXY_, stressXZ_, stressYZ_, delstressXX_,
+                          delstressYY_, delstressZZ_, delstressXY_, delstressXZ_,
+                          delstressYZ_, strainXX_, strainYY_, strainZZ_, strainXY_,
+                          strainXZ_, strainYZ_, saturation_, invB_, density_,
+                          viscosity_, relativePermeability_, tracerConcentrations_,
+                          residual_, flowsi_, flowsj_, flowsk_, floresi_, floresj_,
+                          floresk_, floresn_, flowsn_, oilConnectionPressures_,
+                          waterConnectionSaturations_, gasConnectionSaturations_,
+                          blockData_);
+}
+
 template<class FluidSystem, class Scalar>
 void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
 outputCumLog(std::size_t reportStepNum, const bool substep, bool forceDisableCumOutput)
@@ -269,6 +317,9 @@ outputFipLog(std::map<std::string, double>& miscSummaryData,
              const bool substep,
              const Parallel::Communication& comm)
 {
+    if (!this->needRegionSums(reportStepNum, substep))
+        return {};
+
     auto inplace = this->accumulateRegionSums(comm);
     if (comm.rank() != 0)
         return inplace;
@@ -304,20 +355,14 @@ outputFipLog(std::map<std::string, double>& miscSummaryData,
 }
 
 template<class FluidSystem,class Scalar>
-Inplace EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
-outputFipresvLog(std::map<std::string, double>& miscSummaryData,
-                 std::map<std::string, std::vector<double>>& regionData,
+void EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+outputFipresvLog(const Inplace& inplace,
                  const std::size_t reportStepNum,
                  const bool substep,
                  const Parallel::Communication& comm)
 {
-    auto inplace = this->accumulateRegionSums(comm);
     if (comm.rank() != 0)
-        return inplace;
-
-    updateSummaryRegionValues(inplace,
-                              miscSummaryData,
-                              regionData);
+        return;
 
     // For report step 0 we use the RPTSOL config, else derive from RPTSCHED
     std::unique_ptr<FIPConfig> fipSched;
@@ -331,8 +376,27 @@ outputFipresvLog(std::map<std::string, double>& miscSummaryData,
     if (!substep && !forceDisableFipresvOutput_ && fipc.output(FIPConfig::OutputField::RESV)) {
         logOutput_.fipResv(inplace);
     }
+}
 
-    return inplace;
+template<class FluidSystem,class Scalar>
+bool EclGenericOutputBlackoilModule<FluidSystem,Scalar>::
+needRegionSums(const std::size_t reportStepNum,
+               const bool substep) const
+{
+    // The first sums are kept as the initial fluid in place.
+    if (this->summaryNeedsInplace_ || !this->initialInplace_.has_value())
+        return true;
+
+    if (substep)
+        return false;
+
+    // For report step 0 we use the RPTSOL config, else derive from RPTSCHED
+    const FIPConfig fipc = reportStepNum == 0
+        ? this->eclState_.getEclipseConfig().fip()
+        : FIPConfig(this->schedule_[reportStepNum].rpt_config.get());
+
+    return (!forceDisableFipOutput_ && fipc.output(FIPConfig::OutputField::FIELD)) ||
+           (!forceDisableFipresvOutput_ && fipc.output(FIPConfig::OutputField::RESV));
 }
 
 template<class FluidSystem,class Scalar>
@@ -765,9 +829,14 @@ doAllocBuffers(const unsigned bufferSize,
     this->outputFipRestart_ = false;
     this->computeFip_ = false;
 
-    // Fluid in place
+    // Fluid in place.  On report steps all phases are needed for the
+    // restart file or for the region sums, unless no summary vector or
+    // FIP report asks for the latter.
+    const auto fipReportStep = !substep &&
+        ((rstKeywords["FIP"] > 0) || this->needRegionSums(reportStepNum, substep));
+
     for (const auto& phase : Inplace::phases()) {
-        if (!substep || summaryConfig_.require3DField(EclString(phase))) {
+        if (fipReportStep || summaryConfig_.require3DField(EclString(phase))) {
             if (auto& fip = rstKeywords["FIP"]; fip > 0) {
                 fip = 0;
                 this->outputFipRestart_ = true;
@@ -781,7 +850,7 @@ doAllocBuffers(const unsigned bufferSize,
         }
     }
 
-    const auto needAvgPress = !substep         ||
+    const auto needAvgPress = fipReportStep    ||
         !this->RPRNodes_.empty()               ||
         this->summaryConfig_.hasKeyword("FPR") ||
         this->summaryConfig_.hasKeyword("FPRP");
@@ -1448,6 +1517,7 @@ setupBlockData(std::function<bool(int)> isCartIdxOnThisRank)
                                      std::forward_as_tuple(node.keyword(),
                                                            node.number()),
                                      std::forward_as_tuple(0.0));
+            this->blockDataCells_.insert(node.number() - 1);
         }
     }
 }
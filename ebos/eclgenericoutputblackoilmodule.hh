@@ -38,6 +38,7 @@
 #include <optional>
 #include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -76,19 +77,26 @@ public:
                       const bool substep,
                       bool forceDisableInjOutput);
 
-    // write Fluid In Place to output log
+    // write Fluid In Place to output log and fill the summary vectors
+    // derived from it. The region sums are only accumulated when needed,
+    // see needRegionSums(), otherwise an empty Inplace is returned.
     Inplace outputFipLog(std::map<std::string, double>& miscSummaryData,
                          std::map<std::string, std::vector<double>>& regionData,
                          const std::size_t reportStepNum,
                          const bool substep,
                          const Parallel::Communication& comm);
 
-    // write Reservoir Volumes to output log
-    Inplace outputFipresvLog(std::map<std::string, double>& miscSummaryData,
-                         std::map<std::string, std::vector<double>>& regionData,
-                         const std::size_t reportStepNum,
-                         const bool substep,
-                         const Parallel::Communication& comm);
+    // write Reservoir Volumes to output log, using the region sums
+    // returned by outputFipLog()
+    void outputFipresvLog(const Inplace& inplace,
+                          const std::size_t reportStepNum,
+                          const bool substep,
+                          const Parallel::Communication& comm);
+
+    // whether the fluid in place region sums are needed in a step, either
+    // by the summary vectors or by the FIP and FIPRESV reports
+    bool needRegionSums(const std::size_t reportStepNum,
+                        const bool substep) const;
 
     void outputErrorLog(const Parallel::Communication& comm) const;
 
@@ -247,11 +255,20 @@ public:
         return blockData_;
     }
 
+    // Whether a block vector is requested for a cell on this rank.
+    bool isBlockDataCell(const int cartesianIdx) const
+    {
+        return this->blockDataCells_.count(cartesianIdx) > 0;
+    }
+
     const Inplace& initialInplace() const
     {
         return this->initialInplace_.value();
     }
 
+    // Heap memory held by the output buffers, in bytes.
+    std::size_t memoryUsage() const;
+
     bool localDataValid() const{
         return local_data_valid_;
     }
@@ -367,6 +384,7 @@ protected:
     bool forceDisableFipresvOutput_;
     bool outputFipRestart_;
     bool computeFip_;
+    bool summaryNeedsInplace_;
 
     bool anyFlows_;
     bool anyFlores_;
@@ -487,6 +505,7 @@ protected:
     std::map<std::size_t, Scalar> waterConnectionSaturations_;
     std::map<std::size_t, Scalar> gasConnectionSaturations_;
     std::map<std::pair<std::string, int>, double> blockData_;
+    std::unordered_set<int> blockDataCells_;
 
     std::optional<Inplace> initialInplace_;
     bool local_data_valid_;
@@ -108,6 +108,18 @@ public:
         return outputNnc_;
     }
 
+    // Heap memory held by the data collected on the I/O rank, in bytes.
+    std::size_t collectedDataMemoryUsage() const
+    {
+        return collectToIORank_.memoryUsage();
+    }
+
+    // Algorithm used to gather output data on the I/O rank.
+    void setGatherMethod(GatherMethod method)
+    {
+        collectToIORank_.setGatherMethod(method);
+    }
+
 protected:
     const TransmissibilityType& globalTrans() const;
     unsigned int gridEquilIdxToGridIdx(unsigned int elemIndex) const;
@@ -35,6 +35,8 @@
 #include <opm/common/TimingMacros.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
+
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/fluidmatrixinteractions/EclEpsScalingPoints.hpp>
 #include <opm/material/fluidstates/BlackOilFluidState.hpp>
@@ -99,10 +101,13 @@ struct ForceDisableResvFluidInPlaceOutput<TypeTag, TTag::EclOutputBlackOil> {
 namespace Opm
 {
 
-// forward declaration
+// forward declarations
 template <class TypeTag>
 class EcfvDiscretization;
 
+template <class TypeTag>
+struct EclTransFluxModule;
+
 /*!
  * \ingroup EclBlackOilSimulator
  *
@@ -1005,6 +1010,122 @@ public:
         }
     }
 
+    /*!
+     * \brief Whether processCachedFluxes() is able to capture connection
+     *    fluxes.
+     *
+     * This requires the ECL transmissibility flux module without polymer,
+     * whose shear multipliers modify the phase fluxes beyond what the
+     * intensive quantities determine.
+     */
+    static constexpr bool canProcessCachedFluxes()
+    {
+        return std::is_same_v<Discretization, EcfvDiscretization<TypeTag>>
+            && std::is_same_v<GetPropType<TypeTag, Properties::FluxModule>,
+                              EclTransFluxModule<TypeTag>>
+            && !getPropValue<TypeTag, Properties::EnablePolymer>();
+    }
+
+    /*!
+     * \brief Capture connection fluxes, particularly to account for
+     *    inter-region flows, from the cached intensive quantities.
+     *
+     * Equivalent to calling processFluxes() for all interior and border
+     * elements, but evaluates the phase fluxes without derivatives from
+     * the intensive quantities of the last linearization instead of
+     * setting up stencils and extensive quantities for every element.
+     * The connections that contribute to the inter-region flows are stored
+     * in a compact face table on the first call.
+     *
+     * Nothing is captured if the intensive quantity cache is disabled or
+     * not up to date for a cell of the face table, or if
+     * canProcessCachedFluxes() is false.  The caller then needs to use
+     * processFluxes() instead.
+     *
+     * \tparam ActiveIndex Callable type, typically a lambda, that enables
+     *    retrieving the active index, on the local MPI rank, of a
+     *    particular cell/element.  See processFluxes().
+     *
+     * \tparam CartesianIndex Callable type, typically a lambda, that
+     *    enables retrieving the globally unique Cartesian index of a
+     *    particular cell/element given its active index on the local MPI
+     *    rank.  See processFluxes().
+     *
+     * \param[in] activeIndex Mapping from cell/elements to linear indices
+     *    on local MPI rank.
+     *
+     * \param[in] cartesianIndex Mapping from active index on local MPI rank
+     *    to globally unique Cartesian cell/element index.
+     *
+     * \return Whether the connection fluxes were captured.
+     */
+    template <class ActiveIndex, class CartesianIndex>
+    bool processCachedFluxes([[maybe_unused]] ActiveIndex&&    activeIndex,
+                             [[maybe_unused]] CartesianIndex&& cartesianIndex)
+    {
+        OPM_TIMEBLOCK_LOCAL(processCachedFluxes);
+        if constexpr (canProcessCachedFluxes()) {
+            if (! this->fluxFacesValid_) {
+                this->setupFluxFaces_(activeIndex, cartesianIndex);
+            }
+
+            using FluxExtensiveQuantities = typename EclTransFluxModule<TypeTag>::FluxExtensiveQuantities;
+
+            const auto& model = this->simulator_.model();
+            const auto& problem = this->simulator_.problem();
+
+            const auto isCached = [&model](const EclInterRegFlowMap::Cell& cell)
+            {
+                return model.cachedIntensiveQuantities(cell.activeIndex, /*timeIdx=*/0) != nullptr;
+            };
+            for (const auto& face : this->fluxFaces_) {
+                if (! isCached(face.interior) || ! isCached(face.exterior)) {
+                    return false;
+                }
+            }
+
+            auto upwindIsInterior = std::array<bool, numPhases>{};
+            auto volumeRates = std::array<Scalar, numPhases>{};
+            for (const auto& face : this->fluxFaces_) {
+                const unsigned in = face.interior.activeIndex;
+                const unsigned ex = face.exterior.activeIndex;
+                const auto& intQuantsIn = *model.cachedIntensiveQuantities(in, /*timeIdx=*/0);
+                const auto& intQuantsEx = *model.cachedIntensiveQuantities(ex, /*timeIdx=*/0);
+
+                FluxExtensiveQuantities::phaseVolumeRates(upwindIsInterior, volumeRates, problem,
+                                                          intQuantsIn, intQuantsEx, in, ex,
+                                                          face.faceDir);
+
+                const auto rates = this->componentSurfaceRates_(
+                    [&upwindIsInterior, &intQuantsIn, &intQuantsEx](const unsigned phaseIdx)
+                        -> const IntensiveQuantities&
+                    {
+                        return upwindIsInterior[phaseIdx] ? intQuantsIn : intQuantsEx;
+                    },
+                    [&volumeRates](const unsigned phaseIdx)
+                    {
+                        return volumeRates[phaseIdx];
+                    });
+
+                this->interRegionFlows_.addConnection(face.interior, face.exterior, rates);
+            }
+
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    /*!
+     * \brief Heap memory held by the face table of processCachedFluxes(),
+     *    in bytes.
+     */
+    std::size_t fluxFaceMemoryUsage() const
+    {
+        return this->fluxFaces_.capacity() * sizeof(FluxFace);
+    }
+
     /*!
      * \brief Prepare for capturing connection fluxes, particularly to
      *    account for inter-region flows.
@@ -1173,17 +1294,50 @@ private:
                              const std::size_t     scvfIdx,
                              const std::size_t     timeIdx) const
     {
-        using Component = data::InterRegFlowMap::Component;
-
-        auto rates = data::InterRegFlowMap::FlowRates {};
-
         const auto& extQuant = elemCtx.extensiveQuantities(scvfIdx, timeIdx);
 
         const auto alpha = getValue(extQuant.extrusionFactor()) * faceArea;
 
+        return this->componentSurfaceRates_(
+            [&elemCtx, &extQuant, timeIdx](const unsigned phaseIdx) -> const IntensiveQuantities&
+            {
+                return elemCtx.intensiveQuantities(extQuant.upstreamIndex(phaseIdx), timeIdx);
+            },
+            [&extQuant, alpha](const unsigned phaseIdx)
+            {
+                return alpha * getValue(extQuant.volumeFlux(phaseIdx));
+            });
+    }
+
+    /*!
+     * \brief Compute surface level component flow rates from the
+     *   reservoir volume rates of the phases.
+     *
+     * \param[in] upstream Intensive quantities of the upstream cell of a
+     *    phase.  Must support a function call operator of the form
+     \code
+        const IntensiveQuantities& operator()(const unsigned phaseIdx) const
+     \endcode
+     *
+     * \param[in] volumeRate Reservoir volume rate of a phase across the
+     *    connection.  Must support a function call operator of the form
+     \code
+        Scalar operator()(const unsigned phaseIdx) const
+     \endcode
+     *
+     * \return Surface level component flow rates.
+     */
+    template <class Upstream, class VolumeRate>
+    data::InterRegFlowMap::FlowRates
+    componentSurfaceRates_(Upstream&&   upstream,
+                           VolumeRate&& volumeRate) const
+    {
+        using Component = data::InterRegFlowMap::Component;
+
+        auto rates = data::InterRegFlowMap::FlowRates {};
+
         if (FluidSystem::phaseIsActive(oilPhaseIdx)) {
-            const auto& up = elemCtx
-                .intensiveQuantities(extQuant.upstreamIndex(oilPhaseIdx), timeIdx);
+            const auto& up = upstream(oilPhaseIdx);
 
             using FluidState = std::remove_cv_t<std::remove_reference_t<
                 decltype(up.fluidState())>>;
@@ -1193,7 +1347,7 @@ private:
             const auto bO = getValue(getInvB_<FluidSystem, FluidState, Scalar>
                                      (up.fluidState(), oilPhaseIdx, pvtReg));
 
-            const auto qO = alpha * bO * getValue(extQuant.volumeFlux(oilPhaseIdx));
+            const auto qO = bO * volumeRate(oilPhaseIdx);
 
             rates[Component::Oil] += qO;
 
@@ -1208,8 +1362,7 @@ private:
         }
 
         if (FluidSystem::phaseIsActive(gasPhaseIdx)) {
-            const auto& up = elemCtx
-                .intensiveQuantities(extQuant.upstreamIndex(gasPhaseIdx), timeIdx);
+            const auto& up = upstream(gasPhaseIdx);
 
             using FluidState = std::remove_cv_t<std::remove_reference_t<
                 decltype(up.fluidState())>>;
@@ -1219,7 +1372,7 @@ private:
             const auto bG = getValue(getInvB_<FluidSystem, FluidState, Scalar>
                                      (up.fluidState(), gasPhaseIdx, pvtReg));
 
-            const auto qG = alpha * bG * getValue(extQuant.volumeFlux(gasPhaseIdx));
+            const auto qG = bG * volumeRate(gasPhaseIdx);
 
             rates[Component::Gas] += qG;
 
@@ -1234,8 +1387,7 @@ private:
         }
 
         if (FluidSystem::phaseIsActive(waterPhaseIdx)) {
-            const auto& up = elemCtx
-                .intensiveQuantities(extQuant.upstreamIndex(waterPhaseIdx), timeIdx);
+            const auto& up = upstream(waterPhaseIdx);
 
             using FluidState = std::remove_cv_t<std::remove_reference_t<
                 decltype(up.fluidState())>>;
@@ -1246,7 +1398,7 @@ private:
                                      (up.fluidState(), waterPhaseIdx, pvtReg));
 
             rates[Component::Water] +=
-                alpha * bW * getValue(extQuant.volumeFlux(waterPhaseIdx));
+                bW * volumeRate(waterPhaseIdx);
         }
 
         return rates;
@@ -1558,7 +1710,69 @@ private:
         return xoG * pv * rhoo * so / mM;
     }
 
+    /*!
+     * \brief Set up the face table of processCachedFluxes().
+     *
+     * Only the connections between different regions of at least one
+     * region set are stored, see
+     * EclInterRegFlowMap::isInterRegionConnection().  The grid does not
+     * change during the run, so the table is kept until the end.
+     */
+    template <class ActiveIndex, class CartesianIndex>
+    void setupFluxFaces_(ActiveIndex& activeIndex, CartesianIndex& cartesianIndex)
+    {
+        OPM_TIMEBLOCK(setupFluxFaces);
+        const auto identifyCell = [&activeIndex, &cartesianIndex](const Element& elem)
+            -> EclInterRegFlowMap::Cell
+        {
+            const auto cellIndex = activeIndex(elem);
+
+            return {
+                static_cast<int>(cellIndex),
+                cartesianIndex(cellIndex),
+                elem.partitionType() == Dune::InteriorEntity
+            };
+        };
+
+        const bool directional = this->simulator_.problem().materialLawManager()->hasDirectionalRelperms();
+
+        this->fluxFaces_.clear();
+
+        ElementContext elemCtx(this->simulator_);
+        for (const auto& elem : elements(this->simulator_.gridView(), Dune::Partitions::interior)) {
+            elemCtx.updateStencil(elem);
+
+            const auto& stencil = elemCtx.stencil(/*timeIdx=*/0);
+            const auto numInteriorFaces = elemCtx.numInteriorFaces(/*timeIdx=*/0);
+            for (auto scvfIdx = 0 * numInteriorFaces; scvfIdx < numInteriorFaces; ++scvfIdx) {
+                const auto& face = stencil.interiorFace(scvfIdx);
+                const auto interior = identifyCell(stencil.element(face.interiorIndex()));
+                const auto exterior = identifyCell(stencil.element(face.exteriorIndex()));
+                if (! this->interRegionFlows_.isInterRegionConnection(interior, exterior)) {
+                    continue;
+                }
+
+                this->fluxFaces_.push_back({ interior, exterior,
+                                             directional ? face.faceDirFromDirId()
+                                                         : FaceDir::DirEnum::Unknown });
+            }
+        }
+
+        this->fluxFaces_.shrink_to_fit();
+        this->fluxFacesValid_ = true;
+    }
+
+    //! \brief Connection which contributes to the inter-region flows.
+    struct FluxFace
+    {
+        EclInterRegFlowMap::Cell interior;
+        EclInterRegFlowMap::Cell exterior;
+        FaceDir::DirEnum faceDir;
+    };
+
     const Simulator& simulator_;
+    std::vector<FluxFace> fluxFaces_;
+    bool fluxFacesValid_ = false;
 };
 
 } // namespace Opm
@@ -43,6 +43,7 @@
 #include <ebos/eclnewtonmethod.hh>
 #include <ebos/ecloutputblackoilmodule.hh>
 #include <ebos/eclproblem_properties.hh>
+#include <ebos/ecltablesegmentcache.hh>
 #include <ebos/eclthresholdpressure.hh>
 #include <ebos/ecltransmissibility.hh>
 #include <ebos/eclwriter.hh>
@@ -87,12 +88,14 @@
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 
 #include <opm/utility/CopyablePtr.hpp>
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <set>
 #include <string>
@@ -399,6 +402,10 @@ public:
                                       }
                                       return coords;
                                   });
+        if (!this->rockCompPoroMult_.empty()) {
+            rockCompPoroMultCache_.resize(this->model().numGridDof());
+            rockCompTransMultCache_.resize(this->model().numGridDof());
+        }
         readMaterialParameters_();
         readThermalParameters_();
 
@@ -453,6 +460,16 @@ public:
 
         simulator.vanguard().releaseGlobalTransmissibilities();
 
+        // The global grid is only needed for the INIT and EGRID output,
+        // unless Damaris is writing the mesh.
+        bool releaseEquilGrid = EWOMS_GET_PARAM(TypeTag, bool, EnableLowMemory);
+#if HAVE_DAMARIS
+        releaseEquilGrid = releaseEquilGrid && !enableDamarisOutput_;
+#endif
+        if (releaseEquilGrid) {
+            simulator.vanguard().releaseEquilGrid();
+        }
+
         // after finishing the initialization and writing the initial solution, we move
         // to the first "real" episode/report step
         // for restart the episode index and start is already set
@@ -515,7 +532,7 @@ public:
      */
     void beginEpisode()
     {
-        OPM_TIMEBLOCK(beginEpisode);
+        OPM_TIMEBLOCK_TREE(beginEpisode);
         // Proceed to the next report step
         auto& simulator = this->simulator();
         int episodeIdx = simulator.episodeIndex();
@@ -586,7 +603,7 @@ public:
      */
     void beginTimeStep()
     {
-        OPM_TIMEBLOCK(beginTimeStep);
+        OPM_TIMEBLOCK_TREE(beginTimeStep);
         int episodeIdx = this->episodeIndex();
 
         this->beginTimeStep_(enableExperiments,
@@ -606,9 +623,14 @@ public:
         }
 
         wellModel_.beginTimeStep();
-        if (enableAquifers_)
+        if (enableAquifers_) {
+            OPM_TIMEBLOCK_TREE(aquiferBeginTimeStep);
             aquiferModel_.beginTimeStep();
-        tracerModel_.beginTimeStep();
+        }
+        {
+            OPM_TIMEBLOCK_TREE(tracerBeginTimeStep);
+            tracerModel_.beginTimeStep();
+        }
 
     }
 
@@ -617,7 +639,7 @@ public:
      */
     void beginIteration()
     {
-        OPM_TIMEBLOCK(beginIteration);
+        OPM_TIMEBLOCK_TREE(beginIteration);
         wellModel_.beginIteration();
         if (enableAquifers_)
             aquiferModel_.beginIteration();
@@ -628,7 +650,7 @@ public:
      */
     void endIteration()
     {
-        OPM_TIMEBLOCK(endIteration);
+        OPM_TIMEBLOCK_TREE(endIteration);
         wellModel_.endIteration();
         if (enableAquifers_)
             aquiferModel_.endIteration();
@@ -639,7 +661,7 @@ public:
      */
     void endTimeStep()
     {
-        OPM_TIMEBLOCK(endTimeStep);
+        OPM_TIMEBLOCK_TREE(endTimeStep);
 #ifndef NDEBUG
         if constexpr (getPropValue<TypeTag, Properties::EnableDebuggingChecks>()) {
             // in debug mode, we don't care about performance, so we check if the model does
@@ -657,14 +679,19 @@ public:
 
         auto& simulator = this->simulator();
         wellModel_.endTimeStep();
-        if (enableAquifers_)
+        if (enableAquifers_) {
+            OPM_TIMEBLOCK_TREE(aquiferEndTimeStep);
             aquiferModel_.endTimeStep();
-        tracerModel_.endTimeStep();
+        }
+        {
+            OPM_TIMEBLOCK_TREE(tracerEndTimeStep);
+            tracerModel_.endTimeStep();
+        }
 
         // deal with DRSDT and DRVDT
         asImp_().updateCompositionChangeLimits_();
         {
-        OPM_TIMEBLOCK(driftCompansation);
+        OPM_TIMEBLOCK_TREE(driftCompansation);
         if (enableDriftCompensation_) {
             const auto& residual = this->model().linearizer().residual();
             for (unsigned globalDofIdx = 0; globalDofIdx < residual.size(); globalDofIdx ++) {
@@ -690,7 +717,7 @@ public:
                 this->transmissibilities_.update(global,gridToEquilGrid);
             };
         {
-        OPM_TIMEBLOCK(applyActions);
+        OPM_TIMEBLOCK_TREE(applyActions);
         actionHandler_.applyActions(episodeIdx,
                                     simulator.time() + simulator.timeStepSize(),
                                     transUp);
@@ -711,7 +738,7 @@ public:
      */
     void endEpisode()
     {
-        OPM_TIMEBLOCK(endEpisode);
+        OPM_TIMEBLOCK_TREE(endEpisode);
         auto& simulator = this->simulator();
         auto& schedule = simulator.vanguard().schedule();
 
@@ -736,7 +763,7 @@ public:
      */
     void writeOutput(bool verbose = true)
     {
-        OPM_TIMEBLOCK(problemWriteOutput);
+        OPM_TIMEBLOCK_TREE(problemWriteOutput);
         // use the generic code to prepare the output fields and to
         // write the desired VTK files.
         if (EWOMS_GET_PARAM(TypeTag, bool, EnableWriteAllSolutions) || this->simulator().episodeWillBeOver()){
@@ -759,7 +786,7 @@ public:
     }
 
     void finalizeOutput() {
-        OPM_TIMEBLOCK(finalizeOutput);
+        OPM_TIMEBLOCK_TREE(finalizeOutput);
         // this will write all pending output to disk
         // to avoid corruption of output files
         eclWriter_.reset();
@@ -1587,7 +1614,7 @@ public:
      */
     Scalar nextTimeStepSize() const
     {
-        OPM_TIMEBLOCK(nexTimeStepSize);
+        OPM_TIMEBLOCK_TREE(nexTimeStepSize);
         // allow external code to do the timestepping
         if (this->nextTimeStepSize_ > 0.0)
             return this->nextTimeStepSize_;
@@ -1635,6 +1662,8 @@ public:
 
 
         if (!this->rockCompPoroMult_.empty()) {
+            if (!rockCompPoroMultCache_.empty())
+                return rockCompPoroMultCache_.eval(this->rockCompPoroMult_[tableIdx], elementIdx, effectiveOilPressure);
             return this->rockCompPoroMult_[tableIdx].eval(effectiveOilPressure, /*extrapolation=*/true);
         }
 
@@ -1674,8 +1703,11 @@ public:
         if (!this->overburdenPressure_.empty())
             effectiveOilPressure -= this->overburdenPressure_[elementIdx];
 
-        if (!this->rockCompTransMult_.empty())
+        if (!this->rockCompTransMult_.empty()) {
+            if (!rockCompTransMultCache_.empty())
+                return rockCompTransMultCache_.eval(this->rockCompTransMult_[tableIdx], elementIdx, effectiveOilPressure);
             return this->rockCompTransMult_[tableIdx].eval(effectiveOilPressure, /*extrapolation=*/true);
+        }
 
         // water compaction
         assert(!this->rockCompTransMultWc_.empty());
@@ -1791,7 +1823,9 @@ private:
 protected:
     void updateExplicitQuantities_()
     {
-        OPM_TIMEBLOCK(updateExplicitQuantities);
+        OPM_TIMEBLOCK_TREE(updateExplicitQuantities);
+        // the update functions flag the cells for which an explicit quantity changed
+        changedCells_.assign(this->model().numGridDof(), 0);
         const bool invalidateFromMaxWaterSat = updateMaxWaterSaturation_();
         const bool invalidateFromMinPressure = updateMinPressure_();
 
@@ -1803,8 +1837,17 @@ protected:
         bool invalidateIntensiveQuantities
             = invalidateFromMaxWaterSat || invalidateFromMinPressure || invalidateFromHyst || invalidateFromMaxOilSat;
         if (invalidateIntensiveQuantities) {
-            OPM_TIMEBLOCK(beginTimeStepInvalidateIntensiveQuantities);
-            this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+            OPM_TIMEBLOCK_TREE(beginTimeStepInvalidateIntensiveQuantities);
+            // only the intensive quantities of the flagged cells need to be
+            // re-evaluated. this is done on all processes, even if no local
+            // cell changed, since the update is collective in case of errors.
+            std::vector<unsigned> cells;
+            for (unsigned cellIdx = 0; cellIdx < changedCells_.size(); ++cellIdx) {
+                if (changedCells_[cellIdx]) {
+                    cells.push_back(cellIdx);
+                }
+            }
+            this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0, cells);
         }
 
         if constexpr (getPropValue<TypeTag, Properties::EnablePolymer>())
@@ -1815,7 +1858,7 @@ protected:
     void updateProperty_(const std::string& failureMsg,
                          UpdateFunc func)
     {
-        OPM_TIMEBLOCK(updateProperty);
+        OPM_TIMEBLOCK_TREE(updateProperty);
         const auto& model = this->simulator().model();
         const auto& primaryVars = model.solution(/*timeIdx*/0);
         const auto& vanguard = this->simulator().vanguard();
@@ -1834,7 +1877,7 @@ protected:
     // update the parameters needed for DRSDT and DRVDT
     void updateCompositionChangeLimits_()
     {
-        OPM_TIMEBLOCK(updateCompositionChangeLimits);
+        OPM_TIMEBLOCK_TREE(updateCompositionChangeLimits);
         // update the "last Rs" values for all elements, including the ones in the ghost
         // and overlap regions
         int episodeIdx = this->episodeIndex();
@@ -1866,7 +1909,7 @@ protected:
 
     bool updateMaxOilSaturation_()
     {
-        OPM_TIMEBLOCK(updateMaxOilSaturation);
+        OPM_TIMEBLOCK_TREE(updateMaxOilSaturation);
         int episodeIdx = this->episodeIndex();
 
         // we use VAPPARS
@@ -1874,7 +1917,8 @@ protected:
             this->updateProperty_("EclProblem::updateMaxOilSaturation_() failed:",
                                   [this](unsigned compressedDofIdx, const IntensiveQuantities& iq)
                                   {
-                                      this->updateMaxOilSaturation_(compressedDofIdx,iq);
+                                      if (this->updateMaxOilSaturation_(compressedDofIdx,iq))
+                                          this->changedCells_[compressedDofIdx] = 1;
                                   });
             return true;
         }
@@ -1898,16 +1942,21 @@ protected:
 
     bool updateMaxWaterSaturation_()
     {
-        OPM_TIMEBLOCK(updateMaxWaterSaturation);
+        OPM_TIMEBLOCK_TREE(updateMaxWaterSaturation);
         // water compaction is activated in ROCKCOMP
         if (this->maxWaterSaturation_.empty())
             return false;
 
-        this->maxWaterSaturation_[/*timeIdx=*/1] = this->maxWaterSaturation_[/*timeIdx=*/0];
+        auto& mow = this->maxWaterSaturation_;
+        if (mow[/*timeIdx=*/1] != mow[/*timeIdx=*/0]) {
+            mow[/*timeIdx=*/1] = mow[/*timeIdx=*/0];
+            changedCells_[1] = 1;
+        }
         this->updateProperty_("EclProblem::updateMaxWaterSaturation_() failed:",
                               [this](unsigned compressedDofIdx, const IntensiveQuantities& iq)
                               {
-                                  this->updateMaxWaterSaturation_(compressedDofIdx,iq);
+                                  if (this->updateMaxWaterSaturation_(compressedDofIdx,iq))
+                                      this->changedCells_[compressedDofIdx] = 1;
                                });
         return true;
     }
@@ -1929,7 +1978,7 @@ protected:
 
     bool updateMinPressure_()
     {
-        OPM_TIMEBLOCK(updateMinPressure);
+        OPM_TIMEBLOCK_TREE(updateMinPressure);
         // IRREVERS option is used in ROCKCOMP
         if (this->minOilPressure_.empty())
             return false;
@@ -1937,7 +1986,8 @@ protected:
         this->updateProperty_("EclProblem::updateMinPressure_() failed:",
                               [this](unsigned compressedDofIdx, const IntensiveQuantities& iq)
                               {
-                                  this->updateMinPressure_(compressedDofIdx,iq);
+                                  if (this->updateMinPressure_(compressedDofIdx,iq))
+                                      this->changedCells_[compressedDofIdx] = 1;
                               });
         return true;
     }
@@ -1957,7 +2007,7 @@ protected:
 
     void readMaterialParameters_()
     {
-        OPM_TIMEBLOCK(readMaterialParameters);
+        OPM_TIMEBLOCK_TREE(readMaterialParameters);
         const auto& simulator = this->simulator();
         const auto& vanguard = simulator.vanguard();
         const auto& eclState = vanguard.eclState();
@@ -2423,7 +2473,8 @@ protected:
         this->updateProperty_("EclProblem::updateHysteresis_() failed:",
                               [this](unsigned compressedDofIdx, const IntensiveQuantities& iq)
                               {
-                                  materialLawManager_->updateHysteresis(iq.fluidState(), compressedDofIdx);
+                                  if (this->updateHysteresis_(compressedDofIdx, iq))
+                                      this->changedCells_[compressedDofIdx] = 1;
                               });
         return true;
     }
@@ -2432,9 +2483,34 @@ protected:
     bool updateHysteresis_(unsigned compressedDofIdx, const IntensiveQuantities& iq)
     {
         OPM_TIMEBLOCK_LOCAL(updateHysteresis_);
-        materialLawManager_->updateHysteresis(iq.fluidState(), compressedDofIdx);
-        //TODO change materials to give a bool
-        return true;
+        const auto& fs = iq.fluidState();
+
+        // directional relative permeabilities may use hysteresis parameters which
+        // are not seen below, so always re-evaluate such cells
+        if (materialLawManager_->hasDirectionalRelperms()
+            || materialLawManager_->hasDirectionalImbnum())
+        {
+            materialLawManager_->updateHysteresis(fs, compressedDofIdx);
+            return true;
+        }
+
+        // the material laws do not report whether the hysteresis state changed.
+        // the intensive quantities only depend on it through the relative
+        // permeabilities and capillary pressures at the current fluid state, so
+        // compare those, including their derivatives, before and after the update
+        const auto& materialParams = materialLawParams(compressedDofIdx);
+        std::array<Evaluation, numPhases> krBefore;
+        std::array<Evaluation, numPhases> pcBefore;
+        MaterialLaw::relativePermeabilities(krBefore, materialParams, fs);
+        MaterialLaw::capillaryPressures(pcBefore, materialParams, fs);
+
+        materialLawManager_->updateHysteresis(fs, compressedDofIdx);
+
+        std::array<Evaluation, numPhases> krAfter;
+        std::array<Evaluation, numPhases> pcAfter;
+        MaterialLaw::relativePermeabilities(krAfter, materialParams, fs);
+        MaterialLaw::capillaryPressures(pcAfter, materialParams, fs);
+        return krBefore != krAfter || pcBefore != pcAfter;
     }
 
     void updateMaxPolymerAdsorption_()
@@ -2650,6 +2726,14 @@ private:
 
     EclActionHandler actionHandler_;
 
+    // flag for each cell, set if an explicit quantity changed in updateExplicitQuantities_()
+    std::vector<char> changedCells_;
+
+    // table segment of the pressure of each cell in the last evaluation of
+    // the ROCKTAB multipliers
+    EclTableSegmentCache<Scalar> rockCompPoroMultCache_;
+    EclTableSegmentCache<Scalar> rockCompTransMultCache_;
+
     template<class T>
     struct BCData
     {
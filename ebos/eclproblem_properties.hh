@@ -417,6 +417,18 @@ struct EnableEsmry<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// Collect cell data on the I/O rank for output by default
+template<class TypeTag>
+struct EnableParallelCellOutput<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
+// Keep the global grid and output arrays by default
+template<class TypeTag>
+struct EnableLowMemory<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
 // By default, use single precision for the ECL formated results
 template<class TypeTag>
 struct EclOutputDoublePrecision<TypeTag, TTag::EclBaseProblem> {
@@ -0,0 +1,126 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \copydoc Opm::EclTableSegmentCache
+ */
+#ifndef ECL_TABLE_SEGMENT_CACHE_HH
+#define ECL_TABLE_SEGMENT_CACHE_HH
+
+#include <opm/material/common/MathToolbox.hpp>
+#include <opm/material/common/Tabulated1DFunction.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Evaluates piecewise linear tables per cell, remembering the table
+//!        segment last used by each cell.
+//!
+//! \details The argument of a table typically stays in the same segment over
+//! the Newton iterations of a time step, in which case the evaluation skips
+//! the interval search of Tabulated1DFunction::eval(). Evaluation always
+//! extrapolates outside of the table range. The segments are stored as
+//! relaxed atomics as the same cell may be evaluated from several threads,
+//! e.g. by the well model. A remembered segment is only a hint which is
+//! checked against the table at hand, so a cell may switch tables.
+//! Only one-dimensional tables are cached; the two-dimensional ROCK2D
+//! tables are evaluated directly.
+template<class Scalar>
+class EclTableSegmentCache {
+public:
+    //! \brief Set the number of cells, forgetting all segments.
+    void resize(std::size_t numCells)
+    {
+        segments_ = std::vector<std::atomic<unsigned>>(numCells);
+    }
+
+    //! \brief Whether the cache has been set up.
+    bool empty() const
+    { return segments_.empty(); }
+
+    //! \brief Evaluate a table for a cell.
+    template<class Evaluation>
+    Evaluation eval(const Tabulated1DFunction<Scalar>& table,
+                    unsigned cellIdx,
+                    const Evaluation& x) const
+    {
+        const std::size_t numSamples = table.numSamples();
+        if (numSamples < 2)
+            return table.eval(x, /*extrapolation=*/true);
+
+        const Scalar xv = getValue(x);
+        std::size_t segIdx = segments_[cellIdx].load(std::memory_order_relaxed);
+        if (segIdx + 1 >= numSamples || !inSegment_(table, segIdx, xv)) {
+            segIdx = findSegment_(table, xv);
+            segments_[cellIdx].store(segIdx, std::memory_order_relaxed);
+        }
+
+        const Scalar x0 = table.xAt(segIdx);
+        const Scalar x1 = table.xAt(segIdx + 1);
+        const Scalar y0 = table.valueAt(segIdx);
+        const Scalar y1 = table.valueAt(segIdx + 1);
+        return y0 + (y1 - y0)*(x - x0)/(x1 - x0);
+    }
+
+private:
+    // The first and last segments also cover the extrapolation ranges.
+    static bool inSegment_(const Tabulated1DFunction<Scalar>& table,
+                           std::size_t segIdx,
+                           Scalar x)
+    {
+        const std::size_t lastSegIdx = table.numSamples() - 2;
+        return (segIdx == 0 || table.xAt(segIdx) <= x) &&
+               (segIdx == lastSegIdx || x <= table.xAt(segIdx + 1));
+    }
+
+    static std::size_t findSegment_(const Tabulated1DFunction<Scalar>& table,
+                                    Scalar x)
+    {
+        const std::size_t numSamples = table.numSamples();
+        if (x <= table.xAt(1))
+            return 0;
+        if (x >= table.xAt(numSamples - 2))
+            return numSamples - 2;
+
+        std::size_t lowerIdx = 1;
+        std::size_t upperIdx = numSamples - 2;
+        while (lowerIdx + 1 < upperIdx) {
+            const std::size_t pivotIdx = (lowerIdx + upperIdx) / 2;
+            if (x < table.xAt(pivotIdx))
+                upperIdx = pivotIdx;
+            else
+                lowerIdx = pivotIdx;
+        }
+        return lowerIdx;
+    }
+
+    mutable std::vector<std::atomic<unsigned>> segments_;
+};
+
+} // namespace Opm
+
+#endif // ECL_TABLE_SEGMENT_CACHE_HH
@@ -38,6 +38,7 @@
 #include <array>
 #include <functional>
 #include <map>
+#include <cstddef>
 #include <cstdint>
 #include <tuple>
 #include <unordered_map>
@@ -113,6 +114,12 @@ public:
      */
     Scalar dispersivity(unsigned elemIdx1, unsigned elemIdx2) const;
 
+    /*!
+     * \brief Return the heap memory held by the transmissibilities and the
+     *        cell properties they are computed from, in bytes.
+     */
+    std::size_t memoryUsage() const;
+
     /*!
      * \brief Actually compute the transmissibility over a face as a pre-compute step.
      *
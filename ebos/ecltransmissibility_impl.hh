@@ -37,6 +37,8 @@
 #include <opm/input/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
 
+#include <opm/simulators/utils/MemoryUsage.hpp>
+
 #include <fmt/format.h>
 
 #include <algorithm>
@@ -160,6 +162,15 @@ dispersivity(unsigned elemIdx1, unsigned elemIdx2) const
 
 }
 
+template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
+std::size_t EclTransmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
+memoryUsage() const
+{
+    return totalHeapBytes(permeability_, porosity_, dispersion_, trans_,
+                          transBoundary_, thermalHalfTransBoundary_,
+                          thermalHalfTrans_, diffusivity_, dispersivity_);
+}
+
 template<class Grid, class GridView, class ElementMapper, class CartesianIndexMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,CartesianIndexMapper,Scalar>::
 update(bool global, const std::function<unsigned int(unsigned int)>& map, const bool applyNncMultregT)
@@ -41,6 +41,11 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/utils/ParallelRestart.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
+
+#if HAVE_HDF5
+#include <opm/simulators/utils/ParallelCellDataWriter.hpp>
+#endif
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
@@ -70,6 +75,14 @@ template<class TypeTag, class MyTypeTag>
 struct EnableEsmry {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EnableParallelCellOutput {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EnableLowMemory {
+    using type = UndefinedProperty;
+};
 } // namespace Opm::Properties
 
 namespace Opm {
@@ -130,7 +143,18 @@ public:
 
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableEsmry,
                              "Write ESMRY file for fast loading of summary data.");
-                                                        
+
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableParallelCellOutput,
+                             "Let each process write the auxiliary cell data, i.e., fields not "
+                             "needed for restarts, to a shared CASENAME.OPMCELL HDF5 file "
+                             "instead of collecting it on the I/O rank. Only these fields bypass "
+                             "the I/O rank: the restart solution, tracers, wells, groups and "
+                             "summary data are still collected and written by the I/O rank.");
+
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableLowMemory,
+                             "Release data only needed before the simulation starts, such as "
+                             "the global grid, and free the cell data collected on the I/O "
+                             "rank after every output.");
     }
 
     // The Simulator object should preferably have been const - the
@@ -157,6 +181,12 @@ public:
             (simulator, this->collectToIORank_);
             
         rank_ = simulator_.vanguard().grid().comm().rank() ;
+
+        if (EWOMS_GET_PARAM(TypeTag, bool, EnableParallelCellOutput) &&
+            this->collectToIORank_.isParallel())
+        {
+            this->setupParallelCellOutput();
+        }
     }
 
     ~EclWriter()
@@ -172,7 +202,7 @@ public:
      */
     void evalSummaryState(bool isSubStep)
     {
-        OPM_TIMEBLOCK(evalSummaryState);
+        OPM_TIMEBLOCK_TREE(evalSummaryState);
         const int reportStepNum = simulator_.episodeIndex() + 1;
         /*
           The summary data is not evaluated for timestep 0, that is
@@ -248,10 +278,10 @@ public:
         std::map<std::string, std::vector<double>> regionData;
         Inplace inplace;
         {
-            OPM_TIMEBLOCK(outputFipLogAndFipresvLog);
+            OPM_TIMEBLOCK_TREE(outputFipLogAndFipresvLog);
             inplace = eclOutputModule_->outputFipLog(miscSummaryData, regionData, reportStepNum,
                                                      isSubStep, simulator_.gridView().comm());
-            eclOutputModule_->outputFipresvLog(miscSummaryData, regionData, reportStepNum,
+            eclOutputModule_->outputFipresvLog(inplace, reportStepNum,
                                                isSubStep, simulator_.gridView().comm());
         }
         bool forceDisableProdOutput = false;
@@ -285,7 +315,7 @@ public:
         }
 
         {
-            OPM_TIMEBLOCK(evalSummary);
+            OPM_TIMEBLOCK_TREE(evalSummary);
 
             const auto& blockData = this->collectToIORank_.isParallel()
                 ? this->collectToIORank_.globalBlockData()
@@ -312,7 +342,7 @@ public:
         }
 
         {
-        OPM_TIMEBLOCK(outputXXX);
+        OPM_TIMEBLOCK_TREE(outputXXX);
         eclOutputModule_->outputProdLog(reportStepNum, isSubStep, forceDisableProdOutput);
         eclOutputModule_->outputInjLog(reportStepNum, isSubStep, forceDisableInjOutput);
         eclOutputModule_->outputCumLog(reportStepNum, isSubStep, forceDisableCumOutput);
@@ -348,17 +378,17 @@ public:
         std::map<std::string, std::vector<double>> regionData;
         Inplace inplace;
         {
-            OPM_TIMEBLOCK(outputFipLogAndFipresvLog);
+            OPM_TIMEBLOCK_TREE(outputFipLogAndFipresvLog);
             inplace = eclOutputModule_->outputFipLog(miscSummaryData, regionData, 0,
                                                      false, simulator_.gridView().comm());
-            eclOutputModule_->outputFipresvLog(miscSummaryData, regionData, 0,
+            eclOutputModule_->outputFipresvLog(inplace, 0,
                                                false, simulator_.gridView().comm());
         }
     }
 
     void writeOutput(data::Solution&& localCellData, bool isSubStep)
     {
-        OPM_TIMEBLOCK(writeOutput);
+        OPM_TIMEBLOCK_TREE(writeOutput);
 
         const int reportStepNum = simulator_.episodeIndex() + 1;
         this->prepareLocalCellData(isSubStep, reportStepNum);
@@ -389,13 +419,16 @@ public:
             this->eclOutputModule_->addRftDataToWells(localWellData, reportStepNum);
         }
 
+        this->writeParallelCellData(localCellData, reportStepNum);
+
         if (this->collectToIORank_.isParallel() ||
             this->collectToIORank_.doesNeedReordering())
         {
             // Note: We don't need WBP (well-block averaged pressures) or
             // inter-region flow rate values in order to create restart file
             // output.  There's consequently no need to collect those
-            // properties on the I/O rank.
+            // properties on the I/O rank.  Restart fields written in
+            // single precision are collected in single precision.
 
             this->collectToIORank_.collect(localCellData,
                                            this->eclOutputModule_->getBlockData(),
@@ -406,7 +439,8 @@ public:
                                            localWellTestState,
                                            /* interRegFlows = */ {},
                                            flowsn,
-                                           floresn);
+                                           floresn,
+                                           !EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision));
         }
 
         if (this->collectToIORank_.isIORank()) {
@@ -427,6 +461,11 @@ public:
                                 EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision),
                                 isFlowsn, std::move(flowsn),
                                 isFloresn, std::move(floresn));
+
+            // The restart values hold a copy of the collected cell data.
+            if (EWOMS_GET_PARAM(TypeTag, bool, EnableLowMemory)) {
+                this->collectToIORank_.releaseGlobalCellData();
+            }
         }
     }
 
@@ -550,7 +589,7 @@ private:
     void prepareLocalCellData(const bool isSubStep,
                               const int  reportStepNum)
     {
-        OPM_TIMEBLOCK(prepareLocalCellData);
+        OPM_TIMEBLOCK_TREE(prepareLocalCellData);
 
         if (this->eclOutputModule_->localDataValid()) {
             return;
@@ -569,7 +608,7 @@ private:
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
         {
-            OPM_TIMEBLOCK(prepareCellBasedData);
+            OPM_TIMEBLOCK_TREE(prepareCellBasedData);
             for (const auto& elem : elements(gridView)) {
                 elemCtx.updatePrimaryStencil(elem);
                 elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
@@ -580,7 +619,7 @@ private:
 
         if constexpr (enableMech) {
             if (simulator_.vanguard().eclState().runspec().mech()) {
-                OPM_TIMEBLOCK(prepareMechData);
+                OPM_TIMEBLOCK_TREE(prepareMechData);
                 for (const auto& elem : elements(gridView)) {
                     elemCtx.updatePrimaryStencil(elem);
                     elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
@@ -590,19 +629,26 @@ private:
         }
 
         if (! this->simulator_.model().linearizer().getFlowsInfo().empty()) {
-            OPM_TIMEBLOCK(prepareFlowsData);
+            OPM_TIMEBLOCK_TREE(prepareFlowsData);
+            // The flows are those of the last linearization, only the
+            // indices of the stencil are needed.
             for (const auto& elem : elements(gridView)) {
                 elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
                 this->eclOutputModule_->processElementFlows(elemCtx);
             }
         }
 
-        {
-            OPM_TIMEBLOCK(prepareBlockData);
+        if (! this->eclOutputModule_->getBlockData().empty()) {
+            OPM_TIMEBLOCK_TREE(prepareBlockData);
+            // Only the cells of the requested block vectors are evaluated.
             for (const auto& elem : elements(gridView)) {
                 elemCtx.updatePrimaryStencil(elem);
+                const auto globalDofIdx = elemCtx.globalSpaceIndex(/*dofIdx=*/0, /*timeIdx=*/0);
+                if (! this->eclOutputModule_->isBlockDataCell(simulator_.vanguard().cartesianIndex(globalDofIdx))) {
+                    continue;
+                }
+
                 elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
                 this->eclOutputModule_->processElementBlockData(elemCtx);
@@ -610,7 +656,7 @@ private:
         }
 
         {
-            OPM_TIMEBLOCK(prepareFluidInPlace);
+            OPM_TIMEBLOCK_TREE(prepareFluidInPlace);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -629,14 +675,73 @@ private:
                                    this->simulator_.vanguard().grid().comm());
     }
 
+    void setupParallelCellOutput()
+    {
+#if HAVE_HDF5
+        const auto& gridView = this->simulator_.vanguard().gridView();
+        const auto elemMapper = ElementMapper { gridView, Dune::mcmgElementLayout() };
+
+        std::vector<int> localCells;
+        std::vector<int> cartesianIndex;
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const auto elemIdx = elemMapper.index(elem);
+            localCells.push_back(elemIdx);
+            cartesianIndex.push_back(this->cartMapper_.cartesianIndex(elemIdx));
+        }
+
+        // A restarted run appends to the file of the base run.
+        this->parallelCellWriter_ = std::make_unique<ParallelCellDataWriter>
+            (this->eclState().getIOConfig().fullBasePath() + ".OPMCELL",
+             this->simulator_.vanguard().grid().comm(),
+             std::move(localCells), std::move(cartesianIndex),
+             this->eclState().getInitConfig().restartRequested());
+#else
+        if (this->collectToIORank_.isIORank()) {
+            OpmLog::error("Parallel cell output requested, but no HDF5 support available. "
+                          "Cell data will be collected on the I/O rank.");
+        }
+#endif
+    }
+
+    //! \brief Write cell data from each rank if parallel cell output is enabled.
+    //! \details The fields needed to restart the run stay in \p localCellData
+    //!          to be collected for the restart file, all other fields are
+    //!          moved out and written by each rank.
+    void writeParallelCellData([[maybe_unused]] data::Solution& localCellData,
+                               [[maybe_unused]] const int reportStepNum)
+    {
+#if HAVE_HDF5
+        if (!this->parallelCellWriter_ || localCellData.empty()) {
+            return;
+        }
+
+        OPM_TIMEBLOCK_TREE(writeParallelCellData);
+
+        data::Solution extraCellData;
+        for (auto it = localCellData.begin(); it != localCellData.end();) {
+            if (it->second.target == data::TargetType::RESTART_SOLUTION ||
+                it->second.target == data::TargetType::RESTART_TRACER_SOLUTION)
+            {
+                ++it;
+                continue;
+            }
+
+            extraCellData.emplace(it->first, std::move(it->second));
+            it = localCellData.erase(it);
+        }
+
+        OPM_BEGIN_PARALLEL_TRY_CATCH();
+        this->parallelCellWriter_->write(reportStepNum, extraCellData);
+        OPM_END_PARALLEL_TRY_CATCH("EclWriter::writeParallelCellData() failed: ",
+                                   this->simulator_.vanguard().grid().comm());
+#endif
+    }
+
     void captureLocalFluxData()
     {
-        OPM_TIMEBLOCK(captureLocalData);
+        OPM_TIMEBLOCK_TREE(captureLocalData);
 
         const auto& gridView = this->simulator_.vanguard().gridView();
-        const auto timeIdx = 0u;
-
-        auto elemCtx = ElementContext { this->simulator_ };
 
         const auto elemMapper = ElementMapper { gridView, Dune::mcmgElementLayout() };
         const auto activeIndex = [&elemMapper](const Element& e)
@@ -653,12 +758,19 @@ private:
 
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-        for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder)) {
-            elemCtx.updateStencil(elem);
-            elemCtx.updateIntensiveQuantities(timeIdx);
-            elemCtx.updateExtensiveQuantities(timeIdx);
+        // Fluxes of the last linearization from the cached intensive
+        // quantities, without recomputing extensive quantities if possible.
+        if (! this->eclOutputModule_->processCachedFluxes(activeIndex, cartesianIndex)) {
+            const auto timeIdx = 0u;
+            auto elemCtx = ElementContext { this->simulator_ };
 
-            this->eclOutputModule_->processFluxes(elemCtx, activeIndex, cartesianIndex);
+            for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder)) {
+                elemCtx.updateStencil(elem);
+                elemCtx.updateIntensiveQuantities(timeIdx);
+                elemCtx.updateExtensiveQuantities(timeIdx);
+
+                this->eclOutputModule_->processFluxes(elemCtx, activeIndex, cartesianIndex);
+            }
         }
 
         OPM_END_PARALLEL_TRY_CATCH("EclWriter::captureLocalFluxData() failed: ",
@@ -671,6 +783,9 @@ private:
     std::unique_ptr<EclOutputBlackOilModule<TypeTag> > eclOutputModule_;
     Scalar restartTimeStepSize_;
     int rank_ ;
+#if HAVE_HDF5
+    std::unique_ptr<ParallelCellDataWriter> parallelCellWriter_;
+#endif
 };
 
 } // namespace Opm
@@ -23,6 +23,7 @@
 
 #include <opm/common/utility/Serializer.hpp>
 
+#include <opm/simulators/utils/DeltaCheckpoint.hpp>
 #include <opm/simulators/utils/HDF5File.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
@@ -100,6 +101,31 @@ public:
         this->unpack(data);
     }
 
+    //! \brief Read and deserialize a checkpoint, resolving delta checkpoints.
+    //! \details If the group holds a delta checkpoint (written by
+    //!          HDF5CheckpointWriter), the base image is read and the delta
+    //!          applied to it before deserializing.
+    //! \tparam T Type of class to read
+    //! \param data Class to read restart data for
+    template<class T>
+    void readCheckpoint(T& data,
+                        const std::string& group,
+                        const std::string& dset)
+    {
+        const auto entries = m_h5file.list(group);
+        if (std::find(entries.begin(), entries.end(), dset) != entries.end()) {
+            this->read(data, group, dset);
+            return;
+        }
+
+        DeltaCheckpoint::Delta delta;
+        this->read(delta, group, dset + "_delta");
+        m_h5file.read("/report_step/" + std::to_string(delta.baseStep),
+                      dset, m_buffer, HDF5File::DataSetMode::PROCESS_SPLIT);
+        DeltaCheckpoint::apply(delta, m_buffer);
+        this->unpack(data);
+    }
+
     //! \brief Returns the last report step stored in file.
     int lastReportStep() const
     {
@@ -127,6 +153,13 @@ public:
         return result;
     }
 
+    //! \brief Removes a group or data set from the file.
+    //! \details Throws exception on failure
+    void remove(const std::string& path)
+    {
+        m_h5file.remove(path);
+    }
+
 private:
     const Serialization::MemPacker m_packer_priv{}; //!< Packer instance
     HDF5File m_h5file; //!< HDF5 backend for the serializer
@@ -0,0 +1,114 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/DeltaCheckpoint.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//! \brief Measures write volume and restore time of delta checkpoints.
+//! \details A synthetic packed state of the given size is modified in a
+//!          randomly placed contiguous region covering the given fraction
+//!          of the state for a number of steps, mimicking a state where
+//!          only part of the fields change between report steps.
+//!          Usage: delta_checkpoint_benchmark [MiB] [changed fraction] [steps] [chunk size]
+int main(int argc, char** argv)
+{
+    const std::size_t size = (argc > 1 ? std::atof(argv[1]) : 256.0) * (1 << 20);
+    const double fraction = argc > 2 ? std::atof(argv[2]) : 0.05;
+    const int steps = argc > 3 ? std::atoi(argv[3]) : 10;
+    const std::size_t chunkSize = argc > 4 ? std::atoi(argv[4]) : 4096;
+
+    std::mt19937 gen(1234);
+    std::vector<char> state(size);
+    for (auto& c : state) {
+        c = static_cast<char>(gen());
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](auto start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    Opm::DeltaCheckpoint dc(chunkSize);
+    auto start = Clock::now();
+    dc.setBase(0, state);
+    const auto base = state;
+    std::cout << "Base image: " << size << " bytes, hashed in "
+              << seconds(start) << " s\n";
+
+    const auto numChanges = static_cast<std::size_t>(fraction * size);
+    std::uniform_int_distribution<std::size_t> pos(0, size - numChanges);
+
+    std::size_t fullBytes = size;
+    std::size_t deltaBytes = size;
+    std::cout << std::setw(6) << "step"
+              << std::setw(16) << "delta bytes"
+              << std::setw(12) << "ratio"
+              << std::setw(14) << "encode [s]"
+              << std::setw(14) << "restore [s]" << '\n';
+    for (int step = 1; step <= steps; ++step) {
+        const auto offset = pos(gen);
+        for (std::size_t i = 0; i < numChanges; ++i) {
+            state[offset + i] ^= 1;
+        }
+
+        // Matching chunks are confirmed against the base image, which is
+        // read from file in the checkpoint writer.
+        start = Clock::now();
+        const auto delta = dc.computeDelta(state,
+                                           [&base](const std::size_t offset,
+                                                   const std::size_t len)
+                                           {
+                                               return std::vector<char>(base.begin() + offset,
+                                                                        base.begin() + offset + len);
+                                           });
+        const auto encode = seconds(start);
+
+        start = Clock::now();
+        auto restored = base;
+        Opm::DeltaCheckpoint::apply(delta, restored);
+        const auto restore = seconds(start);
+
+        if (restored != state) {
+            std::cerr << "Restored state does not match for step " << step << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        fullBytes += size;
+        deltaBytes += delta.data.size();
+        std::cout << std::setw(6) << step
+                  << std::setw(16) << delta.data.size()
+                  << std::setw(12) << std::setprecision(3)
+                  << static_cast<double>(delta.data.size()) / size
+                  << std::setw(14) << encode
+                  << std::setw(14) << restore << '\n';
+    }
+
+    std::cout << "Total written: " << deltaBytes << " bytes with deltas, "
+              << fullBytes << " bytes with full checkpoints ("
+              << static_cast<double>(deltaBytes) / fullBytes << ")\n";
+
+    return EXIT_SUCCESS;
+}
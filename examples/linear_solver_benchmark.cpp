@@ -0,0 +1,278 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/matrixmarket.hh>
+#include <dune/istl/operators.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+struct Options
+{
+    std::string matrixFile;
+    std::string rhsFile;
+    std::string solverFile;
+    int blockSize = 0;
+    int pressureIndex = 0;
+    int repeats = 3;
+    std::vector<int> threads;
+};
+
+//! \brief Block size from the ISTL_STRUCT comment written by Dune::storeMatrixMarket().
+int readBlockSize(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not read matrix file " + filename);
+    }
+    std::string line;
+    while (std::getline(file, line) && !line.empty() && line[0] == '%') {
+        std::istringstream header(line);
+        std::string percent, istlStruct, blocked;
+        int rows = 0;
+        if ((header >> percent >> istlStruct >> blocked >> rows) &&
+            istlStruct == "ISTL_STRUCT" && blocked == "blocked")
+        {
+            return rows;
+        }
+    }
+    return 1;
+}
+
+template <class Matrix>
+void readMatrix(Matrix& matrix, const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not read matrix file " + filename);
+    }
+    // Opm::MatrixBlock only adds member functions to Dune::FieldMatrix.
+    using Block = typename Matrix::block_type;
+    using M = Dune::BCRSMatrix<Dune::FieldMatrix<double, Block::rows, Block::cols>>;
+    Dune::readMatrixMarket(reinterpret_cast<M&>(matrix), file);
+}
+
+//! \brief Peak resident set size of the process in MiB.
+double peakMemory()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+template <int bz>
+void run(const Options& options)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+    using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+
+    if (options.pressureIndex < 0 || options.pressureIndex >= bz) {
+        throw std::runtime_error("Pressure index " + std::to_string(options.pressureIndex) +
+                                 " is not within the block size " + std::to_string(bz));
+    }
+
+    Matrix matrix;
+    readMatrix(matrix, options.matrixFile);
+    Vector rhs;
+    {
+        std::ifstream file(options.rhsFile);
+        if (!file) {
+            throw std::runtime_error("Could not read rhs file " + options.rhsFile);
+        }
+        Dune::readMatrixMarket(rhs, file);
+    }
+
+    const Opm::PropertyTree prm(options.solverFile);
+    const bool transpose = prm.get<std::string>("preconditioner.type", "") == "cprt";
+    const int pressureIndex = options.pressureIndex;
+    auto weights = [&matrix, transpose, pressureIndex]()
+    {
+        return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(matrix, pressureIndex, transpose);
+    };
+
+    std::cout << "Matrix: " << matrix.N() << " rows, " << matrix.nonzeroes()
+              << " nonzero blocks of size " << bz << "x" << bz << ", "
+              << matrix.nonzeroes() * bz * bz * sizeof(double) / (1024.0 * 1024.0) << " MiB\n"
+              << "Peak memory after reading: " << peakMemory() << " MiB\n\n";
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](auto start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    std::cout << std::setw(8) << "threads"
+              << std::setw(8) << "repeat"
+              << std::setw(14) << "create [s]"
+              << std::setw(14) << "update [s]"
+              << std::setw(14) << "apply [s]"
+              << std::setw(8) << "iters"
+              << std::setw(14) << "reduction"
+              << std::setw(10) << "converged" << '\n';
+
+    auto threads = options.threads;
+    if (threads.empty()) {
+#if HAVE_OPENMP
+        threads.push_back(omp_get_max_threads());
+#else
+        threads.push_back(1);
+#endif
+    }
+
+    for (const int numThreads : threads) {
+#if HAVE_OPENMP
+        omp_set_num_threads(numThreads);
+#endif
+        Operator op(matrix);
+        auto start = Clock::now();
+        Dune::FlexibleSolver<Operator> solver(op, prm, weights, pressureIndex);
+        const double create = seconds(start);
+
+        for (int repeat = 0; repeat < options.repeats; ++repeat) {
+            // The simulator updates the preconditioner for every new
+            // linear system, which is what the update time measures.
+            start = Clock::now();
+            solver.preconditioner().update();
+            const double update = seconds(start);
+
+            Vector x(rhs.size());
+            x = 0.0;
+            Vector b = rhs;
+            Dune::InverseOperatorResult res;
+            start = Clock::now();
+            solver.apply(x, b, res);
+            const double apply = seconds(start);
+
+            std::cout << std::setw(8) << numThreads
+                      << std::setw(8) << repeat
+                      << std::setw(14) << (repeat == 0 ? create : 0.0)
+                      << std::setw(14) << update
+                      << std::setw(14) << apply
+                      << std::setw(8) << res.iterations
+                      << std::setw(14) << res.reduction
+                      << std::setw(10) << (res.converged ? "yes" : "no") << '\n';
+        }
+    }
+
+    std::cout << "\nPeak memory: " << peakMemory() << " MiB\n";
+}
+
+std::vector<int> parseThreads(const std::string& list)
+{
+    std::vector<int> threads;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        threads.push_back(std::atoi(item.c_str()));
+    }
+    return threads;
+}
+
+} // anonymous namespace
+
+//! \brief Replays linear systems dumped by the simulator with any FlexibleSolver configuration.
+//! \details Reads a matrix and right hand side written by
+//!          Opm::Helper::writeSystem() (linear solver verbosity > 10), builds
+//!          the solver described by a JSON property tree, as given to
+//!          --linear-solver, and reports the times to create and update the
+//!          preconditioner and to solve, the iterations and the memory use,
+//!          for each of the given numbers of OpenMP threads.
+//!          Usage: linear_solver_benchmark <matrix.mm> <rhs.mm> <solver.json>
+//!                 [--repeats=N] [--threads=1,2,4] [--block-size=N]
+//!                 [--pressure-index=N]
+//!          The pressure index is the position of the pressure in the blocks,
+//!          which is 0 for the black-oil models. Systems dumped with
+//!          --matrix-add-well-contributions=true include the wells.
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&arg](const std::string& option)
+        {
+            return arg.substr(option.size());
+        };
+        if (arg.rfind("--repeats=", 0) == 0) {
+            options.repeats = std::atoi(value("--repeats=").c_str());
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            options.threads = parseThreads(value("--threads="));
+        } else if (arg.rfind("--pressure-index=", 0) == 0) {
+            options.pressureIndex = std::atoi(value("--pressure-index=").c_str());
+        } else if (arg.rfind("--block-size=", 0) == 0) {
+            options.blockSize = std::atoi(value("--block-size=").c_str());
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 3) {
+        std::cerr << "Usage: " << argv[0] << " <matrix.mm> <rhs.mm> <solver.json>"
+                  << " [--repeats=N] [--threads=1,2,4] [--block-size=N] [--pressure-index=N]\n";
+        return EXIT_FAILURE;
+    }
+    options.matrixFile = positional[0];
+    options.rhsFile = positional[1];
+    options.solverFile = positional[2];
+
+    try {
+        const int bz = options.blockSize > 0 ? options.blockSize
+                                             : readBlockSize(options.matrixFile);
+        switch (bz) {
+        case 1: run<1>(options); break;
+        case 2: run<2>(options); break;
+        case 3: run<3>(options); break;
+        case 4: run<4>(options); break;
+        case 5: run<5>(options); break;
+        case 6: run<6>(options); break;
+        default:
+            std::cerr << "Unsupported block size " << bz << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
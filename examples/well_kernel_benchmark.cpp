@@ -0,0 +1,305 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <ebos/ebos.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+
+#include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/simulators/wells/StandardWellEquations.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
+#include <opm/simulators/wells/VFPProperties.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options
+{
+    std::string deckFile;
+    double minTime = 0.2;
+    std::vector<int> perforations{1, 4, 16, 64, 256};
+};
+
+//! \brief Sum of the results of all kernel calls, printed at the end so
+//!        that the compiler cannot drop the calls.
+double checksum = 0.0;
+
+//! \brief Calls kernel until minTime seconds have passed, doubling the
+//!        number of calls per round like Google Benchmark does.
+//! \details The kernel returns a result of its call, which is added to
+//!          the checksum.
+//! \return Number of calls and mean time per call in microseconds.
+template <class Kernel>
+std::pair<std::size_t, double> measure(const Kernel& kernel, const double minTime)
+{
+    using Clock = std::chrono::steady_clock;
+    checksum += kernel(); // warm up caches and lazily allocated storage
+    std::size_t calls = 1;
+    while (true) {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < calls; ++i) {
+            checksum += kernel();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minTime || calls >= (std::size_t(1) << 30)) {
+            return {calls, 1.0e6 * seconds / calls};
+        }
+        calls *= 2;
+    }
+}
+
+void printHeader()
+{
+    std::cout << std::setw(22) << std::left << "kernel"
+              << std::setw(12) << "well" << std::right
+              << std::setw(8) << "perfs"
+              << std::setw(10) << "segments"
+              << std::setw(8) << "phases"
+              << std::setw(12) << "calls"
+              << std::setw(16) << "time/call [us]" << '\n';
+}
+
+void printRow(const std::string& kernel,
+              const std::string& well,
+              const int perfs,
+              const int segments,
+              const int phases,
+              const std::pair<std::size_t, double>& result)
+{
+    std::cout << std::setw(22) << std::left << kernel
+              << std::setw(12) << well << std::right
+              << std::setw(8) << perfs
+              << std::setw(10) << segments
+              << std::setw(8) << phases
+              << std::setw(12) << result.first
+              << std::setw(16) << std::setprecision(4) << result.second << '\n';
+}
+
+//! \brief Times StandardWellEquations::apply() for synthetic wells.
+//! \details The equations only hold the sparsity pattern, the operator
+//!          is applied with zero off-diagonal blocks and an identity
+//!          inverse of the well block, which costs the same as a real one.
+template <int numEq>
+void runEquations(const Options& options)
+{
+    using Equations = Opm::StandardWellEquations<double, numEq>;
+    const int numCells = 100000;
+    const Opm::ParallelWellInfo pinfo{"SYNTHETIC"};
+
+    for (const int numPerfs : options.perforations) {
+        std::vector<int> cells(numPerfs);
+        for (int perf = 0; perf < numPerfs; ++perf) {
+            cells[perf] = perf * (numCells / numPerfs);
+        }
+        Equations eqs(pinfo);
+        eqs.init(numCells, numEq + 1, numPerfs, cells);
+        eqs.clear();
+        eqs.invert();
+
+        typename Equations::BVector x(numCells);
+        typename Equations::BVector Ax(numCells);
+        x = 1.0;
+        Ax = 0.0;
+        printRow("equations_apply", "-", numPerfs, 0, numEq,
+                 measure([&]() { eqs.apply(x, Ax); return Ax[cells[0]][0]; },
+                         options.minTime));
+    }
+}
+
+//! \brief Times the well kernels of every well open at the start of the deck.
+void runDeck(const Options& options, int argc, char** argv)
+{
+    using TypeTag = Opm::Properties::TTag::EbosTypeTag;
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+    using WellModel = Opm::BlackoilWellModel<TypeTag>;
+    using BVector = typename Opm::WellInterface<TypeTag>::BVector;
+
+    const std::string deckArg = "--ecl-deck-file-name=" + options.deckFile;
+    const char* simArgv[] = { argc > 0 ? argv[0] : "well_kernel_benchmark", deckArg.c_str() };
+    Opm::EclGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    Opm::registerEclTimeSteppingParameters<TypeTag>();
+    Opm::setupParameters_<TypeTag>(sizeof(simArgv) / sizeof(simArgv[0]), simArgv, /*registerParams=*/true);
+    Opm::EclGenericVanguard::readDeck(options.deckFile);
+    auto simulator = std::make_unique<Simulator>();
+
+    simulator->model().applyInitialSolution();
+    simulator->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(86400.0);
+    simulator->model().newtonMethod().setIterationIndex(0);
+
+    WellModel& wellModel = simulator->problem().wellModel();
+    Opm::DeferredLogger logger;
+    wellModel.beginReportStep(0);
+    wellModel.beginTimeStep();
+    wellModel.calculateExplicitQuantities(logger);
+    wellModel.prepareTimeStep(logger);
+    wellModel.updateWellControls(false, logger);
+    wellModel.initPrimaryVariablesEvaluation();
+
+    auto& wellState = wellModel.wellState();
+    const auto& groupState = wellModel.groupState();
+    const auto& summaryState = simulator->vanguard().summaryState();
+    const auto& pu = wellModel.phaseUsage();
+    const double dt = simulator->timeStepSize();
+
+    BVector x(simulator->model().numGridDof());
+    BVector Ax(x.size());
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto& block : x) {
+        for (auto& v : block) {
+            v = dist(gen);
+        }
+    }
+    Ax = 0.0;
+
+    // The kernels log to a logger cleared on every call, so that the
+    // messages do not pile up over the repeated calls.
+    for (const auto& well : wellModel.localNonshutWells()) {
+        const auto& wellEcl = well->wellEcl();
+        const int perfs = well->numPerfs();
+        const int segments = wellEcl.isMultiSegment() ? wellEcl.getSegments().size() : 0;
+        const int phases = pu.num_phases;
+        const std::string prefix = wellEcl.isMultiSegment() ? "msw_" : "std_";
+
+        printRow(prefix + "assemble", well->name(), perfs, segments, phases,
+                 measure([&]() { well->assembleWellEqWithoutIteration(*simulator, dt, wellState,
+                                                                      groupState, logger);
+                                 logger.clearMessages();
+                                 return 0.0; },
+                         options.minTime));
+
+        const int cell = well->cells().front();
+        printRow(prefix + "apply", well->name(), perfs, segments, phases,
+                 measure([&]() { well->apply(x, Ax); return Ax[cell][0]; }, options.minTime));
+
+        const int tableId = wellEcl.vfp_table_number();
+        const bool vfpActive = well->isVFPActive(logger);
+        logger.clearMessages();
+        if (!well->isProducer() || tableId <= 0 || !vfpActive) {
+            continue;
+        }
+
+        const auto* vfp = well->vfpProperties()->getProd();
+        const auto& thpAxis = vfp->getTable(tableId).getTHPAxis();
+        const double thp = thpAxis[thpAxis.size() / 2];
+        const double alq = well->getALQ(wellState);
+        const auto& rates = wellState.well(well->name()).surface_rates;
+        auto rate = [&pu, &rates](const int phase)
+        {
+            return pu.phase_used[phase] ? rates[pu.phase_pos[phase]] : 0.0;
+        };
+        const double aqua = rate(Opm::BlackoilPhases::Aqua);
+        const double liquid = rate(Opm::BlackoilPhases::Liquid);
+        const double vapour = rate(Opm::BlackoilPhases::Vapour);
+
+        printRow("vfp_bhp", well->name(), perfs, segments, phases,
+                 measure([&]() { return vfp->bhp(tableId, aqua, liquid, vapour, thp, alq,
+                                                 0.0, 0.0, false); },
+                         options.minTime));
+
+        printRow("bhp_at_thp_limit_prod", well->name(), perfs, segments, phases,
+                 measure([&]() { const auto bhp = well->computeBhpAtThpLimitProdWithAlq(*simulator,
+                                                                                        summaryState,
+                                                                                        alq, logger);
+                                 logger.clearMessages();
+                                 return bhp.value_or(0.0); },
+                         options.minTime));
+    }
+}
+
+std::vector<int> parseList(const std::string& list)
+{
+    std::vector<int> values;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+} // anonymous namespace
+
+//! \brief Times the hot well kernels in isolation.
+//! \details Sets up the simulator for a deck, such as tests/TESTWELLMODEL.DATA,
+//!          tests/msw.data or tests/GLIFT1.DATA, and times for every open
+//!          well the assembly of the well equations, the application of
+//!          the well operator to a reservoir vector and, for producers with
+//!          a VFP table, VFP bhp() and the bhp at the THP limit. Without a
+//!          deck, or in addition to it, StandardWellEquations::apply() is
+//!          timed for synthetic wells with the given numbers of perforations
+//!          and two and three phases. Every kernel is called repeatedly for
+//!          at least the given time, and the mean time per call is reported.
+//!          Usage: well_kernel_benchmark [deck] [--min-time=S]
+//!                 [--perforations=1,4,16]
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--min-time=", 0) == 0) {
+            options.minTime = std::atof(arg.substr(11).c_str());
+        } else if (arg.rfind("--perforations=", 0) == 0) {
+            options.perforations = parseList(arg.substr(15));
+        } else if (arg.rfind("--", 0) == 0 || !options.deckFile.empty()) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [deck] [--min-time=S] [--perforations=1,4,16]\n";
+            return EXIT_FAILURE;
+        } else {
+            options.deckFile = arg;
+        }
+    }
+
+    try {
+        printHeader();
+        runEquations<2>(options);
+        runEquations<3>(options);
+        if (!options.deckFile.empty()) {
+            runDeck(options, argc, argv);
+        }
+        std::cout << "\nChecksum of kernel results: " << checksum << '\n';
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
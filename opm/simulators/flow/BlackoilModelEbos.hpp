@@ -49,7 +49,10 @@
 #include <opm/simulators/timestepping/SimulatorTimer.hpp>
 #include <opm/simulators/utils/ComponentName.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/DeterministicReduction.hpp>
+#include <opm/simulators/utils/FusedReduction.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 #include <opm/simulators/wells/BlackoilWellModel.hpp>
 
 #include <dune/common/timer.hh>
@@ -240,6 +243,7 @@ namespace Opm {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
             convergence_reports_.reserve(300); // Often insufficient, but avoids frequent moves.
+            initInteriorCells();
             // TODO: remember to fix!
             if (param_.nonlinear_solver_ == "nldd") {
                 if (terminal_output) {
@@ -365,6 +369,7 @@ namespace Opm {
                                                  const SimulatorTimerInterface& timer,
                                                  NonlinearSolverType& nonlinear_solver)
         {
+            OPM_TIMEBLOCK_TREE(nonlinearIteration);
             if (iteration == 0) {
                 // For each iteration we store in a vector the norms of the residual of
                 // the mass balance for each active phase, the well flux and the well equations.
@@ -487,6 +492,7 @@ namespace Opm {
         SimulatorReportSingle assembleReservoir(const SimulatorTimerInterface& /* timer */,
                                                 const int iterationIdx)
         {
+            OPM_TIMEBLOCK_TREE(assembleReservoir);
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
@@ -498,13 +504,16 @@ namespace Opm {
         // compute the "relative" change of the solution between time steps
         double relativeChange() const
         {
-            Scalar resultDelta = 0.0;
-            Scalar resultDenom = 0.0;
+            struct Change
+            {
+                Scalar delta = 0.0;
+                Scalar denom = 0.0;
+            };
 
-            const auto& elemMapper = ebosSimulator_.model().elementMapper();
-            const auto& gridView = ebosSimulator_.gridView();
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                unsigned globalElemIdx = elemMapper.index(elem);
+            const auto change = deterministicReduce(interiorCells_.size(), Change{},
+                [this](const std::size_t i, Change& result)
+            {
+                const unsigned globalElemIdx = interiorCells_[i];
                 const auto& priVarsNew = ebosSimulator_.model().solution(/*timeIdx=*/0)[globalElemIdx];
 
                 Scalar pressureNew;
@@ -541,8 +550,8 @@ namespace Opm {
 
                 // NB fix me! adding pressures changes to satutation changes does not make sense
                 Scalar tmp = pressureNew - pressureOld;
-                resultDelta += tmp*tmp;
-                resultDenom += pressureNew*pressureNew;
+                result.delta += tmp*tmp;
+                result.denom += pressureNew*pressureNew;
 
                 if (FluidSystem::numActivePhases() > 1) {
                     if (priVarsOld.primaryVarsMeaningWater() == PrimaryVariables::WaterMeaning::Sw) {
@@ -562,16 +571,22 @@ namespace Opm {
                     }
                     for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++ phaseIdx) {
                         Scalar tmpSat = saturationsNew[phaseIdx] - saturationsOld[phaseIdx];
-                        resultDelta += tmpSat*tmpSat;
-                        resultDenom += saturationsNew[phaseIdx]*saturationsNew[phaseIdx];
-                        assert(std::isfinite(resultDelta));
-                        assert(std::isfinite(resultDenom));
+                        result.delta += tmpSat*tmpSat;
+                        result.denom += saturationsNew[phaseIdx]*saturationsNew[phaseIdx];
+                        assert(std::isfinite(result.delta));
+                        assert(std::isfinite(result.denom));
                     }
                 }
-            }
+            },
+                [](Change& result, const Change& part)
+            {
+                result.delta += part.delta;
+                result.denom += part.denom;
+            });
 
-            resultDelta = gridView.comm().sum(resultDelta);
-            resultDenom = gridView.comm().sum(resultDenom);
+            const auto& comm = ebosSimulator_.gridView().comm();
+            const Scalar resultDelta = comm.sum(change.delta);
+            const Scalar resultDenom = comm.sum(change.denom);
 
             if (resultDenom > 0.0)
                 return resultDelta/resultDenom;
@@ -597,6 +612,7 @@ namespace Opm {
         /// r is the residual.
         void solveJacobianSystem(BVector& x)
         {
+            OPM_TIMEBLOCK_TREE(linearSolve);
 
             auto& ebosJac = ebosSimulator_.model().linearizer().jacobian().istlMatrix();
             auto& ebosResid = ebosSimulator_.model().linearizer().residual();
@@ -661,7 +677,7 @@ namespace Opm {
         /// Apply an update to the primary variables.
         void updateSolution(const BVector& dx)
         {
-            OPM_TIMEBLOCK(updateSolution);
+            OPM_TIMEBLOCK_TREE(updateSolution);
             auto& ebosNewtonMethod = ebosSimulator_.model().newtonMethod();
             SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
 
@@ -674,7 +690,7 @@ namespace Opm {
 
             // if the solution is updated, the intensive quantities need to be recalculated
             {
-                OPM_TIMEBLOCK(invalidateAndUpdateIntensiveQuantities);
+                OPM_TIMEBLOCK_TREE(invalidateAndUpdateIntensiveQuantities);
                 ebosSimulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
                 ebosSimulator_.problem().eclWriter()->mutableEclOutputModule().invalidateLocalData();
             }
@@ -693,53 +709,43 @@ namespace Opm {
                                                        std::vector< Scalar >& maxCoeff,
                                                        std::vector< Scalar >& B_avg)
         {
-            OPM_TIMEBLOCK(convergenceReduction);
+            OPM_TIMEBLOCK_TREE(convergenceReduction);
             // Compute total pore volume (use only owned entries)
             double pvSum = pvSumLocal;
             double numAquiferPvSum = numAquiferPvSumLocal;
 
             if( comm.size() > 1 )
             {
-                // global reduction
-                std::vector< Scalar > sumBuffer;
-                std::vector< Scalar > maxBuffer;
+                // global sums and maxima in a single collective
+                FusedReduction reduction(comm);
                 const int numComp = B_avg.size();
-                sumBuffer.reserve( 2*numComp + 2 ); // +2 for (numAquifer)pvSum
-                maxBuffer.reserve( numComp );
                 for( int compIdx = 0; compIdx < numComp; ++compIdx )
                 {
-                    sumBuffer.push_back( B_avg[ compIdx ] );
-                    sumBuffer.push_back( R_sum[ compIdx ] );
-                    maxBuffer.push_back( maxCoeff[ compIdx ] );
+                    reduction.addSum( B_avg[ compIdx ] );
+                    reduction.addSum( R_sum[ compIdx ] );
+                    reduction.addMax( maxCoeff[ compIdx ] );
                 }
 
                 // Compute total pore volume
-                sumBuffer.push_back( pvSum );
-                sumBuffer.push_back( numAquiferPvSum );
-
-                // compute global sum
-                comm.sum( sumBuffer.data(), sumBuffer.size() );
+                const auto pvIdx = reduction.addSum( pvSum );
+                const auto numAquiferPvIdx = reduction.addSum( numAquiferPvSum );
 
-                // compute global max
-                comm.max( maxBuffer.data(), maxBuffer.size() );
+                // The convergence decision determines whether the linear
+                // solve runs, so there is no independent work to overlap.
+                reduction.start();
+                reduction.finish();
 
                 // restore values to local variables
-                for( int compIdx = 0, buffIdx = 0; compIdx < numComp; ++compIdx, ++buffIdx )
-                {
-                    B_avg[ compIdx ]    = sumBuffer[ buffIdx ];
-                    ++buffIdx;
-
-                    R_sum[ compIdx ]       = sumBuffer[ buffIdx ];
-                }
-
                 for( int compIdx = 0; compIdx < numComp; ++compIdx )
                 {
-                    maxCoeff[ compIdx ] = maxBuffer[ compIdx ];
+                    B_avg[ compIdx ]    = reduction.sum( 2*compIdx );
+                    R_sum[ compIdx ]    = reduction.sum( 2*compIdx + 1 );
+                    maxCoeff[ compIdx ] = reduction.max( compIdx );
                 }
 
                 // restore global pore volume
-                pvSum = sumBuffer[sumBuffer.size()-2];
-                numAquiferPvSum = sumBuffer.back();
+                pvSum = reduction.sum( pvIdx );
+                numAquiferPvSum = reduction.sum( numAquiferPvIdx );
             }
 
             // return global pore volume
@@ -754,41 +760,68 @@ namespace Opm {
                                                       std::vector<Scalar>& B_avg,
                                                       std::vector<int>& maxCoeffCell)
         {
-            OPM_TIMEBLOCK(localConvergenceData);
-            double pvSumLocal = 0.0;
-            double numAquiferPvSumLocal = 0.0;
+            OPM_TIMEBLOCK_TREE(localConvergenceData);
+            struct LocalData
+            {
+                double pvSum = 0.0;
+                double numAquiferPvSum = 0.0;
+                std::vector<Scalar> R_sum;
+                std::vector<Scalar> maxCoeff;
+                std::vector<Scalar> B_avg;
+                std::vector<int> maxCoeffCell;
+            };
+
             const auto& ebosModel = ebosSimulator_.model();
             const auto& ebosProblem = ebosSimulator_.problem();
 
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
 
-            ElementContext elemCtx(ebosSimulator_);
-            const auto& gridView = ebosSimulator().gridView();
-            IsNumericalAquiferCell isNumericalAquiferCell(gridView.grid());
+            // Single pass over the intensive quantities cached by the
+            // assembly, with partial results per chunk of cells.
+            LocalData result{0.0, 0.0, R_sum, maxCoeff, B_avg, maxCoeffCell};
             OPM_BEGIN_PARALLEL_TRY_CATCH();
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+            result = deterministicReduce(interiorCells_.size(), result,
+                [&](const std::size_t i, LocalData& part)
+            {
+                const unsigned cell_idx = interiorCells_[i];
+                const auto& intQuants = ebosModel.intensiveQuantities(cell_idx, /*timeIdx=*/0);
                 const auto& fs = intQuants.fluidState();
 
                 const auto pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) *
                                      ebosModel.dofTotalVolume(cell_idx);
-                pvSumLocal += pvValue;
+                part.pvSum += pvValue;
 
-                if (isNumericalAquiferCell(elem))
+                if (isNumAquiferCell_[i])
                 {
-                    numAquiferPvSumLocal += pvValue;
+                    part.numAquiferPvSum += pvValue;
                 }
 
                 this->getMaxCoeff(cell_idx, intQuants, fs, ebosResid, pvValue,
-                                  B_avg, R_sum, maxCoeff, maxCoeffCell);
-            }
-
+                                  part.B_avg, part.R_sum, part.maxCoeff, part.maxCoeffCell);
+            },
+                [](LocalData& res, const LocalData& part)
+            {
+                res.pvSum += part.pvSum;
+                res.numAquiferPvSum += part.numAquiferPvSum;
+                for (std::size_t compIdx = 0; compIdx < res.B_avg.size(); ++compIdx) {
+                    res.B_avg[compIdx] += part.B_avg[compIdx];
+                    res.R_sum[compIdx] += part.R_sum[compIdx];
+                    // Strict comparison keeps the first cell attaining the maximum.
+                    if (part.maxCoeff[compIdx] > res.maxCoeff[compIdx]) {
+                        res.maxCoeff[compIdx] = part.maxCoeff[compIdx];
+                        res.maxCoeffCell[compIdx] = part.maxCoeffCell[compIdx];
+                    }
+                }
+            });
             OPM_END_PARALLEL_TRY_CATCH("BlackoilModelEbos::localConvergenceData() failed: ", grid_.comm());
 
+            R_sum = std::move(result.R_sum);
+            maxCoeff = std::move(result.maxCoeff);
+            B_avg = std::move(result.B_avg);
+            maxCoeffCell = std::move(result.maxCoeffCell);
+            const double pvSumLocal = result.pvSum;
+            const double numAquiferPvSumLocal = result.numAquiferPvSum;
+
             // compute local average in terms of global number of elements
             const int bSize = B_avg.size();
             for ( int i = 0; i<bSize; ++i )
@@ -804,26 +837,22 @@ namespace Opm {
         ///        of a numerical aquifer.
         double computeCnvErrorPv(const std::vector<Scalar>& B_avg, double dt)
         {
-            OPM_TIMEBLOCK(computeCnvErrorPv);
-            double errorPV{};
+            OPM_TIMEBLOCK_TREE(computeCnvErrorPv);
             const auto& ebosModel = ebosSimulator_.model();
             const auto& ebosProblem = ebosSimulator_.problem();
             const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
-            const auto& gridView = ebosSimulator().gridView();
-            ElementContext elemCtx(ebosSimulator_);
-            IsNumericalAquiferCell isNumericalAquiferCell(gridView.grid());
 
+            double errorPV{};
             OPM_BEGIN_PARALLEL_TRY_CATCH();
-            for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder))
+            errorPV = deterministicReduce(interiorCells_.size(), 0.0,
+                [&](const std::size_t i, double& part)
             {
                 // Skip cells of numerical Aquifer
-                if (isNumericalAquiferCell(elem))
+                if (isNumAquiferCell_[i])
                 {
-                    continue;
+                    return;
                 }
-                elemCtx.updatePrimaryStencil(elem);
-                // elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                const unsigned cell_idx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                const unsigned cell_idx = interiorCells_[i];
                 const double pvValue = ebosProblem.referencePorosity(cell_idx, /*timeIdx=*/0) * ebosModel.dofTotalVolume( cell_idx );
                 const auto& cellResidual = ebosResid[cell_idx];
                 bool cnvViolated = false;
@@ -837,9 +866,10 @@ namespace Opm {
 
                 if (cnvViolated)
                 {
-                    errorPV += pvValue;
+                    part += pvValue;
                 }
-            }
+            },
+                [](double& result, const double part) { result += part; });
 
             OPM_END_PARALLEL_TRY_CATCH("BlackoilModelEbos::ComputeCnvError() failed: ", grid_.comm());
 
@@ -861,7 +891,7 @@ namespace Opm {
                                                   std::vector<Scalar>& B_avg,
                                                   std::vector<Scalar>& residual_norms)
         {
-            OPM_TIMEBLOCK(getReservoirConvergence);
+            OPM_TIMEBLOCK_TREE(getReservoirConvergence);
             using Vector = std::vector<Scalar>;
 
             const int numComp = numEq;
@@ -899,6 +929,7 @@ namespace Opm {
             // Create convergence report.
             ConvergenceReport report{reportTime};
             using CR = ConvergenceReport;
+            convergence_measure_ = 0.0;
             for (int compIdx = 0; compIdx < numComp; ++compIdx) {
                 double res[2] = { mass_balance_residual[compIdx], CNV[compIdx] };
                 CR::ReservoirFailure::Type types[2] = { CR::ReservoirFailure::Type::MassBalance,
@@ -924,6 +955,9 @@ namespace Opm {
                         report.setReservoirFailed({types[ii], CR::Severity::Normal, compIdx});
                     }
                     report.setReservoirConvergenceMetric(types[ii], compIdx, res[ii]);
+                    if (!std::isnan(res[ii])) {
+                        convergence_measure_ = std::max(convergence_measure_, std::abs(res[ii]) / tol[ii]);
+                    }
                 }
             }
 
@@ -972,14 +1006,19 @@ namespace Opm {
                                          const int iteration,
                                          std::vector<double>& residual_norms)
         {
-            OPM_TIMEBLOCK(getConvergence);
+            OPM_TIMEBLOCK_TREE(getConvergence);
             // Get convergence reports for reservoir and wells.
+            //
+            // This takes two fixed size collectives per iteration, one for
+            // the reservoir sums and maxima and one for the well report
+            // flags. They cannot be merged, since the well residuals are
+            // scaled by the global B_avg computed by the first one.
             std::vector<Scalar> B_avg(numEq, 0.0);
             auto report = getReservoirConvergence(timer.simulationTimeElapsed(),
                                                   timer.currentStepLength(),
                                                   iteration, B_avg, residual_norms);
             {
-                OPM_TIMEBLOCK(getWellConvergence);
+                OPM_TIMEBLOCK_TREE(getWellConvergence);
                 report += wellModel().getWellConvergence(B_avg, /*checkWellGroupControls*/report.converged());
             }
             return report;
@@ -1004,7 +1043,7 @@ namespace Opm {
         std::vector<std::vector<double> >
         computeFluidInPlace(const std::vector<int>& /*fipnum*/) const
         {
-            OPM_TIMEBLOCK(computeFluidInPlace);
+            OPM_TIMEBLOCK_TREE(computeFluidInPlace);
             //assert(true)
             //return an empty vector
             std::vector<std::vector<double> > regionValues(0, std::vector<double>(0,0.0));
@@ -1033,6 +1072,13 @@ namespace Opm {
             return convergence_reports_;
         }
 
+        /// Largest reservoir residual relative to its tolerance in the last
+        /// convergence check, at most one if the reservoir has converged.
+        double convergenceMeasure() const
+        {
+            return convergence_measure_;
+        }
+
         void writePartitions(const std::filesystem::path& odir) const
         {
             if (this->nlddSolver_ != nullptr) {
@@ -1083,6 +1129,7 @@ namespace Opm {
         long int global_nc_;
 
         std::vector<std::vector<double>> residual_norms_history_;
+        double convergence_measure_ = 0.0;
         double current_relaxation_;
         BVector dx_old_;
 
@@ -1091,6 +1138,24 @@ namespace Opm {
 
         std::unique_ptr<BlackoilModelEbosNldd<TypeTag>> nlddSolver_; //!< Non-linear DD solver
 
+        std::vector<unsigned> interiorCells_; //!< Interior cells of this process
+        std::vector<char> isNumAquiferCell_; //!< Whether interior cell is in a numerical aquifer
+
+        //! \brief Collect the interior cells visited by the convergence computations.
+        void initInteriorCells()
+        {
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            IsNumericalAquiferCell isNumericalAquiferCell(gridView.grid());
+
+            interiorCells_.clear();
+            isNumAquiferCell_.clear();
+            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+                interiorCells_.push_back(elemMapper.index(elem));
+                isNumAquiferCell_.push_back(isNumericalAquiferCell(elem));
+            }
+        }
+
     public:
         /// return the StandardWells object
         BlackoilWellModel<TypeTag>&
@@ -1107,6 +1172,9 @@ namespace Opm {
         void endReportStep()
         {
             ebosSimulator_.problem().endEpisode();
+            if (nlddSolver_) {
+                nlddSolver_->endReportStep();
+            }
         }
 
         template<class FluidState, class Residual>
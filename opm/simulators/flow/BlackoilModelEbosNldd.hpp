@@ -36,6 +36,7 @@
 #include <opm/simulators/flow/SubDomain.hpp>
 
 #include <opm/simulators/linalg/extractMatrix.hpp>
+#include <opm/simulators/linalg/ReusableUMFPack.hpp>
 
 #if COMPILE_BDA_BRIDGE
 #include <opm/simulators/linalg/ISTLSolverEbosBda.hpp>
@@ -48,6 +49,7 @@
 #include <opm/simulators/timestepping/SimulatorTimerInterface.hpp>
 
 #include <opm/simulators/utils/ComponentName.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 
 #include <fmt/format.h>
 
@@ -64,6 +66,7 @@
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -100,79 +103,7 @@ public:
     {
         // Create partitions.
         const auto& [partition_vector, num_domains] = this->partitionCells();
-
-        // Scan through partitioning to get correct size for each.
-        std::vector<int> sizes(num_domains, 0);
-        for (const auto& p : partition_vector) {
-            ++sizes[p];
-        }
-
-        // Set up correctly sized vectors of entity seeds and of indices for each partition.
-        using EntitySeed = typename Grid::template Codim<0>::EntitySeed;
-        std::vector<std::vector<EntitySeed>> seeds(num_domains);
-        std::vector<std::vector<int>> partitions(num_domains);
-        for (int domain = 0; domain < num_domains; ++domain) {
-            seeds[domain].resize(sizes[domain]);
-            partitions[domain].resize(sizes[domain]);
-        }
-
-        // Iterate through grid once, setting the seeds of all partitions.
-        // Note: owned cells only!
-        const auto& grid = model_.ebosSimulator().vanguard().grid();
-
-        std::vector<int> count(num_domains, 0);
-        const auto& gridView = grid.leafGridView();
-        const auto beg = gridView.template begin<0, Dune::Interior_Partition>();
-        const auto end = gridView.template end<0, Dune::Interior_Partition>();
-        int cell = 0;
-        for (auto it = beg; it != end; ++it, ++cell) {
-            const int p = partition_vector[cell];
-            seeds[p][count[p]] = it->seed();
-            partitions[p][count[p]] = cell;
-            ++count[p];
-        }
-        assert(count == sizes);
-
-        // Create the domains.
-        for (int index = 0; index < num_domains; ++index) {
-            std::vector<bool> interior(partition_vector.size(), false);
-            for (int ix : partitions[index]) {
-                interior[ix] = true;
-            }
-
-            Dune::SubGridPart<Grid> view{grid, std::move(seeds[index])};
-
-            this->domains_.emplace_back(index,
-                                        std::move(partitions[index]),
-                                        std::move(interior),
-                                        std::move(view));
-        }
-
-        // Set up container for the local system matrices.
-        domain_matrices_.resize(num_domains);
-
-        // Set up container for the local linear solvers.
-        for (int index = 0; index < num_domains; ++index) {
-            // TODO: The ISTLSolverEbos constructor will make
-            // parallel structures appropriate for the full grid
-            // only. This must be addressed before going parallel.
-            const auto& eclState = model_.ebosSimulator().vanguard().eclState();
-            FlowLinearSolverParameters loc_param;
-            loc_param.template init<TypeTag>(eclState.getSimulationConfig().useCPR());
-            // Override solver type with umfpack if small domain.
-            // Otherwise hardcode to ILU0
-            if (domains_[index].cells.size() < 200) {
-                loc_param.linsolver_ = "umfpack";
-            } else {
-                loc_param.linsolver_ = "ilu0";
-                loc_param.linear_solver_reduction_ = 1e-2;
-            }
-            loc_param.linear_solver_print_json_definition_ = false;
-            const bool force_serial = true;
-            domain_linsolvers_.emplace_back(model_.ebosSimulator(), loc_param, force_serial);
-        }
-
-        assert(int(domains_.size()) == num_domains);
+        this->createDomains(partition_vector, num_domains);
     }
 
     //! \brief Called before starting a time step.
@@ -182,6 +113,20 @@ public:
         model_.wellModel().setupDomains(domains_);
     }
 
+    //! \brief Called at the end of a report step.
+    //! \details Repartitions the domains if the cost of the local solves
+    //!          in the report step was too unevenly distributed.
+    void endReportStep()
+    {
+        const auto& param = model_.param();
+        if (param.local_domain_repartition_threshold_ > 0.0 &&
+            param.local_domain_partition_method_ == "zoltan")
+        {
+            this->repartitionIfImbalanced(param.local_domain_repartition_threshold_);
+        }
+        std::fill(domain_iterations_.begin(), domain_iterations_.end(), 0.0);
+    }
+
     //! \brief Do one non-linear NLDD iteration.
     template <class NonlinearSolverType>
     SimulatorReportSingle nonlinearIterationNldd(const int iteration,
@@ -231,6 +176,7 @@ public:
                 OpmLog::debug("Convergence failure in domain " + std::to_string(domain.index));
             }
             domain_reports[domain.index] = local_report;
+            domain_iterations_[domain.index] += local_report.total_newton_iterations;
         }
 
         // Log summary of local solve convergence to DBG file.
@@ -327,6 +273,125 @@ public:
     }
 
 private:
+    //! \brief Set up the subdomains, their matrices and linear solvers.
+    void createDomains(const std::vector<int>& partition_vector, const int num_domains)
+    {
+        domains_.clear();
+        domain_matrices_.clear();
+        domain_matrix_offsets_.clear();
+        domain_linsolvers_.clear();
+#if HAVE_SUITESPARSE_UMFPACK
+        domain_direct_solvers_.clear();
+#endif
+
+        // Scan through partitioning to get correct size for each.
+        std::vector<int> sizes(num_domains, 0);
+        for (const auto& p : partition_vector) {
+            ++sizes[p];
+        }
+
+        // Set up correctly sized vectors of entity seeds and of indices for each partition.
+        using EntitySeed = typename Grid::template Codim<0>::EntitySeed;
+        std::vector<std::vector<EntitySeed>> seeds(num_domains);
+        std::vector<std::vector<int>> partitions(num_domains);
+        for (int domain = 0; domain < num_domains; ++domain) {
+            seeds[domain].resize(sizes[domain]);
+            partitions[domain].resize(sizes[domain]);
+        }
+
+        // Iterate through grid once, setting the seeds of all partitions.
+        // Note: owned cells only!
+        const auto& grid = model_.ebosSimulator().vanguard().grid();
+
+        std::vector<int> count(num_domains, 0);
+        const auto& gridView = grid.leafGridView();
+        const auto beg = gridView.template begin<0, Dune::Interior_Partition>();
+        const auto end = gridView.template end<0, Dune::Interior_Partition>();
+        int cell = 0;
+        for (auto it = beg; it != end; ++it, ++cell) {
+            const int p = partition_vector[cell];
+            seeds[p][count[p]] = it->seed();
+            partitions[p][count[p]] = cell;
+            ++count[p];
+        }
+        assert(count == sizes);
+
+        // Create the domains.
+        for (int index = 0; index < num_domains; ++index) {
+            std::vector<bool> interior(partition_vector.size(), false);
+            for (int ix : partitions[index]) {
+                interior[ix] = true;
+            }
+
+            Dune::SubGridPart<Grid> view{grid, std::move(seeds[index])};
+
+            this->domains_.emplace_back(index,
+                                        std::move(partitions[index]),
+                                        std::move(interior),
+                                        std::move(view));
+        }
+
+        // Set up container for the local system matrices.
+        domain_matrices_.resize(num_domains);
+        domain_matrix_offsets_.resize(num_domains);
+#if HAVE_SUITESPARSE_UMFPACK
+        domain_direct_solvers_.resize(num_domains);
+#endif
+
+        // Set up container for the local linear solvers.
+        for (int index = 0; index < num_domains; ++index) {
+            // TODO: The ISTLSolverEbos constructor will make
+            // parallel structures appropriate for the full grid
+            // only. This must be addressed before going parallel.
+            const auto& eclState = model_.ebosSimulator().vanguard().eclState();
+            FlowLinearSolverParameters loc_param;
+            loc_param.template init<TypeTag>(eclState.getSimulationConfig().useCPR());
+            // Override solver type with umfpack if small domain.
+            // Otherwise hardcode to ILU0
+            if (useDirectSolver(domains_[index])) {
+                loc_param.linsolver_ = "umfpack";
+            } else {
+                loc_param.linsolver_ = "ilu0";
+                loc_param.linear_solver_reduction_ = 1e-2;
+            }
+            loc_param.linear_solver_print_json_definition_ = false;
+            const bool force_serial = true;
+            domain_linsolvers_.emplace_back(model_.ebosSimulator(), loc_param, force_serial);
+        }
+
+        domain_iterations_.assign(num_domains, 0.0);
+
+        assert(int(domains_.size()) == num_domains);
+    }
+
+    //! \brief Repartition the domains, weighting each cell by the number of
+    //!        local iterations of its domain in the report step.
+    //! \param threshold Repartition if the largest cost of a domain exceeds
+    //!                  the mean cost by this factor.
+    void repartitionIfImbalanced(const double threshold)
+    {
+        std::vector<int> cell_domain(model_.ebosSimulator().model().numGridDof(), -1);
+        for (const auto& domain : domains_) {
+            for (const int cell : domain.cells) {
+                cell_domain[cell] = domain.index;
+            }
+        }
+
+        const auto& comm = model_.ebosSimulator().vanguard().grid().comm();
+        const auto weights = imbalancedDomainCellWeights(cell_domain, domain_iterations_,
+                                                         threshold, comm);
+        if (weights.empty()) {
+            return;
+        }
+
+        if (comm.rank() == 0) {
+            OpmLog::debug("Repartitioning local domains due to imbalanced local solve cost.");
+        }
+
+        const auto& [partition_vector, new_num_domains] = this->partitionCells(&weights);
+        this->createDomains(partition_vector, new_num_domains);
+    }
+
     //! \brief Solve the equation system for a single domain.
     std::pair<SimulatorReportSingle, ConvergenceReport>
     solveDomain(const Domain& domain,
@@ -334,6 +399,7 @@ private:
                 [[maybe_unused]] const int global_iteration,
                 const bool initial_assembly_required)
     {
+        OPM_TIMEBLOCK_TREE(solveDomain);
         auto& ebosSimulator = model_.ebosSimulator();
 
         SimulatorReportSingle report;
@@ -461,10 +527,32 @@ private:
         perfTimer.start();
 
         const Mat& main_matrix = ebosSimulator.model().linearizer().jacobian().istlMatrix();
-        if (domain_matrices_[domain.index]) {
-            Details::copySubMatrix(main_matrix, domain.cells, *domain_matrices_[domain.index]);
-        } else {
+        const auto pattern = matrixPattern(main_matrix);
+        if (pattern != main_matrix_pattern_) {
+            // The global matrix was rebuilt, so the subdomain matrices, their
+            // offsets and direct solvers may no longer match its pattern.
+            for (auto& m : domain_matrices_) {
+                m.reset();
+            }
+            for (auto& offsets : domain_matrix_offsets_) {
+                offsets.clear();
+            }
+#if HAVE_SUITESPARSE_UMFPACK
+            for (auto& direct : domain_direct_solvers_) {
+                direct.reset();
+            }
+#endif
+            main_matrix_pattern_ = pattern;
+        }
+        auto& offsets = domain_matrix_offsets_[domain.index];
+        if (!domain_matrices_[domain.index]) {
             domain_matrices_[domain.index] = std::make_unique<Mat>(Details::extractMatrix(main_matrix, domain.cells));
+            offsets = Details::subMatrixOffsets(main_matrix, domain.cells, *domain_matrices_[domain.index]);
+        } else {
+            if (offsets.empty()) {
+                offsets = Details::subMatrixOffsets(main_matrix, domain.cells, *domain_matrices_[domain.index]);
+            }
+            Details::copySubMatrix(main_matrix, offsets, *domain_matrices_[domain.index]);
         }
         auto& jac = *domain_matrices_[domain.index];
         auto res = Details::extractVector(ebosSimulator.model().linearizer().residual(),
@@ -475,6 +563,22 @@ private:
         global_x = 0.0;
         x = 0.0;
 
+#if HAVE_SUITESPARSE_UMFPACK
+        if (useDirectSolver(domain)) {
+            // The pattern of the domain matrix never changes, so only the
+            // numeric factorization is redone for every solve.
+            auto& direct = domain_direct_solvers_[domain.index];
+            if (!direct) {
+                direct = std::make_unique<ReusableUMFPack<Mat>>(jac);
+            }
+            direct->factorize(jac);
+            model_.linearSolveSetupTime() = perfTimer.stop();
+            direct->solve(x, res);
+            Details::setGlobal(x, domain.cells, global_x);
+            return;
+        }
+#endif
+
         auto& linsolver = domain_linsolvers_[domain.index];
 
         linsolver.prepare(jac, res);
@@ -485,6 +589,28 @@ private:
         Details::setGlobal(x, domain.cells, global_x);
     }
 
+    //! \brief Storage of the sparsity pattern of a matrix.
+    //! \details A rebuilt matrix allocates new row and column storage, so a
+    //!          change of these identifies a pattern rebuild even if the
+    //!          number of nonzeroes is unchanged.
+    using MatrixPattern = std::tuple<const void*, const void*, std::size_t, std::size_t>;
+
+    //! \brief Row and column storage and size of a matrix.
+    static MatrixPattern matrixPattern(const Mat& matrix)
+    {
+        if (matrix.N() == 0) {
+            return {};
+        }
+        return { matrix[0].getindexptr(), &*matrix.begin()->begin(),
+                 matrix.N(), matrix.nonzeroes() };
+    }
+
+    //! \brief Whether to solve the linear systems of a domain with a direct solver.
+    static bool useDirectSolver(const Domain& domain)
+    {
+        return domain.cells.size() < 200;
+    }
+
     /// Apply an update to the primary variables.
     void updateDomainSolution(const Domain& domain, const BVector& dx)
     {
@@ -854,7 +980,9 @@ private:
         return errorPV;
     }
 
-    decltype(auto) partitionCells() const
+    //! \brief Partition the interior cells into domains.
+    //! \param cell_weights Optional computational cost of each cell
+    decltype(auto) partitionCells(const std::vector<double>* cell_weights = nullptr) const
     {
         const auto& grid = this->model_.ebosSimulator().vanguard().grid();
 
@@ -877,6 +1005,25 @@ private:
         {
             return cartMapper->cartesianIndex(elemIdx);
         };
+        if (cell_weights != nullptr) {
+            zoltan_ctrl.cell_weight = [cell_weights](const int elemIdx)
+            {
+                return (*cell_weights)[elemIdx];
+            };
+        }
+        if (param.local_domain_trans_weights_) {
+            // Relative transmissibility, so that well connections, which
+            // have unit weight, are never preferred for cutting.
+            const auto& problem = this->model_.ebosSimulator().problem();
+            const double max_trans = grid.comm().max(this->maxLocalTransmissibility());
+            zoltan_ctrl.connection_weight =
+                [&problem, max_trans](const int c1, const int c2)
+            {
+                constexpr double min_weight = 1.0e-6;
+                const double trans = problem.transmissibility(c1, c2);
+                return max_trans > 0.0 ? std::max(trans / max_trans, min_weight) : 1.0;
+            };
+        }
 
         // Forming the list of wells is expensive, so do this only if needed.
         const auto need_wells = param.local_domain_partition_method_ == "zoltan";
@@ -896,6 +1043,27 @@ private:
                                      grid.leafGridView(), wells, zoltan_ctrl);
     }
 
+    //! \brief Largest transmissibility between interior cells on this process.
+    double maxLocalTransmissibility() const
+    {
+        const auto& gridView = this->model_.ebosSimulator().vanguard().grid().leafGridView();
+        const auto& elementMapper = this->model_.ebosSimulator().model().elementMapper();
+        const auto& problem = this->model_.ebosSimulator().problem();
+
+        double max_trans = 0.0;
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            for (const auto& is : intersections(gridView, elem)) {
+                if (!is.neighbor()) {
+                    continue;
+                }
+                max_trans = std::max(max_trans,
+                                     static_cast<double>(problem.transmissibility(elementMapper.index(is.inside()),
+                                                                                  elementMapper.index(is.outside()))));
+            }
+        }
+        return max_trans;
+    }
+
     std::vector<int> reconstitutePartitionVector() const
     {
         const auto& grid = this->model_.ebosSimulator().vanguard().grid();
@@ -927,8 +1095,14 @@ private:
     BlackoilModelEbos<TypeTag>& model_; //!< Reference to model
     std::vector<Domain> domains_; //!< Vector of subdomains
     std::vector<std::unique_ptr<Mat>> domain_matrices_; //!< Vector of matrix operator for each subdomain
+    std::vector<std::vector<std::size_t>> domain_matrix_offsets_; //!< Positions of the entries of each subdomain matrix in the global matrix
+    MatrixPattern main_matrix_pattern_{}; //!< Pattern of the global matrix the subdomain matrices refer to
+#if HAVE_SUITESPARSE_UMFPACK
+    std::vector<std::unique_ptr<ReusableUMFPack<Mat>>> domain_direct_solvers_; //!< Direct solvers of the small subdomains
+#endif
     std::vector<ISTLSolverType> domain_linsolvers_; //!< Vector of linear solvers for each domain
     SimulatorReportSingle local_reports_accumulated_; //!< Accumulated convergence report for subdomain solvers
+    std::vector<double> domain_iterations_; //!< Local iterations of each domain in the current report step
 };
 
 } // namespace Opm
@@ -27,6 +27,7 @@
 #include <opm/models/utils/propertysystem.hh>
 
 #include <opm/simulators/flow/SubDomain.hpp>
+#include <opm/simulators/utils/TwoLevelGather.hpp>
 
 #include <stdexcept>
 #include <string>
@@ -182,6 +183,10 @@ template<class TypeTag, class MyTypeTag>
 struct LocalWellSolveControlSwitching {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct UseIprForThpLimit {
+    using type = UndefinedProperty;
+};
 // Network solver parameters
 template<class TypeTag, class MyTypeTag>
 struct NetworkMaxStrictIterations {
@@ -231,6 +236,18 @@ template<class TypeTag, class MyTypeTag>
 struct LocalDomainsOrderingMeasure {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct LocalDomainsTransmissibilityWeights {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LocalDomainsRepartitionThreshold {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EnableTwoLevelGather {
+    using type = UndefinedProperty;
+};
 template<class TypeTag>
 struct DbhpMaxRel<TypeTag, TTag::FlowModelParameters> {
     using type = GetPropType<TypeTag, Scalar>;
@@ -386,6 +403,10 @@ template<class TypeTag>
 struct LocalWellSolveControlSwitching<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
+template<class TypeTag>
+struct UseIprForThpLimit<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
 
 // Network solver parameters
 template<class TypeTag>
@@ -441,6 +462,19 @@ template<class TypeTag>
 struct LocalDomainsOrderingMeasure<TypeTag, TTag::FlowModelParameters> {
     static constexpr auto value = "maxpressure";
 };
+template<class TypeTag>
+struct LocalDomainsTransmissibilityWeights<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct LocalDomainsRepartitionThreshold<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr auto value = type{0.0};
+};
+template<class TypeTag>
+struct EnableTwoLevelGather<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
 // if openMP is available, determine the number threads per process automatically.
 #if _OPENMP
 template<class TypeTag>
@@ -559,6 +593,10 @@ namespace Opm
         /// Whether to allow control switching during local well solutions 
         bool local_well_solver_control_switching_;
 
+        /// Whether to solve for the bhp at the THP limit of standard producers
+        /// from the inflow performance relationship before the robust search
+        bool use_ipr_for_thp_limit_;
+
         /// Maximum number of iterations in the network solver before relaxing tolerance
         int network_max_strict_iterations_;
         
@@ -580,9 +618,14 @@ namespace Opm
         double local_domain_partition_imbalance_{1.03};
         std::string local_domain_partition_method_;
         DomainOrderingMeasure local_domain_ordering_{DomainOrderingMeasure::MaxPressure};
+        bool local_domain_trans_weights_{false};
+        double local_domain_repartition_threshold_{0.0};
 
         bool write_partitions_{false};
 
+        /// Algorithm for gathering convergence reports, logs and output data.
+        GatherMethod gather_method_{GatherMethod::Flat};
+
         /// Construct from user parameters or defaults.
         BlackoilModelParametersEbos()
         {
@@ -619,6 +662,7 @@ namespace Opm
             max_number_of_well_switches_ = EWOMS_GET_PARAM(TypeTag, int, MaximumNumberOfWellSwitches);
             use_average_density_ms_wells_ = EWOMS_GET_PARAM(TypeTag, bool, UseAverageDensityMsWells);
             local_well_solver_control_switching_ = EWOMS_GET_PARAM(TypeTag, bool, LocalWellSolveControlSwitching);
+            use_ipr_for_thp_limit_ = EWOMS_GET_PARAM(TypeTag, bool, UseIprForThpLimit);
             nonlinear_solver_ = EWOMS_GET_PARAM(TypeTag, std::string, NonlinearSolver);
             const auto approach = EWOMS_GET_PARAM(TypeTag, std::string, LocalSolveApproach);
             if (approach == "jacobi") {
@@ -640,7 +684,11 @@ namespace Opm
             network_max_strict_iterations_ = EWOMS_GET_PARAM(TypeTag, int, NetworkMaxStrictIterations);
             network_max_iterations_ = EWOMS_GET_PARAM(TypeTag, int, NetworkMaxIterations);
             local_domain_ordering_ = domainOrderingMeasureFromString(EWOMS_GET_PARAM(TypeTag, std::string, LocalDomainsOrderingMeasure));
+            local_domain_trans_weights_ = EWOMS_GET_PARAM(TypeTag, bool, LocalDomainsTransmissibilityWeights);
+            local_domain_repartition_threshold_ = EWOMS_GET_PARAM(TypeTag, double, LocalDomainsRepartitionThreshold);
             write_partitions_ = EWOMS_GET_PARAM(TypeTag, bool, DebugEmitCellPartition);
+            gather_method_ = EWOMS_GET_PARAM(TypeTag, bool, EnableTwoLevelGather)
+                ? GatherMethod::TwoLevel : GatherMethod::Flat;
         }
 
         static void registerParameters()
@@ -680,6 +728,8 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, MaximumNumberOfWellSwitches, "Maximum number of times a well can switch to the same control");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseAverageDensityMsWells, "Approximate segment densitities by averaging over segment and its outlet");
             EWOMS_REGISTER_PARAM(TypeTag, bool, LocalWellSolveControlSwitching, "Allow control switching during local well solutions");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseIprForThpLimit, "Solve for the bottom-hole pressure at the THP limit of standard producers "
+                                 "from the linearized inflow performance relationship, and only use the robust search if its solution is not accurate");
             EWOMS_REGISTER_PARAM(TypeTag, int, NetworkMaxStrictIterations, "Maximum iterations in network solver before relaxing tolerance");
             EWOMS_REGISTER_PARAM(TypeTag, int, NetworkMaxIterations, "Maximum number of iterations in the network solver before giving up");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, NonlinearSolver, "Choose nonlinear solver. Valid choices are newton or nldd.");
@@ -694,6 +744,14 @@ namespace Opm
                                  "Allowed values are 'zoltan', 'simple', and the name of a partition file ending with '.partition'.");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LocalDomainsOrderingMeasure, "Subdomain ordering measure. "
                                  "Allowed values are 'maxpressure', 'averagepressure' and  'residual'.");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LocalDomainsTransmissibilityWeights, "Use relative transmissibilities as connection weights "
+                                 "in Zoltan subdomain partitioning, so that strongly coupled cells tend to be in the same subdomain.");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalDomainsRepartitionThreshold, "Repartition subdomains at report steps when the largest "
+                                 "local solve cost of a subdomain exceeds the mean by this factor. Cells are then weighted by the local "
+                                 "iterations of their subdomain. Only used with Zoltan partitioning. Non-positive values disable repartitioning.");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTwoLevelGather,
+                                 "Gather logs, convergence reports and output data in two levels, "
+                                 "first within each compute node and then across nodes.");
 
             EWOMS_REGISTER_PARAM(TypeTag, bool, DebugEmitCellPartition, "Whether or not to emit cell partitions as a debugging aid.");
 
@@ -54,25 +54,33 @@ addConnection(const Cell& source,
         };
     }
 
+    if (! this->isInterRegionConnection(source, destination)) {
+        return;
+    }
+
+    // Inter-region connection internal to an MPI rank or this rank owns
+    // the flow rate across this connection.
+    this->iregFlow_.addConnection(this->region_[ source.activeIndex ],
+                                  this->region_[ destination.activeIndex ],
+                                  rates);
+}
+
+bool
+Opm::EclInterRegFlowMapSingleFIP::
+isInterRegionConnection(const Cell& source,
+                        const Cell& destination) const
+{
     if (! source.isInterior ||
         (source.cartesianIndex > destination.cartesianIndex))
     {
         // Connection handled in different call.  Don't double-count
         // contributions.
-        return;
-    }
-
-    const auto r1 = this->region_[ source.activeIndex ];
-    const auto r2 = this->region_[ destination.activeIndex ];
-
-    if (r1 == r2) {
-        // Connection is internal to a region.  Nothing to do.
-        return;
+        return false;
     }
 
-    // Inter-region connection internal to an MPI rank or this rank owns
-    // the flow rate across this connection.
-    this->iregFlow_.addConnection(r1, r2, rates);
+    // Connections internal to a region do not contribute.
+    return this->region_[ source.activeIndex ]
+        != this->region_[ destination.activeIndex ];
 }
 
 void Opm::EclInterRegFlowMapSingleFIP::compress()
@@ -152,6 +160,18 @@ addConnection(const Cell& source,
     }
 }
 
+bool
+Opm::EclInterRegFlowMap::
+isInterRegionConnection(const Cell& source,
+                        const Cell& destination) const
+{
+    return std::any_of(this->regionMaps_.begin(), this->regionMaps_.end(),
+                       [&source, &destination](const auto& regionMap)
+                       {
+                           return regionMap.isInterRegionConnection(source, destination);
+                       });
+}
+
 void Opm::EclInterRegFlowMap::compress()
 {
     for (auto& regionMap : this->regionMaps_) {
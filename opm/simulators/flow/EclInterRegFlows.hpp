@@ -83,6 +83,15 @@ namespace Opm {
                            const Cell& destination,
                            const data::InterRegFlowMap::FlowRates& rates);
 
+        /// Whether or not addConnection() includes the flow rates of a
+        /// connection.
+        ///
+        /// \param[in] source Cell from which the flow nominally originates.
+        ///
+        /// \param[in] destination Cell into which flow nominally goes.
+        bool isInterRegionConnection(const Cell& source,
+                                     const Cell& destination) const;
+
         /// Form CSR adjacency matrix representation of input graph from
         /// connections established in previous calls to addConnection().
         ///
@@ -238,6 +247,15 @@ namespace Opm {
                            const Cell& destination,
                            const data::InterRegFlowMap::FlowRates& rates);
 
+        /// Whether or not addConnection() includes the flow rates of a
+        /// connection for at least one region definition.
+        ///
+        /// \param[in] source Cell from which the flow nominally originates.
+        ///
+        /// \param[in] destination Cell into which flow nominally goes.
+        bool isInterRegionConnection(const Cell& source,
+                                     const Cell& destination) const;
+
         /// Form CSR adjacency matrix representation of input graph from
         /// connections established in previous calls to addConnection().
         ///
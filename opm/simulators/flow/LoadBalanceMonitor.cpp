@@ -0,0 +1,89 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
+
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <opm/simulators/utils/FusedReduction.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include <fmt/format.h>
+
+namespace Opm {
+
+LoadBalanceMonitor::LoadBalanceMonitor(Parallel::Communication comm,
+                                       const double threshold)
+    : comm_     { comm }
+    , threshold_{ threshold }
+{}
+
+bool LoadBalanceMonitor::reportStepCompleted(const SimulatorReportSingle& cumulative)
+{
+    const auto current = costs(cumulative);
+
+    FusedReduction reduction(this->comm_);
+    std::array<std::size_t, 4> sumIdx{};
+    std::array<std::size_t, 4> maxIdx{};
+    for (std::size_t comp = 0; comp < current.size(); ++comp) {
+        const double cost = current[comp] - this->previous_[comp];
+        sumIdx[comp] = reduction.addSum(cost);
+        maxIdx[comp] = reduction.addMax(cost);
+    }
+    reduction.start();
+    reduction.finish();
+
+    for (std::size_t comp = 0; comp < current.size(); ++comp) {
+        this->mean_[comp] = reduction.sum(sumIdx[comp]) / this->comm_.size();
+        this->max_[comp] = reduction.max(maxIdx[comp]);
+    }
+    this->previous_ = current;
+
+    this->imbalance_ = this->mean_[Total] > 0.0
+        ? this->max_[Total] / this->mean_[Total]
+        : 1.0;
+
+    return this->active() && (this->imbalance_ > this->threshold_);
+}
+
+std::string LoadBalanceMonitor::summary() const
+{
+    return fmt::format("Load imbalance (max/mean) {:.2f}: "
+                       "assembly {:.2f}/{:.2f} s, "
+                       "wells {:.2f}/{:.2f} s, "
+                       "linear solve {:.2f}/{:.2f} s",
+                       this->imbalance_,
+                       this->max_[Assembly], this->mean_[Assembly],
+                       this->max_[Wells], this->mean_[Wells],
+                       this->max_[LinearSolve], this->mean_[LinearSolve]);
+}
+
+LoadBalanceMonitor::Costs
+LoadBalanceMonitor::costs(const SimulatorReportSingle& report)
+{
+    // The assembly time includes the time spent assembling the wells.
+    Costs result{};
+    result[Assembly] = report.assemble_time - report.assemble_time_well;
+    result[Wells] = report.assemble_time_well;
+    result[LinearSolve] = report.linear_solve_setup_time + report.linear_solve_time;
+    result[Total] = result[Assembly] + result[Wells] + result[LinearSolve];
+    return result;
+}
+
+} // namespace Opm
@@ -0,0 +1,125 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOAD_BALANCE_MONITOR_HPP
+#define LOAD_BALANCE_MONITOR_HPP
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <array>
+#include <string>
+
+namespace Opm {
+
+struct SimulatorReportSingle;
+
+/// Measure the load balance of the processes over report steps.
+///
+/// The cost of a process in a report step is the time it spent in
+/// assembly of the reservoir equations, in the well model and in the
+/// linear solver, as reported by the timing reports.  The imbalance of a
+/// report step is the ratio of the largest to the mean cost over all
+/// processes.  A value of one means perfect balance.
+///
+/// This only monitors the balance.  The grid is not repartitioned at
+/// runtime, since the grid cannot redistribute from a distributed view and
+/// the simulator state cannot be migrated between processes.
+class LoadBalanceMonitor
+{
+public:
+    /// Cost components.
+    enum Component { Assembly = 0, Wells = 1, LinearSolve = 2, Total = 3 };
+
+    /// Constructor.
+    ///
+    /// \param[in] comm Communicator of the processes to compare.
+    ///
+    /// \param[in] threshold Imbalance above which the load is considered
+    ///    imbalanced.  Non-positive values disable the check.
+    LoadBalanceMonitor(Parallel::Communication comm, double threshold);
+
+    /// Whether or not the imbalance is checked at all.
+    bool active() const
+    {
+        return this->threshold_ > 0.0;
+    }
+
+    /// Compare the cost of the processes in the report step just completed.
+    ///
+    /// Collective operation.
+    ///
+    /// \param[in] cumulative Timing report accumulated over all report
+    ///    steps so far.  The cost of the report step is the difference to
+    ///    the report passed in the previous call.
+    ///
+    /// \return Whether or not the imbalance of the report step exceeds
+    ///    the threshold.
+    bool reportStepCompleted(const SimulatorReportSingle& cumulative);
+
+    /// Imbalance of the last report step.
+    double imbalance() const
+    {
+        return this->imbalance_;
+    }
+
+    /// Largest cost of any process in the last report step.
+    ///
+    /// \param[in] comp Cost component.
+    double maxCost(Component comp) const
+    {
+        return this->max_[comp];
+    }
+
+    /// Mean cost over all processes in the last report step.
+    ///
+    /// \param[in] comp Cost component.
+    double meanCost(Component comp) const
+    {
+        return this->mean_[comp];
+    }
+
+    /// Single line description of the balance in the last report step.
+    std::string summary() const;
+
+private:
+    using Costs = std::array<double, 4>;
+
+    /// Cost components of a cumulative timing report.
+    static Costs costs(const SimulatorReportSingle& report);
+
+    /// Communicator of the processes to compare.
+    Parallel::Communication comm_;
+
+    /// Imbalance above which the load is considered imbalanced.
+    double threshold_{};
+
+    /// Cumulative cost at end of previous report step.
+    Costs previous_{};
+
+    /// Largest cost of any process in the last report step.
+    Costs max_{};
+
+    /// Mean cost over all processes in the last report step.
+    Costs mean_{};
+
+    /// Imbalance of the last report step.
+    double imbalance_ = 1.0;
+};
+
+} // namespace Opm
+
+#endif // LOAD_BALANCE_MONITOR_HPP
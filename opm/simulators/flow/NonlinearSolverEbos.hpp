@@ -21,6 +21,7 @@
 #ifndef OPM_NON_LINEAR_SOLVER_EBOS_HPP
 #define OPM_NON_LINEAR_SOLVER_EBOS_HPP
 
+#include <opm/simulators/timestepping/ConvergenceRateModel.hpp>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/simulators/timestepping/SimulatorTimerInterface.hpp>
@@ -33,6 +34,7 @@
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
+#include <algorithm>
 #include <memory>
 
 namespace Opm::Properties {
@@ -57,6 +59,10 @@ template<class TypeTag, class MyTypeTag>
 struct NewtonRelaxationType{
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct NewtonPredictFailureIteration{
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct NewtonMaxRelax<TypeTag, TTag::FlowNonLinearSolver> {
@@ -75,6 +81,10 @@ template<class TypeTag>
 struct NewtonRelaxationType<TypeTag, TTag::FlowNonLinearSolver> {
     static constexpr auto value = "dampen";
 };
+template<class TypeTag>
+struct NewtonPredictFailureIteration<TypeTag, TTag::FlowNonLinearSolver> {
+    static constexpr int value = 0;
+};
 
 } // namespace Opm::Properties
 
@@ -120,6 +130,7 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
             double relaxRelTol_;
             int maxIter_; // max nonlinear iterations
             int minIter_; // min nonlinear iterations
+            int predictFailureIter_; // first iteration to predict convergence failure at, 0 to disable
 
             SolverParameters()
             {
@@ -130,6 +141,7 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 relaxMax_ = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonMaxRelax);
                 maxIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonMaxIterations);
                 minIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonMinIterations);
+                predictFailureIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonPredictFailureIteration);
 
                 const auto& relaxationTypeString = EWOMS_GET_PARAM(TypeTag, std::string, NewtonRelaxationType);
                 if (relaxationTypeString == "dampen") {
@@ -148,6 +160,10 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 EWOMS_REGISTER_PARAM(TypeTag, int, NewtonMaxIterations, "The maximum number of Newton iterations per time step");
                 EWOMS_REGISTER_PARAM(TypeTag, int, NewtonMinIterations, "The minimum number of Newton iterations per time step");
                 EWOMS_REGISTER_PARAM(TypeTag, std::string, NewtonRelaxationType, "The type of relaxation used by Newton method");
+                EWOMS_REGISTER_PARAM(TypeTag, int, NewtonPredictFailureIteration,
+                                     "Abort a time step from this Newton iteration on if the convergence rate fitted to the "
+                                     "residuals predicts that it will not converge within the maximum number of iterations, "
+                                     "and retry with a time step chosen from the fitted rate. 0 disables the prediction");
             }
 
             void reset()
@@ -159,6 +175,7 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 relaxRelTol_ = 0.2;
                 maxIter_ = 10;
                 minIter_ = 1;
+                predictFailureIter_ = 0;
             }
 
         };
@@ -195,6 +212,11 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
 
         SimulatorReportSingle step(const SimulatorTimerInterface& timer)
         {
+            // Reset first, so that a failure in prepareStep() is not taken
+            // for a predicted failure of the previous step.
+            failurePredicted_ = false;
+            convergenceRate_.reset();
+
             SimulatorReportSingle report;
             report.global_time = timer.simulationTimeElapsed();
             report.timestep_length = timer.currentStepLength();
@@ -230,13 +252,26 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                     failureReport_ += model_->failureReport();
                     throw;
                 }
+
+                // Give up early rather than spending the remaining iterations.
+                if (!converged && predictFailure(iteration) && iteration <= maxIter()) {
+                    failurePredicted_ = true;
+                    break;
+                }
             }
             while ( (!converged && (iteration <= maxIter())) || (iteration <= minIter()));
 
             if (!converged) {
                 failureReport_ = report;
 
-                std::string msg = "Solver convergence failure - Failed to complete a time step within " + std::to_string(maxIter()) + " iterations.";
+                std::string msg;
+                if (failurePredicted_) {
+                    failureReport_.aborted_substeps = 1;
+                    msg = "Solver convergence failure - Predicted not to complete the time step within "
+                        + std::to_string(maxIter()) + " iterations after " + std::to_string(iteration) + " iterations.";
+                } else {
+                    msg = "Solver convergence failure - Failed to complete a time step within " + std::to_string(maxIter()) + " iterations.";
+                }
                 OPM_THROW_NOLOG(TooManyIterations, msg);
             }
 
@@ -250,6 +285,19 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
         const SimulatorReportSingle& failureReport() const
         { return failureReport_; }
 
+        /// Factor to cut the time step by after the last call to step() failed.
+        /// If the failure was predicted from the convergence rate, the factor is
+        /// chosen such that the retried step is predicted to converge within half
+        /// the maximum number of iterations, otherwise it is defaultFactor.
+        double retryTimeStepFactor(const double defaultFactor) const
+        {
+            if (!failurePredicted_) {
+                return defaultFactor;
+            }
+            const int target = std::max(maxIter() / 2, minIter());
+            return convergenceRate_.timeStepFactor(target, 0.1, 0.9);
+        }
+
         /// Number of linearizations used in all calls to step().
         int linearizations() const
         { return linearizations_; }
@@ -336,10 +384,26 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
         { param_ = param; }
 
     private:
+        /// Add the residual of the last iteration to the convergence rate
+        /// model, and return true if the time step is predicted to fail.
+        bool predictFailure(const int iteration)
+        {
+            if (param_.predictFailureIter_ <= 0) {
+                return false;
+            }
+            convergenceRate_.addIteration(model_->convergenceMeasure());
+            // The residual is checked at the start of an iteration, so the
+            // last measure belongs to iteration - 1.
+            return iteration >= param_.predictFailureIter_ &&
+                   iteration - 1 + convergenceRate_.remainingIterations() > maxIter();
+        }
+
         // ---------  Data members  ---------
         SimulatorReportSingle failureReport_;
         SolverParameters param_;
         std::unique_ptr<PhysicalModel> model_;
+        ConvergenceRateModel convergenceRate_;
+        bool failurePredicted_ = false;
         int linearizations_;
         int nonlinearIterations_;
         int linearIterations_;
@@ -29,11 +29,15 @@
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
 #include <opm/simulators/flow/ConvergenceOutputConfiguration.hpp>
 #include <opm/simulators/flow/ExtraConvergenceOutputThread.hpp>
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
 #include <opm/simulators/flow/NonlinearSolverEbos.hpp>
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
+#include <opm/simulators/utils/MemoryUsage.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
+#include <opm/simulators/utils/ParallelEclipseState.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <opm/grid/utility/StopWatch.hpp>
@@ -45,6 +49,7 @@
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <optional>
 #include <string>
@@ -55,6 +60,7 @@
 
 #if HAVE_HDF5
 #include <ebos/hdf5serializer.hh>
+#include <opm/simulators/utils/HDF5CheckpointWriter.hpp>
 #endif
 
 namespace Opm::Properties {
@@ -98,6 +104,60 @@ struct LoadFile
     using type = UndefinedProperty;
 };
 
+template <class TypeTag, class MyTypeTag>
+struct SaveStepAsync
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct SaveStepCompression
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct SaveStepsToKeep
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct SaveStepDelta
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct SaveStepDeltaChunkSize
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct LoadImbalanceThreshold
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct TimingReportFile
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct TimingReportEveryStep
+{
+    using type = UndefinedProperty;
+};
+
+template <class TypeTag, class MyTypeTag>
+struct EnableMemoryReport
+{
+    using type = UndefinedProperty;
+};
+
 template<class TypeTag>
 struct EnableTerminalOutput<TypeTag, TTag::EclFlowProblem> {
     static constexpr bool value = true;
@@ -141,6 +201,61 @@ struct LoadStep<TypeTag, TTag::EclFlowProblem>
     static constexpr int value = -1;
 };
 
+template <class TypeTag>
+struct SaveStepAsync<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr bool value = true;
+};
+
+template <class TypeTag>
+struct SaveStepCompression<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr int value = 1;
+};
+
+template <class TypeTag>
+struct SaveStepsToKeep<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr int value = 0;
+};
+
+template <class TypeTag>
+struct SaveStepDelta<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr bool value = false;
+};
+
+template <class TypeTag>
+struct SaveStepDeltaChunkSize<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr int value = 4096;
+};
+
+template <class TypeTag>
+struct LoadImbalanceThreshold<TypeTag, TTag::EclFlowProblem>
+{
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+
+template <class TypeTag>
+struct TimingReportFile<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr auto* value = "";
+};
+
+template <class TypeTag>
+struct TimingReportEveryStep<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr bool value = false;
+};
+
+template <class TypeTag>
+struct EnableMemoryReport<TypeTag, TTag::EclFlowProblem>
+{
+    static constexpr bool value = false;
+};
+
 } // namespace Opm::Properties
 
 namespace Opm {
@@ -167,6 +282,7 @@ public:
     using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
     using MaterialLawParams = GetPropType<TypeTag, Properties::MaterialLawParams>;
     using AquiferModel = GetPropType<TypeTag, Properties::EclAquiferModel>;
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
 
     typedef AdaptiveTimeSteppingEbos<TypeTag> TimeStepper;
     typedef BlackOilPolymerModule<TypeTag> PolymerModule;
@@ -228,6 +344,16 @@ public:
 
         loadStep_ = EWOMS_GET_PARAM(TypeTag, int, LoadStep);
 
+        ebosSimulator_.problem().eclWriter()->setGatherMethod(modelParam_.gather_method_);
+
+        loadBalanceMonitor_.emplace(this->grid().comm(),
+                                    EWOMS_GET_PARAM(TypeTag, Scalar, LoadImbalanceThreshold));
+
+        timingReportFile_ = EWOMS_GET_PARAM(TypeTag, std::string, TimingReportFile);
+        timingReportEveryStep_ = EWOMS_GET_PARAM(TypeTag, bool, TimingReportEveryStep);
+        TimerTree::setEnabled(!timingReportFile_.empty());
+        enableMemoryReport_ = EWOMS_GET_PARAM(TypeTag, bool, EnableMemoryReport);
+
         saveFile_ = EWOMS_GET_PARAM(TypeTag, std::string, SaveFile);
         loadFile_ = EWOMS_GET_PARAM(TypeTag, std::string, LoadFile);
         
@@ -292,6 +418,37 @@ public:
                              "FileName for .OPMRST file used to load serialized state. "
                              "If empty, CASENAME.OPMRST is used.");
         EWOMS_HIDE_PARAM(TypeTag, LoadFile);        
+        EWOMS_REGISTER_PARAM(TypeTag, bool, SaveStepAsync,
+                             "Write serialized state to .OPMRST file on a separate thread. "
+                             "Parallel runs require an MPI library with full thread support, "
+                             "otherwise the state is written synchronously.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, SaveStepCompression,
+                             "Compression level (0-9) for serialized state. 0 disables compression.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, SaveStepsToKeep,
+                             "Maximum number of report steps kept in .OPMRST file. "
+                             "Older steps are removed. 0 keeps all steps.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, SaveStepDelta,
+                             "Store only the parts of the serialized state that changed "
+                             "since the last full step in .OPMRST file.");
+        EWOMS_REGISTER_PARAM(TypeTag, int, SaveStepDeltaChunkSize,
+                             "Size in bytes of the chunks the serialized state is compared "
+                             "in when storing only the changed parts of it.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, LoadImbalanceThreshold,
+                             "Warn at report steps where the largest assembly, well and linear solver "
+                             "time of a process exceeds the mean over all processes by this factor. "
+                             "Non-positive values disable the check.");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, TimingReportFile,
+                             "Write a hierarchical timing report with the minimum, mean and maximum "
+                             "over all processes of each timed phase to this JSON file at the end "
+                             "of the run. Empty disables the timers.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, TimingReportEveryStep,
+                             "Also write the cumulative timing report after every report step, "
+                             "to the timing report file with the step number appended.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableMemoryReport,
+                             "Log the memory held by the transmissibilities, the intensive quantity "
+                             "cache, the output buffers and the distributed field properties, with "
+                             "the minimum, mean and maximum over all processes, at the start of the "
+                             "simulation and after every report step.");
     }
 
     /// Run the simulation.
@@ -344,6 +501,10 @@ public:
                 adaptiveTimeStepping_->setSuggestedNextStep(ebosSimulator_.timeStepSize());
             }
         }
+
+        if (enableMemoryReport_) {
+            writeMemoryReport("Memory at start of simulation");
+        }
     }
 
     void updateTUNING(const Tuning& tuning) {
@@ -355,6 +516,69 @@ public:
 
     bool runStep(SimulatorTimer& timer)
     {
+        const bool result = runTimedStep(timer);
+
+        // Written once the timer of the step is stopped, to include it. The
+        // step has already advanced the timer.
+        if (result && timingReportEveryStep_ && !timingReportFile_.empty()) {
+            writeTimingReport(fmt::format("{}.{:04d}", timingReportFile_, timer.currentStepNum() - 1));
+        }
+
+        return result;
+    }
+
+    SimulatorReport finalize()
+    {
+#if HAVE_HDF5
+        // make sure serialized state has been written
+        if (checkpointWriter_) {
+            OPM_BEGIN_PARALLEL_TRY_CATCH();
+            checkpointWriter_->wait();
+            OPM_END_PARALLEL_TRY_CATCH("Error saving serialized state: ",
+                                       EclGenericVanguard::comm());
+        }
+#endif
+
+        // make sure all output is written to disk before run is finished
+        {
+            Dune::Timer finalOutputTimer;
+            finalOutputTimer.start();
+
+            ebosSimulator_.problem().finalizeOutput();
+            report_.success.output_write_time += finalOutputTimer.stop();
+        }
+
+        // Stop timer and create timing report
+        totalTimer_->stop();
+        report_.success.total_time = totalTimer_->secsSinceStart();
+        report_.success.converged = true;
+
+        if (!timingReportFile_.empty()) {
+            writeTimingReport(timingReportFile_);
+        }
+
+        return report_;
+    }
+
+    const Grid& grid() const
+    { return ebosSimulator_.vanguard().grid(); }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(ebosSimulator_);
+        serializer(report_);
+        serializer(adaptiveTimeStepping_);
+    }
+
+    const Model& model() const
+    { return solver_->model(); }
+
+protected:
+    //! \brief Run one report step, timed by the timer tree.
+    bool runTimedStep(SimulatorTimer& timer)
+    {
+        OPM_TIMEBLOCK_TREE(runStep);
         if (schedule().exitStatus().has_value()) {
             if (terminalOutput_) {
                 OpmLog::info("Stopping simulation since EXIT was triggered by an action keyword.");
@@ -469,6 +693,12 @@ public:
         // update timing.
         report_.success.solver_time += solverTimer_->secsSinceStart();
 
+        checkLoadBalance();
+
+        if (enableMemoryReport_) {
+            writeMemoryReport(fmt::format("Memory after report step {}", timer.currentStepNum()));
+        }
+
         if (this->grid().comm().rank() == 0) {
             // Grab the step convergence reports that are new since last we were here.
             const auto& reps = solver_->model().stepReports();
@@ -496,41 +726,6 @@ public:
         return true;
     }
 
-    SimulatorReport finalize()
-    {
-        // make sure all output is written to disk before run is finished
-        {
-            Dune::Timer finalOutputTimer;
-            finalOutputTimer.start();
-
-            ebosSimulator_.problem().finalizeOutput();
-            report_.success.output_write_time += finalOutputTimer.stop();
-        }
-
-        // Stop timer and create timing report
-        totalTimer_->stop();
-        report_.success.total_time = totalTimer_->secsSinceStart();
-        report_.success.converged = true;
-
-        return report_;
-    }
-
-    const Grid& grid() const
-    { return ebosSimulator_.vanguard().grid(); }
-
-    template<class Serializer>
-    void serializeOp(Serializer& serializer)
-    {
-        serializer(ebosSimulator_);
-        serializer(report_);
-        serializer(adaptiveTimeStepping_);
-    }
-
-    const Model& model() const
-    { return solver_->model(); }
-
-protected:
-
     std::unique_ptr<Solver> createSolver(WellModel& wellModel)
     {
         auto model = std::make_unique<Model>(ebosSimulator_,
@@ -637,6 +832,64 @@ protected:
         this->convergenceOutputThread_->join();
     }
 
+    //! \brief Compare the cost of the processes in the report step just completed.
+    //! \details Only logs the balance, the grid is not repartitioned.
+    void checkLoadBalance()
+    {
+        if (!loadBalanceMonitor_->active() || this->grid().comm().size() == 1) {
+            return;
+        }
+
+        auto cumulative = report_.success;
+        cumulative += report_.failure;
+        const bool imbalanced = loadBalanceMonitor_->reportStepCompleted(cumulative);
+        if (terminalOutput_) {
+            if (imbalanced) {
+                OpmLog::warning(loadBalanceMonitor_->summary());
+            } else {
+                OpmLog::debug(loadBalanceMonitor_->summary());
+            }
+        }
+    }
+
+    //! \brief Log the memory held by the main subsystems.
+    //! \details Collective operation.
+    void writeMemoryReport(const std::string& title)
+    {
+        const auto& problem = ebosSimulator_.problem();
+        const auto& writer = *problem.eclWriter();
+        const auto* parallelEclState = dynamic_cast<const ParallelEclipseState*>(&eclState());
+
+        MemoryReport memory;
+        memory.add("Transmissibilities", problem.eclTransmissibilities().memoryUsage());
+        memory.add("Intensive quantity cache",
+                   ebosSimulator_.model().intensiveQuantityCacheMemoryUsage());
+        memory.add("Output buffers", writer.eclOutputModule().memoryUsage());
+        memory.add("Inter-region flux faces", writer.eclOutputModule().fluxFaceMemoryUsage());
+        memory.add("Output data on I/O rank", writer.collectedDataMemoryUsage());
+        memory.add("Distributed field properties",
+                   parallelEclState != nullptr ? parallelEclState->distributedPropsMemoryUsage() : 0);
+
+        const auto table = memory.table(this->grid().comm(), title);
+        if (terminalOutput_) {
+            OpmLog::info(table);
+        }
+    }
+
+    //! \brief Write the times recorded by the timer tree so far.
+    void writeTimingReport(const std::string& filename)
+    {
+        const auto json = TimerTree::json(this->grid().comm());
+        if (this->grid().comm().rank() == 0) {
+            std::ofstream file(filename);
+            if (!file) {
+                OpmLog::warning("Could not write timing report to " + filename);
+                return;
+            }
+            file << json;
+        }
+    }
+
     //! \brief Serialization of simulator data to .OPMRST files at end of report steps.
     void handleSave(SimulatorTimer& timer)
     {
@@ -652,33 +905,61 @@ protected:
 #if !HAVE_HDF5
             OpmLog::error("Saving of serialized state requested, but no HDF5 support available.");
 #else
-            const std::string groupName = "/report_step/" + std::to_string(nextStep);
-            if (saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_) {
-                std::filesystem::remove(saveFile_);
+            if (!checkpointWriter_) {
+                HDF5CheckpointWriter::Options options;
+                options.async = EWOMS_GET_PARAM(TypeTag, bool, SaveStepAsync);
+                options.compression = EWOMS_GET_PARAM(TypeTag, int, SaveStepCompression);
+                options.chunkSize = 1 << 26;
+                options.stepsToKeep = EWOMS_GET_PARAM(TypeTag, int, SaveStepsToKeep);
+                if (EWOMS_GET_PARAM(TypeTag, bool, SaveStepDelta)) {
+                    const int deltaChunkSize = EWOMS_GET_PARAM(TypeTag, int, SaveStepDeltaChunkSize);
+                    if (deltaChunkSize <= 0) {
+                        OPM_THROW(std::invalid_argument,
+                                  "SaveStepDeltaChunkSize must be positive");
+                    }
+                    options.deltaChunkSize = deltaChunkSize;
+                }
+                checkpointWriter_ = std::make_unique<HDF5CheckpointWriter>(saveFile_,
+                                                                           EclGenericVanguard::comm(),
+                                                                           options);
             }
-            HDF5Serializer writer(saveFile_,
-                                  HDF5File::OpenMode::APPEND,
-                                  EclGenericVanguard::comm());
-            if (saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_) {
+
+            // Pack a snapshot of the state, the writer takes care of file output.
+            HDF5CheckpointWriter::Checkpoint checkpoint;
+            checkpoint.reportStep = nextStep;
+            checkpoint.newFile = saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_;
+            if (checkpoint.newFile) {
                 std::ostringstream str;
                 Parameters::printValues<TypeTag>(str);
-                writer.writeHeader("OPM Flow",
-                                   moduleVersion(),
-                                   compileTimestamp(),
-                                   ebosSimulator_.vanguard().caseName(),
-                                   str.str(),
-                                   EclGenericVanguard::comm().size());
+                checkpoint.header =
+                    HDF5CheckpointWriter::pack(std::string{"OPM Flow"},
+                                               moduleVersion(),
+                                               compileTimestamp(),
+                                               ebosSimulator_.vanguard().caseName(),
+                                               str.str(),
+                                               EclGenericVanguard::comm().size());
 
                 if (EclGenericVanguard::comm().size() > 1) {
                     const auto& cellMapping = ebosSimulator_.vanguard().globalCell();
                     std::size_t hash = Dune::hash_range(cellMapping.begin(), cellMapping.end());
-                    writer.write(hash, "/", "grid_checksum");
+                    checkpoint.gridChecksum = HDF5CheckpointWriter::pack(hash);
                 }
             }
-            writer.write(*this, groupName, "simulator_data");
-            writer.write(timer, groupName, "simulator_timer",
-                         HDF5File::DataSetMode::ROOT_ONLY);
-            OpmLog::info("Serialized state written for report step " + std::to_string(nextStep));
+            checkpoint.state = HDF5CheckpointWriter::pack(*this);
+            checkpoint.timer = HDF5CheckpointWriter::pack(timer);
+
+            checkpointWriter_->write(std::move(checkpoint));
+            OpmLog::info(std::string(checkpointWriter_->isAsync()
+                                     ? "Writing serialized state in background for report step "
+                                     : "Serialized state written for report step ")
+                         + std::to_string(nextStep));
+            if (EWOMS_GET_PARAM(TypeTag, bool, SaveStepDelta)) {
+                OpmLog::debug(fmt::format("Serialized state for report step {}: "
+                                          "{} of {} bytes stored on this process",
+                                          nextStep,
+                                          checkpointWriter_->lastStoredSize(),
+                                          checkpointWriter_->lastStateSize()));
+            }
 #endif
         }
 
@@ -749,7 +1030,7 @@ protected:
                               HDF5File::OpenMode::READ,
                               EclGenericVanguard::comm());
         const std::string groupName = "/report_step/" + std::to_string(loadStep_);
-        reader.read(*this, groupName, "simulator_data");
+        reader.readCheckpoint(*this, groupName, "simulator_data");
 
         OPM_END_PARALLEL_TRY_CATCH("Error loading serialized state: ",
                                    EclGenericVanguard::comm());
@@ -779,11 +1060,20 @@ protected:
     std::optional<ConvergenceOutputThread> convergenceOutputObject_{};
     std::optional<std::thread> convergenceOutputThread_{};
 
+    std::optional<LoadBalanceMonitor> loadBalanceMonitor_{};
+
+    std::string timingReportFile_; //!< File to write the timing report to, empty if disabled
+    bool timingReportEveryStep_ = false; //!< Write the timing report after every report step
+    bool enableMemoryReport_ = false; //!< Log the memory of the subsystems after every report step
+
     int saveStride_ = 0; //!< Stride to save serialized state at, negative to only keep last
     int saveStep_ = -1; //!< Specific step to save serialized state at
     int loadStep_ = -1; //!< Step to load serialized state from
     std::string saveFile_; //!< File to save serialized state to
     std::string loadFile_; //!< File to load serialized state from
+#if HAVE_HDF5
+    std::unique_ptr<HDF5CheckpointWriter> checkpointWriter_; //!< Writer for serialized state
+#endif
 };
 
 } // namespace Opm
@@ -91,7 +91,7 @@ public:
                                const Opm::ParallelNLDDPartitioningZoltan::GlobalCellID& local_to_global);
 
     /// Form internal connectivity graph between rank's reachable, interior
-    /// cells.
+    /// cells, with cell and connection weights if requested.
     ///
     /// \tparam GridView DUNE grid view type
     ///
@@ -199,6 +199,16 @@ void ZoltanPartitioner::buildLocalGraph(const GridView&
                                         const Opm::ZoltanPartitioningControl<Element>& zoltan_ctrl)
 {
     this->connectWells(grid_view.comm(), wells, this->connectElements(grid_view, zoltan_ctrl));
+
+    if (zoltan_ctrl.cell_weight) {
+        auto weights = std::vector<double>(grid_view.size(0), 0.0);
+        for (const auto& element : elements(grid_view, Dune::Partitions::interior)) {
+            const auto c = zoltan_ctrl.index(element);
+            weights[c] = zoltan_ctrl.cell_weight(c);
+        }
+
+        this->partitioner_.setVertexWeights(std::move(weights));
+    }
 }
 
 template <class GridView, class Element>
@@ -273,8 +283,15 @@ ZoltanPartitioner::connectElements(const GridView&
             const auto c1 = zoltan_ctrl.index(in);
             const auto c2 = zoltan_ctrl.index(out);
 
-            this->partitioner_.registerConnection(c1, c2);
-            this->partitioner_.registerConnection(c2, c1);
+            if (zoltan_ctrl.connection_weight) {
+                const auto w = zoltan_ctrl.connection_weight(c1, c2);
+                this->partitioner_.registerConnection(c1, c2, w);
+                this->partitioner_.registerConnection(c2, c1, w);
+            }
+            else {
+                this->partitioner_.registerConnection(c1, c2);
+                this->partitioner_.registerConnection(c2, c1);
+            }
         }
     }
 
@@ -658,6 +675,47 @@ Opm::partitionCellsSimple(const int num_cells, const int num_domains)
     return { part, num_domains };
 }
 
+// Cell weights for repartitioning imbalanced subdomains.
+std::vector<double>
+Opm::imbalancedDomainCellWeights(const std::vector<int>& cell_domain,
+                                 const std::vector<double>& domain_iterations,
+                                 const double threshold,
+                                 const Parallel::Communication& comm)
+{
+    const auto num_domains = domain_iterations.size();
+    std::vector<std::size_t> domain_size(num_domains, 0);
+    for (const int domain : cell_domain) {
+        if (domain >= 0) {
+            ++domain_size[domain];
+        }
+    }
+
+    // Domains without local iterations still count one iteration.
+    double max_cost = 0.0;
+    double sum_cost = 0.0;
+    for (std::size_t d = 0; d < num_domains; ++d) {
+        const double cost = (1.0 + domain_iterations[d]) * domain_size[d];
+        max_cost = std::max(max_cost, cost);
+        sum_cost += cost;
+    }
+
+    max_cost = comm.max(max_cost);
+    sum_cost = comm.sum(sum_cost);
+    const int total_domains = comm.sum(static_cast<int>(num_domains));
+    const double mean_cost = sum_cost / std::max(total_domains, 1);
+    if (mean_cost <= 0.0 || max_cost <= threshold * mean_cost) {
+        return {};
+    }
+
+    std::vector<double> weights(cell_domain.size(), 1.0);
+    for (std::size_t cell = 0; cell < cell_domain.size(); ++cell) {
+        if (cell_domain[cell] >= 0) {
+            weights[cell] = 1.0 + domain_iterations[cell_domain[cell]];
+        }
+    }
+    return weights;
+}
+
 // ===========================================================================
 
 // ---------------------------------------------------------------------------
@@ -20,6 +20,8 @@
 #ifndef OPM_ASPINPARTITION_HEADER_INCLUDED
 #define OPM_ASPINPARTITION_HEADER_INCLUDED
 
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
 #include <functional>
 #include <string>
 #include <utility>
@@ -55,6 +57,15 @@ struct ZoltanPartitioningControl
     ///
     /// of the Cartesian cell (i,j,k).
     std::function<int(int)> local_to_global;
+
+    /// Computational cost of a local cell, identified by its index().
+    /// Cells have uniform weight if not set.
+    std::function<double(int)> cell_weight;
+
+    /// Weight of connection between two local cells, identified by their
+    /// index().  The partitioning prefers cutting connections of small
+    /// weight.  Connections have uniform weight if not set.
+    std::function<double(int, int)> connection_weight;
 };
 
 /// Partition rank's interior cells.
@@ -102,6 +113,28 @@ std::pair<std::vector<int>, int> partitionCellsFromFile(const std::string& filen
 /// \return pair containing a partition vector (partition number for each cell), and the number of partitions.
 std::pair<std::vector<int>, int> partitionCellsSimple(const int num_cells, const int num_domains);
 
+/// Cell weights for repartitioning subdomains by the cost of their local solves.
+///
+/// The cost of a subdomain is its number of cells times one plus its number
+/// of local iterations.  Collective call over \p comm.
+///
+/// \param[in] cell_domain Subdomain of each cell, negative for cells not in
+///    any subdomain.
+///
+/// \param[in] domain_iterations Number of local iterations of each subdomain.
+///
+/// \param[in] threshold Repartition if the largest subdomain cost, across all
+///    processes, exceeds \p threshold times the mean subdomain cost.
+///
+/// \param[in] comm Communicator of the processes holding subdomains.
+///
+/// \return Weight of each cell, one plus the local iterations of its
+///    subdomain, or an empty vector if the subdomains are balanced.
+std::vector<double> imbalancedDomainCellWeights(const std::vector<int>& cell_domain,
+                                                const std::vector<double>& domain_iterations,
+                                                const double threshold,
+                                                const Parallel::Communication& comm);
+
 } // namespace Opm
 
 #endif // OPM_ASPINPARTITION_HEADER_INCLUDED
@@ -48,17 +48,30 @@ public:
     int currentStep();
     py::array_t<double> getCellVolumes();
     double getDT();
+    py::dict getGroupRates();
     py::array_t<double> getPorosity();
+    py::array_t<double> getPressure();
+    py::array_t<double> getPrimaryVariables();
+    py::array_t<double> getRs();
+    py::array_t<double> getRv();
+    py::array_t<double> getSaturation();
+    py::dict getWellRates();
     int run();
     void setPorosity(
          py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    void setPrimaryVariables(
+         py::array_t<double, py::array::c_style | py::array::forcecast> array,
+         py::object cells);
     int step();
     int stepCleanup();
     int stepInit();
+    void updateCells(py::object cells);
 
 private:
+    std::vector<unsigned> getCells(py::object cells, std::size_t num_cells) const;
     Opm::FlowMainEbos<TypeTag>& getFlowMainEbos() const;
     PyMaterialState<TypeTag>& getMaterialState() const;
+    py::object self();
 
     const std::string deck_filename_;
     bool has_run_init_ = false;
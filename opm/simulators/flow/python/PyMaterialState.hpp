@@ -20,6 +20,7 @@
 #ifndef OPM_PY_MATERIAL_STATE_HEADER_INCLUDED
 #define OPM_PY_MATERIAL_STATE_HEADER_INCLUDED
 
+#include <opm/material/common/MathToolbox.hpp>
 #include <opm/models/utils/propertysystem.hh>
 
 #include <exception>
@@ -40,6 +41,7 @@ namespace Opm::Pybind
         using FluidSystem = GetPropType<TypeTag, Opm::Properties::FluidSystem>;
         using Indices = GetPropType<TypeTag, Opm::Properties::Indices>;
         using GridView = GetPropType<TypeTag, Opm::Properties::GridView>;
+        using PrimaryVariables = GetPropType<TypeTag, Opm::Properties::PrimaryVariables>;
 
     public:
         PyMaterialState(Simulator *ebos_simulator)
@@ -48,7 +50,32 @@ namespace Opm::Pybind
         std::unique_ptr<double []> getCellVolumes( std::size_t *size);
         std::unique_ptr<double []> getPorosity( std::size_t *size);
         void setPorosity(const double *poro, std::size_t size);
+
+        // The primary variables of the cells are stored in place, one
+        // record of num_vars values every cell_stride bytes.
+        double* getPrimaryVariables(
+            std::size_t *num_cells, std::size_t *num_vars, std::size_t *cell_stride);
+        void setPrimaryVariables(
+            const double *values, std::size_t num_vars, const std::vector<unsigned>& cells);
+        // Recompute the intensive quantities of cells whose primary
+        // variables have been changed.
+        void updateCells(const std::vector<unsigned>& cells);
+
+        std::unique_ptr<double []> getPressure( std::size_t *size);
+        std::unique_ptr<double []> getRs( std::size_t *size);
+        std::unique_ptr<double []> getRv( std::size_t *size);
+        // One row per cell, one column per phase of the fluid system.
+        std::unique_ptr<double []> getSaturation(
+            std::size_t *num_cells, std::size_t *num_phases);
+
+        // One row per well or group, one column per active phase.
+        std::vector<double> getGroupRates(
+            std::vector<std::string> *names, std::size_t *num_phases);
+        std::vector<double> getWellRates(
+            std::vector<std::string> *names, std::size_t *num_phases);
     private:
+        void checkCells_(const std::vector<unsigned>& cells) const;
+
         Simulator *ebos_simulator_;
     };
 
@@ -19,6 +19,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace Opm::Pybind {
 
 template <class TypeTag>
@@ -35,6 +38,29 @@ getCellVolumes( std::size_t *size)
     return array;
 }
 
+template <class TypeTag>
+std::vector<double>
+PyMaterialState<TypeTag>::
+getGroupRates( std::vector<std::string> *names, std::size_t *num_phases)
+{
+    const auto& well_model = this->ebos_simulator_->problem().wellModel();
+    const auto& group_state = well_model.groupState();
+    const auto& schedule = this->ebos_simulator_->vanguard().schedule();
+    const int report_step = std::max(this->ebos_simulator_->episodeIndex(), 0);
+    *num_phases = well_model.wellState().numPhases();
+    names->clear();
+    std::vector<double> rates;
+    for (const auto& name : schedule.groupNames(report_step)) {
+        if (!group_state.has_production_rates(name)) {
+            continue;
+        }
+        const auto& group_rates = group_state.production_rates(name);
+        names->push_back(name);
+        rates.insert(rates.end(), group_rates.begin(), group_rates.end());
+    }
+    return rates;
+}
+
 template <class TypeTag>
 std::unique_ptr<double []>
 PyMaterialState<TypeTag>::
@@ -50,6 +76,112 @@ getPorosity( std::size_t *size)
     return array;
 }
 
+template <class TypeTag>
+std::unique_ptr<double []>
+PyMaterialState<TypeTag>::
+getPressure( std::size_t *size)
+{
+    Model &model = this->ebos_simulator_->model();
+    *size = model.numGridDof();
+    auto array = std::make_unique<double []>(*size);
+    for (unsigned dof_idx = 0; dof_idx < *size; ++dof_idx) {
+        const auto& fs = model.intensiveQuantities(dof_idx, /*timeIdx*/0).fluidState();
+        if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+            array[dof_idx] = getValue(fs.pressure(FluidSystem::oilPhaseIdx));
+        } else if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            array[dof_idx] = getValue(fs.pressure(FluidSystem::gasPhaseIdx));
+        } else {
+            array[dof_idx] = getValue(fs.pressure(FluidSystem::waterPhaseIdx));
+        }
+    }
+    return array;
+}
+
+template <class TypeTag>
+double*
+PyMaterialState<TypeTag>::
+getPrimaryVariables( std::size_t *num_cells, std::size_t *num_vars, std::size_t *cell_stride)
+{
+    auto& solution = this->ebos_simulator_->model().solution(/*timeIdx*/0);
+    *num_cells = this->ebos_simulator_->model().numGridDof();
+    *num_vars = PrimaryVariables::dimension;
+    *cell_stride = sizeof(PrimaryVariables);
+    return &solution[0][0];
+}
+
+template <class TypeTag>
+std::unique_ptr<double []>
+PyMaterialState<TypeTag>::
+getRs( std::size_t *size)
+{
+    Model &model = this->ebos_simulator_->model();
+    *size = model.numGridDof();
+    auto array = std::make_unique<double []>(*size);
+    if (FluidSystem::enableDissolvedGas()) {
+        for (unsigned dof_idx = 0; dof_idx < *size; ++dof_idx) {
+            const auto& fs = model.intensiveQuantities(dof_idx, /*timeIdx*/0).fluidState();
+            array[dof_idx] = getValue(fs.Rs());
+        }
+    }
+    return array;
+}
+
+template <class TypeTag>
+std::unique_ptr<double []>
+PyMaterialState<TypeTag>::
+getRv( std::size_t *size)
+{
+    Model &model = this->ebos_simulator_->model();
+    *size = model.numGridDof();
+    auto array = std::make_unique<double []>(*size);
+    if (FluidSystem::enableVaporizedOil()) {
+        for (unsigned dof_idx = 0; dof_idx < *size; ++dof_idx) {
+            const auto& fs = model.intensiveQuantities(dof_idx, /*timeIdx*/0).fluidState();
+            array[dof_idx] = getValue(fs.Rv());
+        }
+    }
+    return array;
+}
+
+template <class TypeTag>
+std::unique_ptr<double []>
+PyMaterialState<TypeTag>::
+getSaturation( std::size_t *num_cells, std::size_t *num_phases)
+{
+    Model &model = this->ebos_simulator_->model();
+    *num_cells = model.numGridDof();
+    *num_phases = FluidSystem::numPhases;
+    auto array = std::make_unique<double []>(*num_cells * FluidSystem::numPhases);
+    for (unsigned dof_idx = 0; dof_idx < *num_cells; ++dof_idx) {
+        const auto& fs = model.intensiveQuantities(dof_idx, /*timeIdx*/0).fluidState();
+        for (unsigned phase_idx = 0; phase_idx < FluidSystem::numPhases; ++phase_idx) {
+            if (FluidSystem::phaseIsActive(phase_idx)) {
+                array[dof_idx * FluidSystem::numPhases + phase_idx] =
+                    getValue(fs.saturation(phase_idx));
+            }
+        }
+    }
+    return array;
+}
+
+template <class TypeTag>
+std::vector<double>
+PyMaterialState<TypeTag>::
+getWellRates( std::vector<std::string> *names, std::size_t *num_phases)
+{
+    const auto& well_state = this->ebos_simulator_->problem().wellModel().wellState();
+    *num_phases = well_state.numPhases();
+    names->clear();
+    std::vector<double> rates;
+    rates.reserve(well_state.size() * *num_phases);
+    for (std::size_t well_index = 0; well_index < well_state.size(); ++well_index) {
+        const auto& surface_rates = well_state.well(well_index).surface_rates;
+        names->push_back(well_state.name(well_index));
+        rates.insert(rates.end(), surface_rates.begin(), surface_rates.end());
+    }
+    return rates;
+}
+
 template <class TypeTag>
 void
 PyMaterialState<TypeTag>::
@@ -68,4 +200,54 @@ setPorosity(const double *poro, std::size_t size)
         problem.setPorosity(poro[dof_idx], dof_idx);
     }
 }
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+setPrimaryVariables(const double *values, std::size_t num_vars,
+                    const std::vector<unsigned>& cells)
+{
+    if (num_vars != PrimaryVariables::dimension) {
+        const std::string msg = fmt::format(
+            "Cannot set primary variables. Expected {} values per cell, got {}",
+            PrimaryVariables::dimension, num_vars);
+        throw std::runtime_error(msg);
+    }
+    checkCells_(cells);
+    auto& solution = this->ebos_simulator_->model().solution(/*timeIdx*/0);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        for (std::size_t var_idx = 0; var_idx < num_vars; ++var_idx) {
+            solution[cells[i]][var_idx] = values[i * num_vars + var_idx];
+        }
+    }
+    updateCells(cells);
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+updateCells(const std::vector<unsigned>& cells)
+{
+    checkCells_(cells);
+    this->ebos_simulator_->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx*/0, cells);
+}
+
+// Private methods alphabetically sorted
+// ------------------------------------
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+checkCells_(const std::vector<unsigned>& cells) const
+{
+    const std::size_t model_size = this->ebos_simulator_->model().numGridDof();
+    for (const auto cell : cells) {
+        if (cell >= model_size) {
+            const std::string msg = fmt::format(
+                "Cell index {} out of range, the model has {} cells",
+                cell, model_size);
+            throw std::runtime_error(msg);
+        }
+    }
+}
 } //namespace Opm::Pybind
@@ -46,6 +46,7 @@
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 
 #include <any>
 #include <cstddef>
@@ -208,7 +209,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
 
         void initialize()
         {
-            OPM_TIMEBLOCK(IstlSolverEbos);
+            OPM_TIMEBLOCK_TREE(IstlSolverEbos);
 
             if (parameters_[0].linsolver_ == "hybrid") {
                 // Experimental hybrid configuration.
@@ -346,7 +347,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
 
         void prepare(const Matrix& M, Vector& b)
         {
-            OPM_TIMEBLOCK(istlSolverEbosPrepare);
+            OPM_TIMEBLOCK_TREE(istlSolverEbosPrepare);
 
             initPrepare(M,b);
 
@@ -379,7 +380,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
 
         bool solve(Vector& x)
         {
-            OPM_TIMEBLOCK(istlSolverEbosSolve);
+            OPM_TIMEBLOCK_TREE(istlSolverEbosSolve);
             ++solveCount_;
             // Write linear system if asked for.
             const int verbosity = prm_[activeSolverNum_].get("verbosity", 0);
@@ -394,7 +395,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             // Solve system.
             Dune::InverseOperatorResult result;
             {
-                OPM_TIMEBLOCK(flexibleSolverApply);
+                OPM_TIMEBLOCK_TREE(flexibleSolverApply);
                 assert(flexibleSolver_[activeSolverNum_].solver_);
                 flexibleSolver_[activeSolverNum_].solver_->apply(x, *rhs_, result);
             }
@@ -457,7 +458,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
 
         void prepareFlexibleSolver()
         {
-            OPM_TIMEBLOCK(flexibleSolverPrepare);
+            OPM_TIMEBLOCK_TREE(flexibleSolverPrepare);
             if (shouldCreateSolver()) {
                 std::function<Vector()> trueFunc =
                     [this]
@@ -469,7 +470,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
                     auto wellOp = std::make_unique<WellModelOperator>(simulator_.problem().wellModel());
                     flexibleSolver_[activeSolverNum_].wellOperator_ = std::move(wellOp);
                 }
-                OPM_TIMEBLOCK(flexibleSolverCreate);
+                OPM_TIMEBLOCK_TREE(flexibleSolverCreate);
                 flexibleSolver_[activeSolverNum_].create(getMatrix(),
                                                          isParallel(),
                                                          prm_[activeSolverNum_],
@@ -480,7 +481,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             }
             else
             {
-                OPM_TIMEBLOCK(flexibleSolverUpdate);
+                OPM_TIMEBLOCK_TREE(flexibleSolverUpdate);
                 flexibleSolver_[activeSolverNum_].pre_->update();
             }
         }
@@ -541,7 +542,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
         // conservation equations, ignoring all other terms.
         Vector getTrueImpesWeights(int pressureVarIndex) const
         {
-            OPM_TIMEBLOCK(getTrueImpesWeights);
+            OPM_TIMEBLOCK_TREE(getTrueImpesWeights);
             Vector weights(rhs_->size());
             ElementContext elemCtx(simulator_);
             Amg::getTrueImpesWeights(pressureVarIndex, weights,
@@ -0,0 +1,171 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REUSABLE_UMFPACK_HEADER_INCLUDED
+#define OPM_REUSABLE_UMFPACK_HEADER_INCLUDED
+
+#if HAVE_SUITESPARSE_UMFPACK
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/Exceptions.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <umfpack.h>
+
+namespace Opm
+{
+
+/// Direct solver for a block sparse matrix with a fixed sparsity pattern.
+///
+/// The symbolic analysis (fill-reducing ordering) of UMFPACK only depends
+/// on the sparsity pattern and is done once, in the constructor.  Each call
+/// to factorize() only redoes the numeric factorization, which is what
+/// Dune::UMFPack does not allow.  All matrices passed to factorize() must
+/// have the same sparsity pattern as the one passed to the constructor.
+template <class Matrix>
+class ReusableUMFPack
+{
+public:
+    using Block = typename Matrix::block_type;
+    static constexpr int bs = Block::rows;
+
+    /// Analyse the sparsity pattern of the matrix.
+    explicit ReusableUMFPack(const Matrix& A)
+        : n_(A.N() * bs)
+    {
+        static_assert(Block::rows == Block::cols, "Only square blocks are supported.");
+
+        // Count the entries of every scalar column.
+        colStart_.assign(n_ + 1, 0);
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int c = 0; c < bs; ++c) {
+                    colStart_[col.index() * bs + c + 1] += bs;
+                }
+            }
+        }
+        for (int col = 0; col < n_; ++col) {
+            colStart_[col + 1] += colStart_[col];
+        }
+
+        // Place the entries in compressed column format.  Visiting the
+        // block rows in order gives sorted row indices in every column.
+        // The position of each block entry, in the order the blocks are
+        // stored in A, is kept for copying the values in factorize().
+        const int nnz = colStart_[n_];
+        rowIndex_.resize(nnz);
+        values_.resize(nnz);
+        position_.resize(nnz);
+        std::vector<int> next(colStart_.begin(), colStart_.end() - 1);
+        std::size_t entry = 0;
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int r = 0; r < bs; ++r) {
+                    for (int c = 0; c < bs; ++c, ++entry) {
+                        const int pos = next[col.index() * bs + c]++;
+                        rowIndex_[pos] = row.index() * bs + r;
+                        position_[entry] = pos;
+                    }
+                }
+            }
+        }
+
+        umfpack_di_defaults(control_);
+        const int status = umfpack_di_symbolic(n_, n_, colStart_.data(), rowIndex_.data(),
+                                               nullptr, &symbolic_, control_, nullptr);
+        if (status != UMFPACK_OK) {
+            OPM_THROW(NumericalProblem, "UMFPACK symbolic analysis failed with status " + std::to_string(status));
+        }
+    }
+
+    ReusableUMFPack(const ReusableUMFPack&) = delete;
+    ReusableUMFPack& operator=(const ReusableUMFPack&) = delete;
+
+    ~ReusableUMFPack()
+    {
+        umfpack_di_free_numeric(&numeric_);
+        umfpack_di_free_symbolic(&symbolic_);
+    }
+
+    /// Numeric factorization of a matrix with the analysed pattern.
+    void factorize(const Matrix& A)
+    {
+        std::size_t entry = 0;
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int r = 0; r < bs; ++r) {
+                    for (int c = 0; c < bs; ++c, ++entry) {
+                        values_[position_[entry]] = (*col)[r][c];
+                    }
+                }
+            }
+        }
+
+        umfpack_di_free_numeric(&numeric_);
+        const int status = umfpack_di_numeric(colStart_.data(), rowIndex_.data(), values_.data(),
+                                              symbolic_, &numeric_, control_, nullptr);
+        if (status != UMFPACK_OK) {
+            OPM_THROW_NOLOG(NumericalProblem, "UMFPACK numeric factorization failed with status " + std::to_string(status));
+        }
+    }
+
+    /// Solve A x = b with the last factorized matrix.
+    template <class Vector>
+    void solve(Vector& x, const Vector& b)
+    {
+        rhs_.resize(n_);
+        sol_.resize(n_);
+        for (std::size_t i = 0; i < b.size(); ++i) {
+            for (int r = 0; r < bs; ++r) {
+                rhs_[i * bs + r] = b[i][r];
+            }
+        }
+
+        const int status = umfpack_di_solve(UMFPACK_A, colStart_.data(), rowIndex_.data(), values_.data(),
+                                            sol_.data(), rhs_.data(), numeric_, control_, nullptr);
+        if (status != UMFPACK_OK) {
+            OPM_THROW_NOLOG(NumericalProblem, "UMFPACK solve failed with status " + std::to_string(status));
+        }
+
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            for (int r = 0; r < bs; ++r) {
+                x[i][r] = sol_[i * bs + r];
+            }
+        }
+    }
+
+private:
+    int n_; //!< Number of scalar rows and columns
+    std::vector<int> colStart_; //!< Start of every scalar column
+    std::vector<int> rowIndex_; //!< Row index of every scalar entry
+    std::vector<double> values_; //!< Value of every scalar entry
+    std::vector<int> position_; //!< Position in values_ of every block entry in storage order of A
+    std::vector<double> rhs_; //!< Flattened right hand side
+    std::vector<double> sol_; //!< Flattened solution
+    double control_[UMFPACK_CONTROL]; //!< UMFPACK control parameters
+    void* symbolic_ = nullptr; //!< Cached symbolic analysis
+    void* numeric_ = nullptr; //!< Current numeric factorization
+};
+
+} // namespace Opm
+
+#endif // HAVE_SUITESPARSE_UMFPACK
+
+#endif // OPM_REUSABLE_UMFPACK_HEADER_INCLUDED
@@ -43,6 +43,41 @@ namespace Details
     }
 
 
+    template <class Matrix>
+    std::vector<std::size_t> subMatrixOffsets(const Matrix& A, const std::vector<int>& indices, const Matrix& B)
+    {
+        // Find the position of A_{indices[i], indices[j]} for every entry
+        // B_{i, j}, in the order B stores its entries. Positions are counted
+        // from the first entry of A, as all blocks of a BCRSMatrix are stored
+        // in a single contiguous array.
+        const auto* base = &*A.begin()->begin();
+        std::vector<std::size_t> offsets;
+        offsets.reserve(B.nonzeroes());
+        for (auto row = B.begin(); row != B.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                offsets.push_back(&A[indices[row.index()]][indices[col.index()]] - base);
+            }
+        }
+        return offsets;
+    }
+
+
+    template <class Matrix>
+    void copySubMatrix(const Matrix& A, const std::vector<std::size_t>& offsets, Matrix& B)
+    {
+        // Copy elements using positions from subMatrixOffsets(), avoiding
+        // the column search in A for every entry.
+        assert(offsets.size() == B.nonzeroes());
+        const auto* base = &*A.begin()->begin();
+        auto offset = offsets.begin();
+        for (auto row = B.begin(); row != B.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col, ++offset) {
+                *col = base[*offset];
+            }
+        }
+    }
+
+
     template <class Matrix>
     Matrix extractMatrix(const Matrix& m, const std::vector<int>& indices)
     {
@@ -393,7 +393,9 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
                 }
                 catch (const TooManyIterations& e) {
                     substepReport = solver.failureReport();
-                    causeOfFailure = "Solver convergence failure - Iteration limit reached";
+                    causeOfFailure = substepReport.aborted_substeps > 0
+                        ? "Solver convergence failure - Predicted to reach the iteration limit"
+                        : "Solver convergence failure - Iteration limit reached";
 
                     logException_(e, solverVerbose_);
                     // since linearIterations is < 0 this will restart the solver
@@ -524,8 +526,9 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
                         throw TimeSteppingBreakdown{msg};
                     }
 
-                    // The new, chopped timestep.
-                    const double newTimeStep = restartFactor_ * dt;
+                    // The new, chopped timestep. The solver may choose a
+                    // factor from the convergence rate of the failed step.
+                    const double newTimeStep = solver.retryTimeStepFactor(restartFactor_) * dt;
 
 
                     // If we have restarted (i.e. cut the timestep) too
@@ -0,0 +1,94 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+#include <opm/simulators/timestepping/ConvergenceRateModel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Opm
+{
+
+    ConvergenceRateModel::ConvergenceRateModel(const int window)
+        : window_(std::max(window, 2))
+    {
+    }
+
+    void ConvergenceRateModel::reset()
+    {
+        measures_.clear();
+    }
+
+    void ConvergenceRateModel::addIteration(const double measure)
+    {
+        // Guard the logarithm against exactly zero residuals.
+        measures_.push_back(std::max(measure, std::numeric_limits<double>::min()));
+    }
+
+    double ConvergenceRateModel::rate() const
+    {
+        const int n = std::min(iterations(), window_);
+        if (n < 2) {
+            return 1.0;
+        }
+
+        // Least squares fit of log(measure) = a + b*k over the last n iterations.
+        const int first = iterations() - n;
+        double sumK = 0.0, sumY = 0.0, sumKK = 0.0, sumKY = 0.0;
+        for (int k = 0; k < n; ++k) {
+            const double y = std::log(measures_[first + k]);
+            sumK += k;
+            sumY += y;
+            sumKK += k * k;
+            sumKY += k * y;
+        }
+        const double slope = (n * sumKY - sumK * sumY) / (n * sumKK - sumK * sumK);
+        return std::exp(slope);
+    }
+
+    double ConvergenceRateModel::remainingIterations() const
+    {
+        if (measures_.empty()) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const double last = measures_.back();
+        if (last <= 1.0) {
+            return 0.0;
+        }
+        const double rho = rate();
+        if (rho >= 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return std::log(last) / -std::log(rho);
+    }
+
+    double ConvergenceRateModel::timeStepFactor(const int targetIterations,
+                                                const double minFactor,
+                                                const double maxFactor) const
+    {
+        if (measures_.empty()) {
+            return minFactor;
+        }
+        // With r0' = f*r0 and rho' = f*rho, the retried step converges
+        // within n iterations if log(f*r0) + n*log(f*rho) <= 0.
+        const double n = std::max(targetIterations, 1);
+        const double logFactor = -(std::log(measures_.front()) + n * std::log(rate())) / (n + 1.0);
+        return std::clamp(std::exp(logFactor), minFactor, maxFactor);
+    }
+
+} // namespace Opm
@@ -0,0 +1,78 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_CONVERGENCE_RATE_MODEL_HEADER_INCLUDED
+#define OPM_CONVERGENCE_RATE_MODEL_HEADER_INCLUDED
+
+#include <vector>
+
+namespace Opm
+{
+
+    /// Model of the residual decay within the nonlinear iterations of a
+    /// time step, used to predict convergence failures before the
+    /// iteration limit is reached.
+    ///
+    /// The residual measure of an iteration is the largest residual divided
+    /// by its tolerance, so the iterations have converged once it is at
+    /// most one. The measure is assumed to decay geometrically, and the
+    /// contraction factor per iteration is fitted by least squares to the
+    /// logarithm of the most recent measures.
+    class ConvergenceRateModel
+    {
+    public:
+        /// \brief constructor
+        /// \param window  number of most recent iterations the rate is fitted to
+        explicit ConvergenceRateModel(const int window = 3);
+
+        /// Forget the iterations of the previous time step.
+        void reset();
+
+        /// Add the residual measure of the next iteration.
+        void addIteration(const double measure);
+
+        /// Number of iterations added since the last reset().
+        int iterations() const
+        { return static_cast<int>(measures_.size()); }
+
+        /// Fitted contraction factor of the residual measure per iteration,
+        /// one if fewer than two iterations have been added.
+        double rate() const;
+
+        /// Number of further iterations predicted to reach a measure of one,
+        /// infinite if the measure is not decreasing.
+        double remainingIterations() const;
+
+        /// Factor to scale the time step by such that the fitted model
+        /// predicts convergence within targetIterations iterations.
+        ///
+        /// Both the initial residual and the contraction factor are assumed
+        /// to scale linearly with the time step size.
+        /// \param targetIterations  number of iterations the retried step should need
+        /// \param minFactor         lower bound of the returned factor
+        /// \param maxFactor         upper bound of the returned factor
+        double timeStepFactor(const int targetIterations,
+                              const double minFactor,
+                              const double maxFactor) const;
+
+    private:
+        int window_;
+        std::vector<double> measures_{};
+    };
+
+} // namespace Opm
+
+#endif // OPM_CONVERGENCE_RATE_MODEL_HEADER_INCLUDED
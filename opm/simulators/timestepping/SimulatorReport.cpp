@@ -34,8 +34,8 @@ namespace Opm
     {
         return SimulatorReportSingle{1.0, 2.0, 3.0, 4.0, 5.0, 6.0,
                                      7.0, 8.0, 9.0, 10.0, 11.0,
-                                     12, 13, 14, 15, 16, 17,
-                                     true, false, 18, 19.0, 20.0};
+                                     12, 13, 14, 15, 16, 17, 18,
+                                     true, false, 19, 20.0, 21.0};
     }
 
     bool SimulatorReportSingle::operator==(const SimulatorReportSingle& rhs) const
@@ -57,6 +57,7 @@ namespace Opm
                this->total_linear_iterations == rhs.total_linear_iterations &&
                this->min_linear_iterations == rhs.min_linear_iterations &&
                this->max_linear_iterations == rhs.max_linear_iterations &&
+               this->aborted_substeps == rhs.aborted_substeps &&
                this->converged == rhs.converged &&
                this->well_group_control_changed == rhs.well_group_control_changed &&
                this->exit_status == rhs.exit_status &&
@@ -85,6 +86,7 @@ namespace Opm
             min_linear_iterations = std::min(min_linear_iterations, sr.total_linear_iterations);
         }
         max_linear_iterations = std::max(max_linear_iterations, sr.total_linear_iterations);
+        aborted_substeps += sr.aborted_substeps;
 
         // It makes no sense adding time points. Therefore, do not 
         // overwrite the value of global_time which gets set in 
@@ -206,6 +208,11 @@ namespace Opm
                             100.0*failureReport->total_linear_iterations/noZero(n));
         }
         os << std::endl;
+
+        if (failureReport && failureReport->aborted_substeps > 0) {
+            os << fmt::format("Substeps aborted early:    {:7}\n",
+                              failureReport->aborted_substeps);
+        }
     }
 
     SimulatorReport SimulatorReport::serializationTestObject()
@@ -50,6 +50,7 @@ namespace Opm
         unsigned int total_linear_iterations = 0;
         unsigned int min_linear_iterations = std::numeric_limits<unsigned int>::max();
         unsigned int max_linear_iterations = 0;
+        unsigned int aborted_substeps = 0;
 
         bool converged = false;
         bool well_group_control_changed = false;
@@ -88,6 +89,7 @@ namespace Opm
             serializer(total_linear_iterations);
             serializer(min_linear_iterations);
             serializer(max_linear_iterations);
+            serializer(aborted_substeps);
             serializer(converged);
             serializer(well_group_control_changed);
             serializer(exit_status);
@@ -24,6 +24,9 @@
 
 #if HAVE_MPI
 
+#include <opm/simulators/utils/FusedReduction.hpp>
+#include <opm/simulators/utils/gatherDeferredLogger.hpp>
+
 #include <mpi.h>
 
 namespace
@@ -211,7 +214,9 @@ namespace Opm
 
     /// Create a global convergence report combining local
     /// (per-process) reports.
-    ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report, Parallel::Communication mpi_communicator)
+    ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report,
+                                              Parallel::Communication mpi_communicator,
+                                              GatherMethod method)
     {
         // Pack local report.
         int message_size = messageSize(local_report, mpi_communicator);
@@ -220,26 +225,48 @@ namespace Opm
         packConvergenceReport(local_report, buffer, offset,mpi_communicator);
         assert(offset == message_size);
 
-        // Get message sizes and create offset/displacement array for gathering.
-        int num_processes = -1;
-        MPI_Comm_size(mpi_communicator, &num_processes);
-        std::vector<int> message_sizes(num_processes);
-        MPI_Allgather(&message_size, 1, MPI_INT, message_sizes.data(), 1, MPI_INT, mpi_communicator);
-        std::vector<int> displ(num_processes + 1, 0);
-        std::partial_sum(message_sizes.begin(), message_sizes.end(), displ.begin() + 1);
-
         // Gather.
-        std::vector<char> recv_buffer(displ.back());
-        MPI_Allgatherv(buffer.data(), buffer.size(), MPI_PACKED,
-                       const_cast<char*>(recv_buffer.data()), message_sizes.data(),
-                       displ.data(), MPI_PACKED,
-                       mpi_communicator);
+        std::vector<int> displ;
+        const auto recv_buffer = allGatherBuffers(buffer, displ, mpi_communicator, method);
 
         // Unpack.
         ConvergenceReport global_report = unpackConvergenceReports(recv_buffer, displ, mpi_communicator);
         return global_report;
     }
 
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReportAndLogger(const ConvergenceReport& local_report,
+                                     const DeferredLogger& local_deferredlogger,
+                                     Parallel::Communication mpi_communicator,
+                                     GatherMethod method)
+    {
+        const bool has_report_data = !local_report.reservoirFailures().empty() ||
+                                     !local_report.reservoirConvergence().empty() ||
+                                     !local_report.wellFailures().empty();
+        const bool has_messages = !local_deferredlogger.empty();
+
+        // Fixed size exchange.
+        FusedReduction reduction(mpi_communicator);
+        const auto time_idx = reduction.addMax(local_report.reportTime());
+        const auto report_idx = reduction.addMax(has_report_data);
+        const auto messages_idx = reduction.addMax(has_messages);
+        reduction.start();
+        reduction.finish();
+
+        // Variable size exchanges, only if needed.
+        std::pair<ConvergenceReport, DeferredLogger> result;
+        if (reduction.max(report_idx) > 0.0) {
+            result.first = gatherConvergenceReport(local_report, mpi_communicator, method);
+        } else {
+            result.first = ConvergenceReport{reduction.max(time_idx)};
+        }
+        if (reduction.max(messages_idx) > 0.0) {
+            result.second = gatherDeferredLogger(local_deferredlogger, mpi_communicator, method);
+        }
+
+        return result;
+    }
+
 } // namespace Opm
 
 #else // HAVE_MPI
@@ -247,10 +274,20 @@ namespace Opm
 namespace Opm
 {
     ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report,
-                                              Parallel::Communication mpi_communicator [[maybe_unused]])
+                                              Parallel::Communication mpi_communicator [[maybe_unused]],
+                                              GatherMethod method [[maybe_unused]])
     {
         return local_report;
     }
+
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReportAndLogger(const ConvergenceReport& local_report,
+                                     const DeferredLogger& local_deferredlogger,
+                                     Parallel::Communication mpi_communicator [[maybe_unused]],
+                                     GatherMethod method [[maybe_unused]])
+    {
+        return {local_report, local_deferredlogger};
+    }
 } // namespace Opm
 
 #endif // HAVE_MPI
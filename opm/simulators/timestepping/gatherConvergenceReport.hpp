@@ -23,14 +23,31 @@
 
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
 
+#include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
+#include <opm/simulators/utils/TwoLevelGather.hpp>
+
+#include <utility>
 
 namespace Opm
 {
 
     /// Create a global convergence report combining local
     /// (per-process) reports.
-    ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report, Parallel::Communication communicator);
+    ConvergenceReport gatherConvergenceReport(const ConvergenceReport& local_report,
+                                              Parallel::Communication communicator,
+                                              GatherMethod method = GatherMethod::Flat);
+
+    /// Create a global convergence report and a global deferred logger
+    /// combining local (per-process) reports and loggers.
+    /// A single fixed size reduction determines whether any process has
+    /// failures or messages; the variable size reports and messages are
+    /// only gathered if so.
+    std::pair<ConvergenceReport, DeferredLogger>
+    gatherConvergenceReportAndLogger(const ConvergenceReport& local_report,
+                                     const DeferredLogger& local_deferredlogger,
+                                     Parallel::Communication communicator,
+                                     GatherMethod method = GatherMethod::Flat);
 
 } // namespace Opm
 
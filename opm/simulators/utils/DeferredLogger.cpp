@@ -21,78 +21,291 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace
+{
+
+    constexpr auto noThread = std::numeric_limits<std::size_t>::max();
+
+    // Index of the buffer of the calling thread.  Outside of parallel
+    // regions there is no concurrency, and in nested parallel regions
+    // thread numbers are not unique, so no thread has its own buffer there.
+    std::size_t threadIndex()
+    {
+#if HAVE_OPENMP
+        if (omp_get_active_level() != 1) {
+            return noThread;
+        }
+        return omp_get_thread_num();
+#else
+        return noThread;
+#endif
+    }
+
+    // Number of threads of the current parallel region.
+    std::size_t numThreads()
+    {
+#if HAVE_OPENMP
+        return std::max(omp_get_num_threads(), 1);
+#else
+        return 1;
+#endif
+    }
+
+} // anonymous namespace
+
 namespace Opm
 {
 
+    DeferredLogger::DeferredLogger() = default;
+
+    DeferredLogger::DeferredLogger(const DeferredLogger& other)
+    {
+        setMessages(other.messages());
+    }
+
+    DeferredLogger::DeferredLogger(DeferredLogger&& other)
+        : buffers_(std::move(other.buffers_))
+        , shared_buffer_(std::move(other.shared_buffer_))
+        , has_buffers_(other.has_buffers_.load())
+        , next_sequence_(other.next_sequence_.load())
+    {
+        other.buffers_.clear();
+        other.shared_buffer_.clear();
+        other.has_buffers_ = false;
+        other.next_sequence_ = 0;
+    }
+
+    DeferredLogger& DeferredLogger::operator=(const DeferredLogger& other)
+    {
+        if (this != &other) {
+            setMessages(other.messages());
+        }
+        return *this;
+    }
+
+    DeferredLogger& DeferredLogger::operator=(DeferredLogger&& other)
+    {
+        if (this != &other) {
+            buffers_.swap(other.buffers_);
+            shared_buffer_.swap(other.shared_buffer_);
+            const bool has_buffers = has_buffers_.load();
+            has_buffers_ = other.has_buffers_.load();
+            other.has_buffers_ = has_buffers;
+            next_sequence_ = other.next_sequence_.load();
+            other.clearMessages();
+        }
+        return *this;
+    }
+
+    std::vector<DeferredLogger::Entry>* DeferredLogger::threadBuffer()
+    {
+        const std::size_t thread = threadIndex();
+        if (thread == noThread) {
+            return nullptr;
+        }
+
+        // The per-thread buffers are only allocated once messages are
+        // added in a parallel region, and then kept until the logger is
+        // moved from.
+        if (!has_buffers_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(shared_mutex_);
+            if (!has_buffers_.load(std::memory_order_relaxed)) {
+                buffers_.resize(std::max(buffers_.size(), numThreads()));
+                has_buffers_.store(true, std::memory_order_release);
+            }
+        }
+
+        return (thread < buffers_.size()) ? &buffers_[thread] : nullptr;
+    }
+
+    void DeferredLogger::push(Message message)
+    {
+        const std::size_t sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+        if (auto* buffer = threadBuffer()) {
+            buffer->push_back({sequence, std::move(message)});
+        }
+        else {
+            // Outside of parallel regions, in a nested parallel region, or
+            // more threads than when the buffers were allocated.
+            std::lock_guard<std::mutex> lock(shared_mutex_);
+            shared_buffer_.push_back({sequence, std::move(message)});
+        }
+    }
+
+    std::vector<DeferredLogger::Message> DeferredLogger::messages() const
+    {
+        std::vector<Entry> entries;
+        for (const auto& buffer : buffers_) {
+            entries.insert(entries.end(), buffer.begin(), buffer.end());
+        }
+        entries.insert(entries.end(), shared_buffer_.begin(), shared_buffer_.end());
+        // Messages added by a single thread are already in order.
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.sequence < b.sequence; });
+
+        std::vector<Message> result;
+        result.reserve(entries.size());
+        for (auto& entry : entries) {
+            result.push_back(std::move(entry.message));
+        }
+        return result;
+    }
+
+    void DeferredLogger::setMessages(std::vector<Message> messages)
+    {
+        clearMessages();
+        for (auto& m : messages) {
+            push(std::move(m));
+        }
+    }
+
+    bool DeferredLogger::empty() const
+    {
+        return shared_buffer_.empty() &&
+               std::all_of(buffers_.begin(), buffers_.end(),
+                           [](const auto& buffer) { return buffer.empty(); });
+    }
+
+    std::string DeferredLogger::text(const Message& message)
+    {
+        if (message.values.empty()) {
+            return message.text;
+        }
+
+        // Replace each replacement field by the next value, formatted
+        // with the field's format specification.
+        const auto& format = message.text;
+        std::string result;
+        std::size_t value = 0;
+        for (std::size_t pos = 0; pos < format.size(); ++pos) {
+            const char c = format[pos];
+            if ((c == '{' || c == '}') && pos + 1 < format.size() && format[pos + 1] == c) {
+                result += c;
+                ++pos;
+            }
+            else if (c == '{') {
+                const auto end = format.find('}', pos);
+                if (end == std::string::npos || value == message.values.size()) {
+                    result.append(format, pos, std::string::npos);
+                    break;
+                }
+                const std::string field = "{" + format.substr(pos + 1, end - pos - 1) + "}";
+                const double v = message.values[value++];
+                try {
+                    result += fmt::vformat(field, fmt::make_format_args(v));
+                }
+                catch (const fmt::format_error&) {
+                    result += fmt::format("{}", v);
+                }
+                pos = end;
+            }
+            else {
+                result += c;
+            }
+        }
+        return result;
+    }
+
+
     void DeferredLogger::info(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Info, tag, message});
+        push({Log::MessageType::Info, tag, message});
     }
     void DeferredLogger::warning(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Warning, tag, message});
+        push({Log::MessageType::Warning, tag, message});
     }
     void DeferredLogger::error(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Error, tag, message});
+        push({Log::MessageType::Error, tag, message});
     }
     void DeferredLogger::problem(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Problem, tag, message});
+        push({Log::MessageType::Problem, tag, message});
     }
     void DeferredLogger::bug(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Bug, tag, message});
+        push({Log::MessageType::Bug, tag, message});
     }
     void DeferredLogger::debug(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Debug, tag, message});
+        push({Log::MessageType::Debug, tag, message});
     }
     void DeferredLogger::note(const std::string& tag, const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Note, tag, message});
+        push({Log::MessageType::Note, tag, message});
     }
 
     void DeferredLogger::info(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Info, "", message});
+        push({Log::MessageType::Info, "", message});
     }
     void DeferredLogger::warning(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Warning, "", message});
+        push({Log::MessageType::Warning, "", message});
     }
     void DeferredLogger::error(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Error, "", message});
+        push({Log::MessageType::Error, "", message});
     }
     void DeferredLogger::problem(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Problem, "", message});
+        push({Log::MessageType::Problem, "", message});
     }
     void DeferredLogger::bug(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Bug, "", message});
+        push({Log::MessageType::Bug, "", message});
     }
     void DeferredLogger::debug(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Debug, "", message});
+        push({Log::MessageType::Debug, "", message});
     }
     void DeferredLogger::note(const std::string& message)
     {
-        messages_.push_back({Log::MessageType::Note, "", message});
+        push({Log::MessageType::Note, "", message});
+    }
+
+    void DeferredLogger::message(int64_t flag,
+                                 const std::string& tag,
+                                 const std::string& format,
+                                 std::vector<double> values)
+    {
+        push({flag, tag, format, std::move(values)});
     }
 
     void DeferredLogger::logMessages()
     {
-        for (const auto& m : messages_) {
-            OpmLog::addTaggedMessage(m.flag, m.tag, m.text);
+        for (const auto& m : messages()) {
+            OpmLog::addTaggedMessage(m.flag, m.tag, text(m));
         }
-        messages_.clear();
+        clearMessages();
     }
 
     void DeferredLogger::clearMessages()
     {
-        messages_.clear();
+        for (auto& buffer : buffers_) {
+            buffer.clear();
+        }
+        shared_buffer_.clear();
+        next_sequence_ = 0;
+    }
+
+    void DeferredLogger::append(const DeferredLogger& other)
+    {
+        for (auto& m : other.messages()) {
+            push(std::move(m));
+        }
     }
 
 } // namespace Opm
@@ -23,14 +23,28 @@
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace Opm
 {
+    enum class GatherMethod;
+
     /** This class implements a deferred logger:
      * 1) messages can be pushed back to a vector
      * 2) a call to logMessages adds the messages to OpmLog backends
+     *
+     * Messages may be added concurrently by the threads of an OpenMP
+     * parallel region.  Each thread appends to its own buffer, allocated
+     * when the first message is added in a parallel region, or to a
+     * shared buffer under a lock if it has none, and the messages are
+     * merged in the order they were added when they are logged, appended
+     * or gathered.  All other member functions must not be called
+     * concurrently.
      * */
 
 namespace ExceptionType
@@ -62,8 +76,18 @@ enum ExcEnum {
             int64_t flag;
             std::string tag;
             std::string text;
+            /// Values of a structured message.  If non-empty, text is the
+            /// fmt format of the message, e.g. "rate {:.3e}", which is only
+            /// formatted when the message is logged.
+            std::vector<double> values{};
         };
 
+        DeferredLogger();
+        DeferredLogger(const DeferredLogger& other);
+        DeferredLogger(DeferredLogger&& other);
+        DeferredLogger& operator=(const DeferredLogger& other);
+        DeferredLogger& operator=(DeferredLogger&& other);
+
         void info(const std::string& tag, const std::string& message);
         void warning(const std::string& tag, const std::string& message);
         void error(const std::string& tag, const std::string& message);
@@ -80,6 +104,16 @@ enum ExcEnum {
         void debug(const std::string& message);
         void note(const std::string& message);
 
+        /// Add a structured message with message type flag, e.g.
+        /// Log::MessageType::Warning.  Formatting the values into the
+        /// format is deferred until the message is logged, so processes
+        /// that do not log never format, and gathering the messages only
+        /// sends each distinct tag and format once per process.
+        void message(int64_t flag,
+                     const std::string& tag,
+                     const std::string& format,
+                     std::vector<double> values);
+
         /// Log all messages to the OpmLog backends,
         /// and clear the message container.
         void logMessages();
@@ -87,10 +121,44 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Append the messages of another logger, keeping their order.
+        void append(const DeferredLogger& other);
+
+        /// Return true if there are no messages.
+        bool empty() const;
+
+        /// Text of a message, formatting the values of structured messages.
+        static std::string text(const Message& message);
+
     private:
-        std::vector<Message> messages_;
+        /// Message and its position in the order of all messages.
+        struct Entry
+        {
+            std::size_t sequence;
+            Message message;
+        };
+
+        /// Buffer of the calling thread, or nullptr if it has none.
+        std::vector<Entry>* threadBuffer();
+
+        /// Add a message to the buffer of the calling thread.
+        void push(Message message);
+
+        /// All messages in the order they were added.
+        std::vector<Message> messages() const;
+
+        /// Replace all messages.
+        void setMessages(std::vector<Message> messages);
+
+        std::vector<std::vector<Entry>> buffers_; //!< One buffer per thread
+        std::vector<Entry> shared_buffer_; //!< Buffer of threads without their own
+        std::mutex shared_mutex_; //!< Protects shared_buffer_ and allocation of buffers_
+        std::atomic<bool> has_buffers_{false}; //!< Whether buffers_ is allocated
+        std::atomic<std::size_t> next_sequence_{0}; //!< Position of next message
+
         friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger,
-                                                   Parallel::Communication mpi_communicator);
+                                                   Parallel::Communication mpi_communicator,
+                                                   GatherMethod method);
     };
 
 } // namespace Opm
@@ -0,0 +1,174 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/DeltaCheckpoint.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+//! \brief FNV-1a style hash of a chunk, processing eight bytes at a time.
+std::uint64_t chunkHash(const char* data, std::size_t size)
+{
+    constexpr std::uint64_t prime = 1099511628211ull;
+    std::uint64_t hash = 14695981039346656037ull;
+
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+
+    return hash;
+}
+
+//! \brief Maximum number of bytes of the base image read at once.
+constexpr std::size_t maxBaseRead = 1 << 20;
+
+} // Anonymous namespace
+
+namespace Opm {
+
+bool DeltaCheckpoint::Delta::operator==(const Delta& rhs) const
+{
+    return this->baseStep == rhs.baseStep &&
+           this->size == rhs.size &&
+           this->chunkSize == rhs.chunkSize &&
+           this->chunks == rhs.chunks &&
+           this->data == rhs.data;
+}
+
+DeltaCheckpoint::DeltaCheckpoint(std::size_t chunkSize)
+    : chunkSize_(chunkSize)
+{
+    if (chunkSize_ == 0) {
+        throw std::invalid_argument("DeltaCheckpoint: chunk size must be positive");
+    }
+}
+
+void DeltaCheckpoint::setBase(int step, const std::vector<char>& buffer)
+{
+    baseStep_ = step;
+    baseSize_ = buffer.size();
+    hashes_.clear();
+    hashes_.reserve((buffer.size() + chunkSize_ - 1) / chunkSize_);
+    for (std::size_t begin = 0; begin < buffer.size(); begin += chunkSize_) {
+        const auto len = std::min(chunkSize_, buffer.size() - begin);
+        hashes_.push_back(chunkHash(buffer.data() + begin, len));
+    }
+}
+
+DeltaCheckpoint::Delta
+DeltaCheckpoint::computeDelta(const std::vector<char>& buffer,
+                              const BaseReader& readBase) const
+{
+    assert(hasBase());
+
+    Delta delta;
+    delta.baseStep = baseStep_;
+    delta.size = buffer.size();
+    delta.chunkSize = chunkSize_;
+
+    auto addChunk = [&buffer, &delta, this](const std::size_t i)
+    {
+        const auto begin = i * chunkSize_;
+        const auto end = std::min(begin + chunkSize_, buffer.size());
+        delta.chunks.push_back(i);
+        delta.data.insert(delta.data.end(),
+                          buffer.begin() + begin,
+                          buffer.begin() + end);
+    };
+
+    // Chunks with a hash matching the base image, waiting for confirmation.
+    std::size_t first = 0;
+    std::size_t numMatched = 0;
+    auto confirmMatched = [&]()
+    {
+        if (numMatched == 0) {
+            return;
+        }
+
+        const auto offset = first * chunkSize_;
+        const auto size = std::min(numMatched * chunkSize_, buffer.size() - offset);
+        const auto base = readBase(offset, size);
+        if (base.size() != size) {
+            throw std::runtime_error("DeltaCheckpoint: Failed to read base image");
+        }
+
+        for (std::size_t i = first; i < first + numMatched; ++i) {
+            const auto begin = i * chunkSize_ - offset;
+            const auto end = std::min(begin + chunkSize_, size);
+            if (!std::equal(base.begin() + begin, base.begin() + end,
+                            buffer.begin() + offset + begin)) {
+                addChunk(i);
+            }
+        }
+        numMatched = 0;
+    };
+
+    const auto maxMatched = std::max(maxBaseRead / chunkSize_, std::size_t{1});
+    for (std::size_t begin = 0, i = 0; begin < buffer.size(); begin += chunkSize_, ++i) {
+        const auto end = std::min(begin + chunkSize_, buffer.size());
+        const bool matched = end <= baseSize_ &&
+                             end - begin == std::min(chunkSize_, baseSize_ - begin) &&
+                             chunkHash(buffer.data() + begin, end - begin) == hashes_[i];
+        if (!matched) {
+            confirmMatched();
+            addChunk(i);
+        } else if (readBase) {
+            if (numMatched == 0) {
+                first = i;
+            }
+            if (++numMatched == maxMatched) {
+                confirmMatched();
+            }
+        }
+    }
+    confirmMatched();
+
+    return delta;
+}
+
+void DeltaCheckpoint::apply(const Delta& delta, std::vector<char>& buffer)
+{
+    buffer.resize(delta.size);
+
+    std::size_t offset = 0;
+    for (const auto chunk : delta.chunks) {
+        const auto begin = chunk * delta.chunkSize;
+        if (begin >= delta.size) {
+            throw std::runtime_error("DeltaCheckpoint: Inconsistent delta data");
+        }
+        const auto len = std::min(delta.chunkSize, delta.size - begin);
+        if (offset + len > delta.data.size()) {
+            throw std::runtime_error("DeltaCheckpoint: Inconsistent delta data");
+        }
+        std::copy_n(delta.data.begin() + offset, len, buffer.begin() + begin);
+        offset += len;
+    }
+}
+
+} // namespace Opm
@@ -0,0 +1,107 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DELTA_CHECKPOINT_HPP
+#define OPM_DELTA_CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Incremental encoding of packed state buffers.
+//!
+//! \details A buffer is split into fixed size chunks. Only a hash of each
+//! chunk of a base image is kept in memory, and later buffers are encoded
+//! as the chunks whose hash differs from the base. Chunks with matching
+//! hashes may be confirmed against the stored base image, see
+//! computeDelta(). A buffer is reconstructed by applying its delta to the
+//! base image, so restoring any step requires reading the base and a
+//! single delta.
+class DeltaCheckpoint
+{
+public:
+    //! \brief Changed chunks of a buffer relative to a base image.
+    struct Delta
+    {
+        int baseStep = -1; //!< Report step holding the base image
+        std::size_t size = 0; //!< Size of the encoded buffer
+        std::size_t chunkSize = 0; //!< Size of chunks
+        std::vector<std::size_t> chunks; //!< Indices of changed chunks
+        std::vector<char> data; //!< Contents of changed chunks
+
+        bool operator==(const Delta& rhs) const;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(baseStep);
+            serializer(size);
+            serializer(chunkSize);
+            serializer(chunks);
+            serializer(data);
+        }
+    };
+
+    //! \brief Reads a byte range of the base image.
+    //! \details Called with the offset and size of the range, returns
+    //!          the bytes of the base image in that range.
+    using BaseReader = std::function<std::vector<char>(std::size_t, std::size_t)>;
+
+    //! \brief Constructor.
+    //! \param chunkSize Size of chunks in bytes
+    explicit DeltaCheckpoint(std::size_t chunkSize);
+
+    //! \brief Set the base image subsequent deltas are computed against.
+    //! \param step Report step the base image is stored at
+    //! \param buffer Packed base image
+    void setBase(int step, const std::vector<char>& buffer);
+
+    //! \brief Returns true if a base image has been set.
+    bool hasBase() const
+    { return baseStep_ >= 0; }
+
+    //! \brief Report step of the base image.
+    int baseStep() const
+    { return baseStep_; }
+
+    //! \brief Compute the delta of a buffer relative to the base image.
+    //! \param buffer Buffer to encode
+    //! \param readBase If set, chunks with a hash matching the base image
+    //!                 are compared to the base image read through it,
+    //!                 so a hash collision cannot drop a changed chunk.
+    //!                 Consecutive matching chunks are read together.
+    Delta computeDelta(const std::vector<char>& buffer,
+                       const BaseReader& readBase = {}) const;
+
+    //! \brief Apply a delta to a base image.
+    //! \param delta Delta to apply
+    //! \param buffer Base image on input, encoded buffer on output
+    static void apply(const Delta& delta, std::vector<char>& buffer);
+
+private:
+    std::size_t chunkSize_; //!< Size of chunks in bytes
+    int baseStep_ = -1; //!< Report step of base image
+    std::size_t baseSize_ = 0; //!< Size of base image
+    std::vector<std::uint64_t> hashes_; //!< Hash of each chunk of base image
+};
+
+} // namespace Opm
+
+#endif // OPM_DELTA_CHECKPOINT_HPP
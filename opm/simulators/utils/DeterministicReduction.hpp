@@ -0,0 +1,85 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DETERMINISTIC_REDUCTION_HPP
+#define OPM_DETERMINISTIC_REDUCTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Thread-parallel reduction over the indices [0, size).
+//!
+//! \details The range is split into chunks of fixed size. Each chunk is
+//! reduced into its own partial result on one thread, and the partial
+//! results are combined in chunk order. The result therefore does not
+//! depend on the number of threads. If the body throws, the remaining
+//! indices of its chunk are skipped, and the exception of the first
+//! failing chunk is rethrown on the calling thread.
+//!
+//! \param size Number of indices
+//! \param init Initial value of each partial result and of the result
+//! \param body Called as body(index, partial) for each index
+//! \param combine Called as combine(result, partial) for each chunk in order
+//! \param chunkSize Number of indices per chunk
+template<class Result, class Body, class Combine>
+Result deterministicReduce(const std::size_t size,
+                           const Result& init,
+                           Body&& body,
+                           Combine&& combine,
+                           const std::size_t chunkSize = 1024)
+{
+    const int numChunks = (size + chunkSize - 1) / chunkSize;
+    std::vector<Result> partial(numChunks, init);
+    std::vector<std::exception_ptr> errors(numChunks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = std::min(begin + chunkSize, size);
+        try {
+            for (std::size_t idx = begin; idx < end; ++idx) {
+                body(idx, partial[chunk]);
+            }
+        } catch (...) {
+            // Exceptions must not leave the parallel region.
+            errors[chunk] = std::current_exception();
+        }
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    Result result = init;
+    for (const auto& part : partial) {
+        combine(result, part);
+    }
+
+    return result;
+}
+
+} // namespace Opm
+
+#endif // OPM_DETERMINISTIC_REDUCTION_HPP
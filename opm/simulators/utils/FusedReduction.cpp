@@ -0,0 +1,151 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/FusedReduction.hpp>
+
+#include <algorithm>
+#include <map>
+
+#if HAVE_MPI
+#include <mpi.h>
+
+namespace {
+
+//! \brief Reduction operator for a buffer holding the number of values
+//!        to sum, the values to sum, and the values to take maximum of.
+//! \details The whole buffer is a single element of a contiguous datatype,
+//!          so MPI never splits it.
+void sumAndMax(void* in, void* inout, int* len, MPI_Datatype* type)
+{
+    int bytes = 0;
+    MPI_Type_size(*type, &bytes);
+    const int size = bytes / sizeof(double);
+
+    for (int elem = 0; elem < *len; ++elem) {
+        const auto* a = static_cast<const double*>(in) + elem * size;
+        auto* b = static_cast<double*>(inout) + elem * size;
+        const int numSums = static_cast<int>(b[0]);
+        for (int i = 1; i <= numSums; ++i) {
+            b[i] += a[i];
+        }
+        for (int i = numSums + 1; i < size; ++i) {
+            b[i] = std::max(a[i], b[i]);
+        }
+    }
+}
+
+MPI_Op sumAndMaxOp()
+{
+    static MPI_Op op = [] {
+        MPI_Op result;
+        MPI_Op_create(&sumAndMax, /*commute=*/1, &result);
+        return result;
+    }();
+    return op;
+}
+
+//! \brief Contiguous datatype of a given number of doubles.
+//! \details Datatypes are committed on first use of a size and kept until
+//!          MPI_Finalize(). Callers use few distinct sizes, such as the
+//!          number of equations, so this avoids a commit per reduction.
+MPI_Datatype contiguousType(const int size)
+{
+    static std::map<int, MPI_Datatype> types;
+    auto it = types.find(size);
+    if (it == types.end()) {
+        MPI_Datatype type;
+        MPI_Type_contiguous(size, MPI_DOUBLE, &type);
+        MPI_Type_commit(&type);
+        it = types.emplace(size, type).first;
+    }
+    return it->second;
+}
+
+} // Anonymous namespace
+#endif // HAVE_MPI
+
+namespace Opm {
+
+struct FusedReduction::Request
+{
+#if HAVE_MPI
+    MPI_Request request = MPI_REQUEST_NULL;
+#endif
+};
+
+FusedReduction::FusedReduction(Parallel::Communication comm)
+    : comm_(comm)
+{
+}
+
+FusedReduction::~FusedReduction()
+{
+    if (request_) {
+        this->finish();
+    }
+}
+
+std::size_t FusedReduction::addSum(double value)
+{
+    sums_.push_back(value);
+    return sums_.size() - 1;
+}
+
+std::size_t FusedReduction::addMax(double value)
+{
+    maxs_.push_back(value);
+    return maxs_.size() - 1;
+}
+
+void FusedReduction::start()
+{
+    if (comm_.size() == 1) {
+        return;
+    }
+
+#if HAVE_MPI
+    buffer_.clear();
+    buffer_.reserve(1 + sums_.size() + maxs_.size());
+    buffer_.push_back(sums_.size());
+    buffer_.insert(buffer_.end(), sums_.begin(), sums_.end());
+    buffer_.insert(buffer_.end(), maxs_.begin(), maxs_.end());
+
+    request_ = std::make_unique<Request>();
+    MPI_Iallreduce(MPI_IN_PLACE, buffer_.data(), 1, contiguousType(buffer_.size()),
+                   sumAndMaxOp(), comm_, &request_->request);
+#endif
+}
+
+void FusedReduction::finish()
+{
+    if (!request_) {
+        return;
+    }
+
+#if HAVE_MPI
+    MPI_Wait(&request_->request, MPI_STATUS_IGNORE);
+
+    const auto sumsEnd = buffer_.begin() + 1 + sums_.size();
+    std::copy(buffer_.begin() + 1, sumsEnd, sums_.begin());
+    std::copy(sumsEnd, buffer_.end(), maxs_.begin());
+#endif
+
+    request_.reset();
+}
+
+} // namespace Opm
@@ -0,0 +1,84 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FUSED_REDUCTION_HPP
+#define OPM_FUSED_REDUCTION_HPP
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Global sums and maxima of several values in a single collective.
+//!
+//! \details Values are registered with addSum() and addMax(). The reduction
+//! is started with start(), which does not block, and completed with
+//! finish(). Local work that does not depend on the result may be done in
+//! between. The reduced values are then available from sum() and max().
+//! The convergence checks of the simulator currently have no such work and
+//! call finish() right after start(), so they only gain from the fusion.
+class FusedReduction
+{
+public:
+    //! \brief Constructor.
+    //! \param comm Communicator to reduce over
+    explicit FusedReduction(Parallel::Communication comm);
+
+    //! \brief Destructor completes a pending reduction.
+    ~FusedReduction();
+
+    FusedReduction(const FusedReduction&) = delete;
+    FusedReduction& operator=(const FusedReduction&) = delete;
+
+    //! \brief Add a value to be summed over all processes.
+    //! \return Index of value for sum()
+    std::size_t addSum(double value);
+
+    //! \brief Add a value to take the maximum of over all processes.
+    //! \return Index of value for max()
+    std::size_t addMax(double value);
+
+    //! \brief Start the reduction.
+    void start();
+
+    //! \brief Wait for the reduction to complete.
+    void finish();
+
+    //! \brief Global sum of a value, valid after finish().
+    double sum(std::size_t idx) const
+    { return sums_[idx]; }
+
+    //! \brief Global maximum of a value, valid after finish().
+    double max(std::size_t idx) const
+    { return maxs_[idx]; }
+
+private:
+    struct Request;
+
+    Parallel::Communication comm_; //!< Communicator to reduce over
+    std::vector<double> sums_; //!< Values to sum
+    std::vector<double> maxs_; //!< Values to take maximum of
+    std::vector<double> buffer_; //!< Communication buffer
+    std::unique_ptr<Request> request_; //!< Pending reduction, if any
+};
+
+} // namespace Opm
+
+#endif // OPM_FUSED_REDUCTION_HPP
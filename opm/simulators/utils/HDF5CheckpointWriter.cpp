@@ -0,0 +1,261 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/HDF5CheckpointWriter.hpp>
+
+#include <opm/models/parallel/tasklets.hh>
+
+#include <opm/simulators/utils/HDF5File.hpp>
+
+#include <hdf5.h>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+//! \brief Returns true if HDF5 output may run concurrently with the
+//!        communication of the simulator.
+bool asyncWriteSupported([[maybe_unused]] const Opm::Parallel::Communication& comm)
+{
+    // Other output (e.g. parallel cell data) calls HDF5 from the main
+    // thread while a checkpoint is being written.
+    hbool_t threadSafe = 0;
+    if (H5is_library_threadsafe(&threadSafe) < 0 || !threadSafe) {
+        return false;
+    }
+
+    // Serial HDF5File writes do not communicate.
+    if (comm.size() == 1) {
+        return true;
+    }
+
+#if HAVE_MPI
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    return provided == MPI_THREAD_MULTIPLE;
+#else
+    return true;
+#endif
+}
+
+} // Anonymous namespace
+
+namespace Opm {
+
+class HDF5CheckpointWriter::WriteTasklet : public TaskletInterface
+{
+public:
+    WriteTasklet(HDF5CheckpointWriter& writer, Checkpoint&& checkpoint)
+        : writer_(writer)
+        , checkpoint_(std::move(checkpoint))
+    {}
+
+    void run() override
+    {
+        try {
+            writer_.writeCheckpoint(checkpoint_);
+        } catch (const std::exception& e) {
+            writer_.error_ = e.what();
+        } catch (...) {
+            writer_.error_ = "Unknown error";
+        }
+    }
+
+private:
+    HDF5CheckpointWriter& writer_;
+    Checkpoint checkpoint_;
+};
+
+HDF5CheckpointWriter::
+HDF5CheckpointWriter(const std::string& fileName,
+                     Parallel::Communication comm,
+                     const Options& options)
+    : fileName_(fileName)
+    , comm_(comm)
+    , ioComm_(comm)
+    , options_(options)
+    , async_(options.async && asyncWriteSupported(comm))
+{
+#if HAVE_MPI
+    // Collective file output on the writer thread must not interleave
+    // with collectives on the simulator communicator.
+    if (async_ && comm.size() > 1) {
+        MPI_Comm_dup(comm, &dupComm_);
+        ioComm_ = Parallel::Communication(dupComm_);
+    }
+#endif
+    taskletRunner_ = std::make_unique<TaskletRunner>(async_ ? 1 : 0);
+    if (options_.deltaChunkSize > 0) {
+        delta_.emplace(options_.deltaChunkSize);
+    }
+}
+
+HDF5CheckpointWriter::~HDF5CheckpointWriter()
+{
+    taskletRunner_->barrier();
+#if HAVE_MPI
+    if (dupComm_ != MPI_COMM_NULL) {
+        MPI_Comm_free(&dupComm_);
+    }
+#endif
+}
+
+void HDF5CheckpointWriter::write(Checkpoint&& checkpoint)
+{
+    // Make sure the previous checkpoint has been written, so that
+    // at most two packed checkpoints are kept in memory.
+    this->wait();
+
+    lastStateSize_ = checkpoint.state.size();
+    if (delta_) {
+        this->encodeDelta(checkpoint);
+    }
+    lastStoredSize_ = checkpoint.state.size();
+
+    taskletRunner_->dispatch(std::make_shared<WriteTasklet>(*this, std::move(checkpoint)));
+
+    if (!async_) {
+        this->wait();
+    }
+}
+
+void HDF5CheckpointWriter::wait()
+{
+    taskletRunner_->barrier();
+
+    // All processes must throw, otherwise the others hang in the next
+    // collective call.
+    const bool failed = comm_.max(static_cast<int>(!error_.empty())) > 0;
+    if (failed) {
+        const std::string msg = error_.empty() ? std::string{"Failed on another process"}
+                                               : std::move(error_);
+        error_.clear();
+        throw std::runtime_error("Error writing serialized state: " + msg);
+    }
+}
+
+void HDF5CheckpointWriter::encodeDelta(Checkpoint& checkpoint)
+{
+    bool full = checkpoint.newFile || !delta_->hasBase();
+    DeltaCheckpoint::Delta delta;
+    if (!full) {
+        // Only chunk hashes of the base image are kept in memory, matching
+        // chunks are confirmed against the base image in the file.  The
+        // previous checkpoint has been written at this point.
+        try {
+            HDF5File file(fileName_, HDF5File::OpenMode::READ, comm_);
+            const std::string baseGroup = "/report_step/" + std::to_string(delta_->baseStep());
+            delta = delta_->computeDelta(checkpoint.state,
+                                         [&file, &baseGroup](const std::size_t offset,
+                                                             const std::size_t size)
+                                         {
+                                             std::vector<char> base;
+                                             file.readRange(baseGroup, "simulator_data",
+                                                            offset, size, base);
+                                             return base;
+                                         });
+            // Start a new base image once the delta gets large.
+            full = 2 * delta.data.size() > checkpoint.state.size();
+        } catch (const std::exception&) {
+            // Base image not readable, store a new one.
+            full = true;
+        }
+    }
+
+    // Base and delta steps are stored in different data sets,
+    // so all processes must make the same choice.
+    full = comm_.max(static_cast<int>(full)) > 0;
+
+    if (full) {
+        delta_->setBase(checkpoint.reportStep, checkpoint.state);
+    } else {
+        checkpoint.baseStep = delta.baseStep;
+        checkpoint.state = pack(delta);
+    }
+}
+
+void HDF5CheckpointWriter::writeCheckpoint(const Checkpoint& checkpoint)
+{
+    HDF5File file(fileName_,
+                  checkpoint.newFile ? HDF5File::OpenMode::OVERWRITE
+                                     : HDF5File::OpenMode::APPEND,
+                  ioComm_, options_.stepsToKeep > 0);
+    file.setCompression(options_.compression, options_.chunkSize);
+
+    if (checkpoint.newFile) {
+        file.write("/", "simulator_info", checkpoint.header,
+                   HDF5File::DataSetMode::ROOT_ONLY);
+        if (!checkpoint.gridChecksum.empty()) {
+            file.write("/", "grid_checksum", checkpoint.gridChecksum);
+        }
+    }
+
+    const std::string groupName = "/report_step/" + std::to_string(checkpoint.reportStep);
+    if (checkpoint.baseStep < 0) {
+        file.write(groupName, "simulator_data", checkpoint.state);
+    } else {
+        file.write(groupName, "simulator_data_delta", checkpoint.state);
+        file.write(groupName, "base_step", pack(checkpoint.baseStep),
+                   HDF5File::DataSetMode::ROOT_ONLY);
+    }
+    file.write(groupName, "simulator_timer", checkpoint.timer,
+               HDF5File::DataSetMode::ROOT_ONLY);
+
+    if (options_.stepsToKeep > 0) {
+        const auto entries = file.list("/report_step");
+        std::vector<int> steps(entries.size());
+        std::transform(entries.begin(), entries.end(), steps.begin(),
+                       [](const std::string& input)
+                       {
+                           return std::atoi(input.c_str());
+                       });
+        std::sort(steps.begin(), steps.end());
+
+        const auto numRemove = std::max(static_cast<int>(steps.size()) - options_.stepsToKeep, 0);
+
+        // Base images of kept delta steps must be kept as well.
+        std::set<int> needed(steps.begin() + numRemove, steps.end());
+        for (auto it = steps.begin() + numRemove; it != steps.end(); ++it) {
+            const std::string group = "/report_step/" + std::to_string(*it);
+            const auto groupEntries = file.list(group);
+            if (std::find(groupEntries.begin(), groupEntries.end(), "base_step") != groupEntries.end()) {
+                std::vector<char> buffer;
+                file.read(group, "base_step", buffer, HDF5File::DataSetMode::ROOT_ONLY);
+                int baseStep = -1;
+                unpack(std::move(buffer), baseStep);
+                needed.insert(baseStep);
+            }
+        }
+
+        for (int i = 0; i < numRemove; ++i) {
+            if (needed.count(steps[i]) == 0) {
+                file.remove("/report_step/" + std::to_string(steps[i]));
+            }
+        }
+    }
+}
+
+} // namespace Opm
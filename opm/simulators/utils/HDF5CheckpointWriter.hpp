@@ -0,0 +1,175 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HDF5_CHECKPOINT_WRITER_HPP
+#define OPM_HDF5_CHECKPOINT_WRITER_HPP
+
+#include <opm/common/utility/Serializer.hpp>
+
+#include <opm/simulators/utils/DeltaCheckpoint.hpp>
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+#include <opm/simulators/utils/SerializationPackers.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+class TaskletRunner;
+
+//! \brief Writes serialized simulator state (.OPMRST) checkpoints.
+//!
+//! \details The state is packed into memory buffers on the calling thread.
+//! The buffers are then handed to a background thread which writes them
+//! to the HDF5 file, while the simulation continues. At most one
+//! checkpoint is pending while the next one is packed (double buffering).
+//! The background thread is only used if HDF5 is threadsafe, and in
+//! parallel runs if MPI supports MPI_THREAD_MULTIPLE. It then writes
+//! using a private duplicate of the communicator.
+//!
+//! The file layout is identical to the one written by HDF5Serializer, so
+//! checkpoints can be loaded with HDF5Serializer as before. If delta
+//! checkpoints are enabled, steps after the first one may instead store
+//! only the changed chunks of the packed state relative to a base step,
+//! in the \c simulator_data_delta data set. Such steps are loaded with
+//! HDF5Serializer::readCheckpoint().
+class HDF5CheckpointWriter
+{
+public:
+    //! \brief Options controlling checkpoint output.
+    struct Options
+    {
+        int compression = 1; //!< Deflate level, 0 disables compression
+        std::size_t chunkSize = 0; //!< Maximum chunk size in bytes, 0 for single chunk
+        int stepsToKeep = 0; //!< Number of report steps kept in file, 0 for all
+        bool async = true; //!< Write checkpoints on a separate thread if possible
+        std::size_t deltaChunkSize = 0; //!< Chunk size for delta checkpoints, 0 to disable
+    };
+
+    //! \brief Packed checkpoint data.
+    struct Checkpoint
+    {
+        int reportStep = 0; //!< Report step of checkpoint
+        bool newFile = false; //!< True to truncate file before writing
+        std::vector<char> header; //!< Packed header, written if newFile is true
+        std::vector<char> gridChecksum; //!< Packed grid checksum, written if not empty
+        std::vector<char> state; //!< Packed simulator state
+        std::vector<char> timer; //!< Packed simulator timer
+        int baseStep = -1; //!< Base step if state holds a packed delta
+    };
+
+    //! \brief Constructor.
+    //! \param fileName Name of file to write checkpoints to
+    //! \param comm Communicator for all processes writing
+    //! \param options Output options
+    HDF5CheckpointWriter(const std::string& fileName,
+                         Parallel::Communication comm,
+                         const Options& options);
+
+    //! \brief Destructor waits for pending writes.
+    ~HDF5CheckpointWriter();
+
+    //! \brief Pack data into a memory buffer.
+    template<class... Args>
+    static std::vector<char> pack(const Args&... data)
+    {
+        BufferSerializer ser;
+        ser.pack(data...);
+        return ser.buffer();
+    }
+
+    //! \brief Queue a checkpoint for writing.
+    //! \details Collective. Waits for a previous pending checkpoint to
+    //!          finish first. Throws if the previous write failed.
+    void write(Checkpoint&& checkpoint);
+
+    //! \brief Wait until all pending checkpoints have been written.
+    //! \details Collective. Throws on all processes if a write failed
+    //!          on any of them.
+    void wait();
+
+    //! \brief Returns true if checkpoints are written on a separate thread.
+    bool isAsync() const
+    { return async_; }
+
+    //! \brief Size of the packed state of the last checkpoint on this process.
+    std::size_t lastStateSize() const
+    { return lastStateSize_; }
+
+    //! \brief Number of bytes of state stored for the last checkpoint on this process.
+    std::size_t lastStoredSize() const
+    { return lastStoredSize_; }
+
+    //! \brief Unpack data from a memory buffer.
+    template<class... Args>
+    static void unpack(std::vector<char> buffer, Args&... data)
+    {
+        BufferSerializer ser;
+        ser.setBuffer(std::move(buffer));
+        ser.unpack(data...);
+    }
+
+private:
+    //! \brief Serializer packing to a memory buffer.
+    class BufferSerializer : public Serializer<Serialization::MemPacker>
+    {
+    public:
+        BufferSerializer()
+            : Serializer<Serialization::MemPacker>(m_packer_priv)
+        {}
+
+        std::vector<char> buffer()
+        { return std::move(m_buffer); }
+
+        void setBuffer(std::vector<char> buffer)
+        { m_buffer = std::move(buffer); }
+
+    private:
+        const Serialization::MemPacker m_packer_priv{};
+    };
+
+    class WriteTasklet;
+
+    //! \brief Replace state by a delta to the base image if worthwhile.
+    //! \details Collective, all processes agree on storing a delta.
+    void encodeDelta(Checkpoint& checkpoint);
+
+    //! \brief Write a checkpoint to file.
+    void writeCheckpoint(const Checkpoint& checkpoint);
+
+    std::string fileName_; //!< Name of checkpoint file
+    Parallel::Communication comm_; //!< Communicator for writing processes
+    Parallel::Communication ioComm_; //!< Communicator used for file output
+#if HAVE_MPI
+    MPI_Comm dupComm_ = MPI_COMM_NULL; //!< Private duplicate of comm_ for the writer thread
+#endif
+    Options options_; //!< Output options
+    bool async_ = false; //!< True if writing on a separate thread
+    std::unique_ptr<TaskletRunner> taskletRunner_; //!< Runs write tasklets
+    std::string error_; //!< Error message from failed background write
+    std::optional<DeltaCheckpoint> delta_; //!< Delta encoder, if enabled
+    std::size_t lastStateSize_ = 0; //!< Size of last packed state
+    std::size_t lastStoredSize_ = 0; //!< Bytes of state stored for last checkpoint
+};
+
+} // namespace Opm
+
+#endif // OPM_HDF5_CHECKPOINT_WRITER_HPP
@@ -26,6 +26,7 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <filesystem>
@@ -52,7 +53,8 @@ namespace Opm {
 
 HDF5File::HDF5File(const std::string& fileName,
                    OpenMode mode,
-                   Parallel::Communication comm)
+                   Parallel::Communication comm,
+                   [[maybe_unused]] bool trackFreeSpace)
     : comm_(comm)
 {
     bool exists = std::filesystem::exists(fileName);
@@ -69,9 +71,19 @@ HDF5File::HDF5File(const std::string& fileName,
 
     if (mode == OpenMode::OVERWRITE ||
         (mode == OpenMode::APPEND && !exists)) {
+        hid_t create_tpl = H5P_DEFAULT;
+#if H5_VERSION_GE(1,10,1)
+        if (trackFreeSpace && comm_.size() == 1) {
+            create_tpl = H5Pcreate(H5P_FILE_CREATE);
+            H5Pset_file_space_strategy(create_tpl, H5F_FSPACE_STRATEGY_FSM_AGGR, 1, 1);
+        }
+#endif
         m_file = H5Fcreate(fileName.c_str(),
                            H5F_ACC_TRUNC,
-                           H5P_DEFAULT, acc_tpl);
+                           create_tpl, acc_tpl);
+        if (create_tpl != H5P_DEFAULT) {
+            H5Pclose(create_tpl);
+        }
     } else {
         m_file = H5Fopen(fileName.c_str(),
                          mode == OpenMode::READ ? H5F_ACC_RDONLY : H5F_ACC_RDWR,
@@ -101,7 +113,6 @@ void HDF5File::write(const std::string& group,
                      const std::vector<char>& buffer,
                      DataSetMode mode) const
 {
-    hid_t grp = H5I_INVALID_HID;
     std::string realGroup = group;
     if (mode == DataSetMode::PROCESS_SPLIT) {
         if (group != "/")
@@ -109,8 +120,25 @@ void HDF5File::write(const std::string& group,
         realGroup += dset;
     }
 
+    // Serial writes do not need any communication. This allows
+    // writing from a separate thread without MPI thread support.
+    if (comm_.size() == 1) {
+        writeImpl(group, realGroup, dset, buffer, mode);
+        return;
+    }
+
     OPM_BEGIN_PARALLEL_TRY_CATCH();
+    writeImpl(group, realGroup, dset, buffer, mode);
+    OPM_END_PARALLEL_TRY_CATCH("HDF5File: Error writing data: ", comm_);
+}
 
+void HDF5File::writeImpl(const std::string& group,
+                         const std::string& realGroup,
+                         const std::string& dset,
+                         const std::vector<char>& buffer,
+                         DataSetMode mode) const
+{
+    hid_t grp = H5I_INVALID_HID;
     if (groupExists(m_file, realGroup)) {
         grp = H5Gopen2(m_file, realGroup.c_str(), H5P_DEFAULT);
     } else {
@@ -147,8 +175,6 @@ void HDF5File::write(const std::string& group,
         writeRootOnly(grp, buffer, group, dset);
     }
     H5Gclose(grp);
-
-    OPM_END_PARALLEL_TRY_CATCH("HDF5File: Error writing data: ", comm_);
 }
 
 void HDF5File::read(const std::string& group,
@@ -172,6 +198,39 @@ void HDF5File::read(const std::string& group,
     H5Dclose(dataset_id);
 }
 
+void HDF5File::readRange(const std::string& group,
+                         const std::string& dset,
+                         hsize_t offset,
+                         hsize_t size,
+                         std::vector<char>& buffer) const
+{
+    const std::string realSet = group + '/' + dset + '/' + std::to_string(comm_.rank());
+    hid_t dataset_id = H5Dopen2(m_file, realSet.c_str(), H5P_DEFAULT);
+    if (dataset_id == H5I_INVALID_HID) {
+        throw std::runtime_error("Trying to read non-existing dataset " + group + '/' + dset);
+    }
+
+    hid_t space = H5Dget_space(dataset_id);
+    if (offset + size > static_cast<hsize_t>(H5Sget_simple_extent_npoints(space))) {
+        H5Sclose(space);
+        H5Dclose(dataset_id);
+        throw std::runtime_error("Trying to read beyond end of dataset " + group + '/' + dset);
+    }
+
+    buffer.resize(size);
+    hid_t memspace = H5Screate_simple(1, &size, nullptr);
+    H5Sselect_hyperslab(space, H5S_SELECT_SET, &offset, nullptr, &size, nullptr);
+    const auto status = H5Dread(dataset_id, H5T_NATIVE_CHAR, memspace, space,
+                                H5P_DEFAULT, buffer.data());
+    H5Sclose(memspace);
+    H5Sclose(space);
+    H5Dclose(dataset_id);
+
+    if (status < 0) {
+        throw std::runtime_error("Failure while reading dataset " + group + '/' + dset);
+    }
+}
+
 std::vector<std::string> HDF5File::list(const std::string& group) const
 {
     // Lambda function pushing the group entries to a vector
@@ -193,6 +252,19 @@ std::vector<std::string> HDF5File::list(const std::string& group) const
     return result;
 }
 
+void HDF5File::remove(const std::string& path) const
+{
+    if (H5Ldelete(m_file, path.c_str(), H5P_DEFAULT) < 0) {
+        throw std::runtime_error("Failure while removing '" + path + "'");
+    }
+}
+
+void HDF5File::setCompression(int level, hsize_t chunkSize)
+{
+    compressionLevel_ = level;
+    chunkSize_ = chunkSize;
+}
+
 void HDF5File::writeSplit(hid_t grp,
                           const std::vector<char>& buffer,
                           const std::string& dset) const
@@ -246,7 +318,9 @@ void HDF5File::writeRootOnly(hid_t grp,
                              const std::string& dset) const
 {
     hsize_t size = buffer.size();
-    comm_.broadcast(&size, 1, 0);
+    if (comm_.size() > 1) {
+        comm_.broadcast(&size, 1, 0);
+    }
     hid_t space = H5Screate_simple(1, &size, nullptr);
     hid_t dcpl = this->getCompression(size);
     hid_t dxpl = H5P_DEFAULT;
@@ -281,10 +355,11 @@ hid_t HDF5File::getCompression([[maybe_unused]] hsize_t size) const
 {
     hid_t dcpl = H5P_DEFAULT;
 #if H5_VERS_MINOR > 8
-    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+    if (compressionLevel_ > 0 && size > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+        const hsize_t chunk = chunkSize_ > 0 ? std::min(chunkSize_, size) : size;
         dcpl = H5Pcreate(H5P_DATASET_CREATE);
-        H5Pset_deflate(dcpl, 1);
-        H5Pset_chunk(dcpl, 1, &size);
+        H5Pset_deflate(dcpl, compressionLevel_);
+        H5Pset_chunk(dcpl, 1, &chunk);
     }
 #endif
     return dcpl;
@@ -49,9 +49,13 @@ public:
     //! \brief Opens HDF5 file for I/O.
     //! \param fileName Name of file to open
     //! \param mode Open mode for file
+    //! \param trackFreeSpace If true, space freed by remove() is tracked in
+    //!                       newly created files and reused by later writes.
+    //!                       Only effective in serial runs.
     HDF5File(const std::string& fileName,
              OpenMode mode,
-             Parallel::Communication comm);
+             Parallel::Communication comm,
+             bool trackFreeSpace = false);
 
     //! \brief Destructor clears up any opened files.
     ~HDF5File();
@@ -76,11 +80,46 @@ public:
               std::vector<char>& buffer,
               DataSetMode Mode = DataSetMode::PROCESS_SPLIT) const;
 
+    //! \brief Read a byte range of the data set of this process.
+    //! \param group Group ("directory") to read data from
+    //! \param dset Data set ("file") written with DataSetMode::PROCESS_SPLIT
+    //! \param offset Offset of first byte to read
+    //! \param size Number of bytes to read
+    //! \param buffer Vector to store read data in
+    //! \details Throws exception on failure. Not collective.
+    void readRange(const std::string& group,
+                   const std::string& dset,
+                   hsize_t offset,
+                   hsize_t size,
+                   std::vector<char>& buffer) const;
+
     //! \brief Lists the entries in a given group.
     //! \details Note: Both datasets and subgroups are returned
     std::vector<std::string> list(const std::string& group) const;
 
+    //! \brief Removes a group or dataset from the file.
+    //! \details Throws exception on failure
+    void remove(const std::string& path) const;
+
+    //! \brief Set compression used for datasets written after this call.
+    //! \param level Deflate compression level, 0 disables compression
+    //! \param chunkSize Maximum size of a chunk in bytes, 0 to use a
+    //!                  single chunk for the whole dataset
+    void setCompression(int level, hsize_t chunkSize = 0);
+
 private:
+    //! \brief Create groups and write a dataset.
+    //! \param group Group name as given by the user
+    //! \param realGroup Group to create the dataset in
+    //! \param dset Name of dataset
+    //! \param buffer Data to write
+    //! \param mode Dataset mode
+    void writeImpl(const std::string& group,
+                   const std::string& realGroup,
+                   const std::string& dset,
+                   const std::vector<char>& buffer,
+                   DataSetMode mode) const;
+
     //! \brief Write data from each process to a separate dataset.
     //! \param grp Handle for group to store dataset in
     //! \param buffer Data to write
@@ -112,6 +151,8 @@ private:
                    hid_t dxpl, hsize_t size, const void* data) const;
     hid_t m_file = H5I_INVALID_HID; //!< File handle
     Parallel::Communication comm_;
+    int compressionLevel_ = 1; //!< Deflate level, 0 for no compression
+    hsize_t chunkSize_ = 0; //!< Maximum chunk size, 0 for single chunk
 };
 
 }
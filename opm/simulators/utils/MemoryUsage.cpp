@@ -0,0 +1,124 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/MemoryUsage.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include <fmt/format.h>
+
+namespace {
+
+//! \brief Value of a "<key>: <value> kB" line of /proc/self/status in bytes.
+std::size_t statusBytes(const std::string& line, const std::string& key)
+{
+    if (line.compare(0, key.size(), key) != 0) {
+        return 0;
+    }
+    std::istringstream value(line.substr(key.size()));
+    std::size_t kiB = 0;
+    value >> kiB;
+    return kiB * 1024;
+}
+
+} // Anonymous namespace
+
+namespace Opm {
+
+ProcessMemory processMemory()
+{
+    ProcessMemory result;
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (const auto rss = statusBytes(line, "VmRSS:"); rss > 0) {
+            result.resident = rss;
+        }
+        else if (const auto hwm = statusBytes(line, "VmHWM:"); hwm > 0) {
+            result.peak = hwm;
+        }
+    }
+    return result;
+}
+
+void MemoryReport::add(const std::string& subsystem, const std::size_t bytes)
+{
+    entries_.emplace_back(subsystem, bytes);
+}
+
+std::size_t MemoryReport::total() const
+{
+    std::size_t bytes = 0;
+    for (const auto& entry : entries_) {
+        bytes += entry.second;
+    }
+    return bytes;
+}
+
+std::string MemoryReport::table(Parallel::Communication comm,
+                                const std::string& title) const
+{
+    const auto process = processMemory();
+    auto names = std::vector<std::string>{};
+    auto minVal = std::vector<double>{};
+    for (const auto& [name, bytes] : entries_) {
+        names.push_back(name);
+        minVal.push_back(static_cast<double>(bytes));
+    }
+    names.insert(names.end(), { "Total of subsystems",
+                                "Process resident", "Process peak resident" });
+    minVal.insert(minVal.end(), { static_cast<double>(this->total()),
+                                  static_cast<double>(process.resident),
+                                  static_cast<double>(process.peak) });
+
+    const auto local = minVal;
+    auto maxVal = minVal;
+    auto sumVal = minVal;
+    comm.min(minVal.data(), minVal.size());
+    comm.max(maxVal.data(), maxVal.size());
+    comm.sum(sumVal.data(), sumVal.size());
+
+    // Lowest rank holding the maximum.
+    auto maxRank = std::vector<int>(names.size(), comm.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (local[i] == maxVal[i]) {
+            maxRank[i] = comm.rank();
+        }
+    }
+    comm.min(maxRank.data(), maxRank.size());
+
+    if (comm.rank() != 0) {
+        return {};
+    }
+
+    constexpr double MiB = 1024.0 * 1024.0;
+    std::string out = fmt::format("{} ({} processes)\n"
+                                  "{:<32}{:>12}{:>12}{:>12}{:>10}\n",
+                                  title, comm.size(),
+                                  "Subsystem [MiB]", "min", "mean", "max", "max rank");
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        out += fmt::format("{:<32}{:>12.1f}{:>12.1f}{:>12.1f}{:>10}\n",
+                           names[i], minVal[i] / MiB,
+                           sumVal[i] / comm.size() / MiB,
+                           maxVal[i] / MiB, maxRank[i]);
+    }
+    return out;
+}
+
+} // namespace Opm
@@ -0,0 +1,187 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MEMORY_USAGE_HPP
+#define OPM_MEMORY_USAGE_HPP
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Heap memory owned by an object, in bytes.
+//! \details The estimates assume the node layout of libstdc++ and ignore
+//!          the overhead of the allocator. Types without an overload own
+//!          no heap memory.
+template<class T>
+std::size_t heapBytes(const T&);
+
+template<class T, class A>
+std::size_t heapBytes(const std::vector<T, A>& v);
+
+template<class T, std::size_t N>
+std::size_t heapBytes(const std::array<T, N>& a);
+
+template<class T1, class T2>
+std::size_t heapBytes(const std::pair<T1, T2>& p);
+
+template<class T>
+std::size_t heapBytes(const std::optional<T>& o);
+
+std::size_t heapBytes(const std::string& s);
+
+template<class K, class V, class C, class A>
+std::size_t heapBytes(const std::map<K, V, C, A>& m);
+
+template<class K, class V, class H, class E, class A>
+std::size_t heapBytes(const std::unordered_map<K, V, H, E, A>& m);
+
+//! \brief Sum of the heap memory owned by several objects, in bytes.
+template<class... Ts>
+std::size_t totalHeapBytes(const Ts&... objects)
+{
+    return (std::size_t{0} + ... + heapBytes(objects));
+}
+
+template<class T>
+std::size_t heapBytes(const T&)
+{
+    return 0;
+}
+
+template<class T, class A>
+std::size_t heapBytes(const std::vector<T, A>& v)
+{
+    std::size_t bytes = v.capacity() * sizeof(T);
+    if constexpr (!std::is_trivially_copyable_v<T>) {
+        for (const auto& x : v) {
+            bytes += heapBytes(x);
+        }
+    }
+    return bytes;
+}
+
+template<class T, std::size_t N>
+std::size_t heapBytes(const std::array<T, N>& a)
+{
+    std::size_t bytes = 0;
+    if constexpr (!std::is_trivially_copyable_v<T>) {
+        for (const auto& x : a) {
+            bytes += heapBytes(x);
+        }
+    }
+    return bytes;
+}
+
+template<class T1, class T2>
+std::size_t heapBytes(const std::pair<T1, T2>& p)
+{
+    return heapBytes(p.first) + heapBytes(p.second);
+}
+
+template<class T>
+std::size_t heapBytes(const std::optional<T>& o)
+{
+    return o.has_value() ? heapBytes(*o) : 0;
+}
+
+inline std::size_t heapBytes(const std::string& s)
+{
+    // Short strings are stored in the object itself.
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+template<class K, class V, class C, class A>
+std::size_t heapBytes(const std::map<K, V, C, A>& m)
+{
+    // Tree nodes hold the colour and three pointers besides the value.
+    std::size_t bytes = m.size() * (sizeof(std::pair<const K, V>) + 4 * sizeof(void*));
+    if constexpr (!std::is_trivially_copyable_v<K> || !std::is_trivially_copyable_v<V>) {
+        for (const auto& x : m) {
+            bytes += heapBytes(x.first) + heapBytes(x.second);
+        }
+    }
+    return bytes;
+}
+
+template<class K, class V, class H, class E, class A>
+std::size_t heapBytes(const std::unordered_map<K, V, H, E, A>& m)
+{
+    // Nodes hold the next pointer and the cached hash besides the value.
+    std::size_t bytes = m.bucket_count() * sizeof(void*)
+        + m.size() * (sizeof(std::pair<const K, V>) + 2 * sizeof(void*));
+    if constexpr (!std::is_trivially_copyable_v<K> || !std::is_trivially_copyable_v<V>) {
+        for (const auto& x : m) {
+            bytes += heapBytes(x.first) + heapBytes(x.second);
+        }
+    }
+    return bytes;
+}
+
+//! \brief Memory of the process as reported by the operating system.
+struct ProcessMemory
+{
+    std::size_t resident = 0; //!< Current resident set size in bytes
+    std::size_t peak = 0;     //!< Peak resident set size in bytes
+};
+
+//! \brief Resident set size of the calling process.
+//! \details Read from /proc/self/status, zero where it is not available.
+ProcessMemory processMemory();
+
+//! \brief Memory footprint of the simulator by subsystem.
+//! \details Every process adds the bytes of the same subsystems in the same
+//!          order, processes that do not have a subsystem add zero.
+class MemoryReport
+{
+public:
+    //! \brief Add the bytes of a subsystem on this process.
+    void add(const std::string& subsystem, std::size_t bytes);
+
+    //! \brief Subsystems and their bytes on this process.
+    const std::vector<std::pair<std::string, std::size_t>>& entries() const
+    { return entries_; }
+
+    //! \brief Bytes of all subsystems on this process.
+    std::size_t total() const;
+
+    //! \brief Table of the subsystems with statistics over processes.
+    //! \details Collective operation. Every subsystem, the sum of them and
+    //!          the resident set size of the processes has the minimum,
+    //!          mean and maximum over all processes in MiB, and the rank
+    //!          of the process with the maximum.
+    //! \param comm Communicator of the processes
+    //! \param title First line of the table
+    //! \return Table on rank 0, empty string elsewhere
+    std::string table(Parallel::Communication comm, const std::string& title) const;
+
+private:
+    std::vector<std::pair<std::string, std::size_t>> entries_;
+};
+
+} // namespace Opm
+
+#endif // OPM_MEMORY_USAGE_HPP
@@ -0,0 +1,126 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/ParallelCellDataWriter.hpp>
+
+#include <opm/output/data/Solution.hpp>
+
+#include <ebos/hdf5serializer.hh>
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace Opm {
+
+ParallelCellDataWriter::
+ParallelCellDataWriter(const std::string& fileName,
+                       Parallel::Communication comm,
+                       std::vector<int> localCells,
+                       std::vector<int> cartesianIndex,
+                       bool append)
+    : fileName_(fileName)
+    , comm_(comm)
+    , localCells_(std::move(localCells))
+    , cartesianIndex_(std::move(cartesianIndex))
+    , append_(append)
+{
+    assert(localCells_.size() == cartesianIndex_.size());
+}
+
+void ParallelCellDataWriter::write(int reportStep,
+                                   const data::Solution& localCellData)
+{
+    // A restarted run keeps the steps written before the restart.
+    const bool keep = initialized_ ||
+                      (append_ && std::filesystem::exists(fileName_));
+    const auto mode = keep ? HDF5File::OpenMode::APPEND
+                           : HDF5File::OpenMode::OVERWRITE;
+    HDF5Serializer writer(fileName_, mode, comm_);
+
+    const std::string group = "/report_step/" + std::to_string(reportStep);
+    if (keep) {
+        // A step written before, e.g. prior to a restart, is replaced.
+        const auto steps = writer.reportSteps();
+        if (std::find(steps.begin(), steps.end(), reportStep) != steps.end()) {
+            writer.remove(group);
+        }
+    }
+
+    FieldMap fields;
+    for (const auto& [name, cellData] : localCellData) {
+        auto& values = fields[name];
+        values.reserve(localCells_.size());
+        for (const auto cell : localCells_) {
+            values.push_back(cellData.data[cell]);
+        }
+    }
+
+    // The partitioning may differ between runs, so each step has its
+    // own index map.
+    writer.write(cartesianIndex_, group, "cell_index");
+    writer.write(fields, group, "cell_data");
+    initialized_ = true;
+}
+
+ParallelCellDataWriter::FieldMap
+ParallelCellDataWriter::readGlobal(const std::string& fileName,
+                                   int reportStep,
+                                   std::size_t cartesianSize,
+                                   Parallel::Communication comm)
+{
+    if (comm.size() != 1) {
+        throw std::logic_error("ParallelCellDataWriter::readGlobal() "
+                               "must be called on a single process");
+    }
+
+    HDF5Serializer reader(fileName, HDF5File::OpenMode::READ, comm);
+    HDF5File file(fileName, HDF5File::OpenMode::READ, comm);
+
+    const std::string group = "/report_step/" + std::to_string(reportStep);
+
+    FieldMap result;
+    for (const auto& rank : file.list(group + "/cell_index")) {
+        std::vector<int> cartIdx;
+        reader.read(cartIdx, group + "/cell_index", rank,
+                    HDF5File::DataSetMode::ROOT_ONLY);
+
+        FieldMap fields;
+        reader.read(fields, group + "/cell_data", rank,
+                    HDF5File::DataSetMode::ROOT_ONLY);
+
+        for (const auto& [name, values] : fields) {
+            if (values.size() != cartIdx.size()) {
+                throw std::runtime_error("Inconsistent cell data for field " +
+                                         name + " from rank " + rank);
+            }
+
+            auto& global = result[name];
+            global.resize(cartesianSize, 0.0);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                global[cartIdx[i]] = values[i];
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace Opm
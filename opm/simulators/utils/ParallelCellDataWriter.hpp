@@ -0,0 +1,98 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLEL_CELL_DATA_WRITER_HPP
+#define OPM_PARALLEL_CELL_DATA_WRITER_HPP
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm { namespace data {
+class Solution;
+}} // namespace Opm::data
+
+namespace Opm {
+
+//! \brief Writes per-cell report step output from every rank directly.
+//!
+//! \details Each process writes the interior part of its local cell data
+//! to its own dataset in a shared HDF5 file, together with the Cartesian
+//! indices of the written cells.  Nothing is funnelled through the I/O
+//! rank.  The data sets may be assembled into global Cartesian arrays
+//! after the run by readGlobal().
+//!
+//! File layout:
+//!   /report_step/<N>/cell_index/<rank>  Cartesian index of each written cell
+//!   /report_step/<N>/cell_data/<rank>   Field name to SI values
+class ParallelCellDataWriter
+{
+public:
+    using FieldMap = std::map<std::string, std::vector<double>>;
+
+    //! \brief Constructor.
+    //! \param fileName Name of HDF5 file.  Truncated on first write
+    //!                 unless \p append is set.
+    //! \param comm Communicator of all processes taking part in the output
+    //! \param localCells Local (active) indices of the cells to write, i.e.,
+    //!                   the interior cells of this process
+    //! \param cartesianIndex Cartesian index of each entry in \p localCells
+    //! \param append Keep the steps of an existing file, e.g., in a
+    //!               restarted run
+    ParallelCellDataWriter(const std::string& fileName,
+                           Parallel::Communication comm,
+                           std::vector<int> localCells,
+                           std::vector<int> cartesianIndex,
+                           bool append = false);
+
+    //! \brief Collectively write cell data for a report step.
+    //! \details Data of a step already in the file is replaced.
+    //! \param reportStep Report step number
+    //! \param localCellData Cell data for all local cells of this process
+    void write(int reportStep, const data::Solution& localCellData);
+
+    //! \brief Name of output file.
+    const std::string& fileName() const
+    { return fileName_; }
+
+    //! \brief Assemble global Cartesian arrays for a report step.
+    //! \details Reads the data sets of all writing processes. Intended
+    //!          for post-processing, runs on a single process.
+    //! \param fileName Name of HDF5 file
+    //! \param reportStep Report step to read
+    //! \param cartesianSize Number of cells in the Cartesian grid
+    //! \param comm Communicator to open file with, should have size 1
+    static FieldMap readGlobal(const std::string& fileName,
+                               int reportStep,
+                               std::size_t cartesianSize,
+                               Parallel::Communication comm);
+
+private:
+    std::string fileName_; //!< Name of output file
+    Parallel::Communication comm_; //!< Communicator of writing processes
+    std::vector<int> localCells_; //!< Local indices of written cells
+    std::vector<int> cartesianIndex_; //!< Cartesian indices of written cells
+    bool append_ = false; //!< True to keep steps of an existing file
+    bool initialized_ = false; //!< True once file has been opened
+};
+
+} // namespace Opm
+
+#endif // OPM_PARALLEL_CELL_DATA_WRITER_HPP
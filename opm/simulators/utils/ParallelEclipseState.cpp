@@ -23,6 +23,8 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <opm/simulators/utils/MemoryUsage.hpp>
+
 #include <cstddef>
 #include <regex>
 #include <string>
@@ -226,6 +228,23 @@ bool ParallelFieldPropsManager::has_double(const std::string& keyword) const
 }
 
 
+std::size_t ParallelFieldPropsManager::memoryUsage() const
+{
+    auto propsBytes = [](const auto& props)
+    {
+        std::size_t bytes = 0;
+        for (const auto& [keyword, fieldData] : props) {
+            bytes += heapBytes(keyword)
+                   + heapBytes(fieldData.data)
+                   + heapBytes(fieldData.value_status);
+        }
+        return bytes;
+    };
+
+    return propsBytes(m_intProps) + propsBytes(m_doubleProps);
+}
+
+
 ParallelEclipseState::ParallelEclipseState(Parallel::Communication comm)
     : m_fieldProps(field_props, comm)
     , m_comm(comm)
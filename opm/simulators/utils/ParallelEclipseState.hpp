@@ -26,6 +26,7 @@
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <cstddef>
 #include <functional>
 
 namespace Opm {
@@ -113,6 +114,9 @@ public:
         m_tran = from.getTran();
     }
 
+    //! \brief Returns the heap memory held by the distributed properties in bytes.
+    std::size_t memoryUsage() const;
+
     template<class Serializer>
     void serializeOp(Serializer& serializer)
     {
@@ -190,6 +194,13 @@ public:
     {
         m_fieldProps.resetCartesianMapper(mapper);
     }
+
+    //! \brief Returns the heap memory held by the distributed field properties in bytes.
+    //! \details The global field properties on the root process are not included.
+    std::size_t distributedPropsMemoryUsage() const
+    {
+        return m_fieldProps.memoryUsage();
+    }
 private:
     bool m_parProps = false; //! True to use distributed properties on root process
     ParallelFieldPropsManager m_fieldProps; //!< The parallel field properties
@@ -37,9 +37,12 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <numeric>
 #include <stdexcept>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -157,12 +160,20 @@ namespace {
         ///
         /// \param[in] globalCell Callback for mapping (local) vertex IDs to
         ///   globally unique vertex IDs.
+        ///
+        /// \param[in] edgeWeights Weight of each edge in \p edges.  Empty
+        ///   for an unweighted graph.
+        ///
+        /// \param[in] vertexWeights Weight of each of the \p numVertices
+        ///   vertices.  Empty for uniform vertex weights.
         template <typename Edge, typename GlobalCellID>
         explicit VertexGraph(const int                    myRank,
                              const std::size_t            numVertices,
                              const std::vector<Edge>&     edges,
                              const EnumerateSeenVertices& vertexId,
-                             GlobalCellID&&               globalCell)
+                             GlobalCellID&&               globalCell,
+                             const std::vector<double>&   edgeWeights,
+                             const std::vector<double>&   vertexWeights)
             : myRank_ { myRank }
         {
             // Form undirected connectivity graph.
@@ -180,6 +191,19 @@ namespace {
                     this->globalCell_[localIx] = globalCell(vertex);
                 }
             }
+
+            if (! edgeWeights.empty()) {
+                this->assignEdgeWeights(edges, vertexId, edgeWeights);
+            }
+
+            if (! vertexWeights.empty()) {
+                this->vertexWeights_.resize(vertexId.numVertices());
+                for (auto vertex = 0*numVertices; vertex < numVertices; ++vertex) {
+                    if (const auto localIx = vertexId[vertex]; localIx >= 0) {
+                        this->vertexWeights_[localIx] = static_cast<float>(vertexWeights[vertex]);
+                    }
+                }
+            }
         }
 
         /// Retrive my rank in current MPI communicator.
@@ -220,6 +244,34 @@ namespace {
             return this->graph_.columnIndices();
         }
 
+        /// Whether or not the graph has edge weights.
+        bool hasEdgeWeights() const
+        {
+            return ! this->edgeWeights_.empty();
+        }
+
+        /// Whether or not the graph has vertex weights.
+        bool hasVertexWeights() const
+        {
+            return ! this->vertexWeights_.empty();
+        }
+
+        /// Retrieve weight of edge.
+        ///
+        /// \param[in] edgeIx Index of edge in column indices (JA array).
+        float edgeWeight(const int edgeIx) const
+        {
+            return this->edgeWeights_[edgeIx];
+        }
+
+        /// Retrieve weight of vertex.
+        ///
+        /// \param[in] localCell Index of locally reachable cell/vertex.
+        float vertexWeight(const int localCell) const
+        {
+            return this->vertexWeights_[localCell];
+        }
+
     private:
         // VertexID = int, TrackCompressedIdx = false
         using Backend = Opm::utility::CSRGraphFromCoordinates<>;
@@ -232,6 +284,50 @@ namespace {
 
         /// Vertex connectivity graph.
         Backend graph_{};
+
+        /// Weight of each edge, in the order of the column indices.  Empty
+        /// for an unweighted graph.
+        std::vector<float> edgeWeights_{};
+
+        /// Weight of each reachable vertex.  Empty for uniform weights.
+        std::vector<float> vertexWeights_{};
+
+        /// Align edge weights with the graph's CSR representation.
+        ///
+        /// Repeated edges between the same pair of vertices get the
+        /// largest of their weights.
+        template <typename Edge>
+        void assignEdgeWeights(const std::vector<Edge>&     edges,
+                               const EnumerateSeenVertices& vertexId,
+                               const std::vector<double>&   weights)
+        {
+            auto key = [](const int v1, const int v2)
+            {
+                return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(v1)) << 32)
+                    | static_cast<std::uint32_t>(v2);
+            };
+
+            auto edgeWeight = std::unordered_map<std::uint64_t, float>{};
+            for (auto edge = 0*edges.size(); edge < edges.size(); ++edge) {
+                const auto v1 = vertexId[std::get<0>(edges[edge])];
+                const auto v2 = vertexId[std::get<1>(edges[edge])];
+                const auto w = static_cast<float>(weights[edge]);
+
+                for (const auto k : { key(v1, v2), key(v2, v1) }) {
+                    auto& weight = edgeWeight[k];
+                    weight = std::max(weight, w);
+                }
+            }
+
+            const auto& ia = this->graph_.startPointers();
+            const auto& ja = this->graph_.columnIndices();
+            this->edgeWeights_.resize(ja.size());
+            for (auto vertex = 0*this->numVertices(); vertex < this->numVertices(); ++vertex) {
+                for (auto edgeIx = ia[vertex]; edgeIx != ia[vertex + 1]; ++edgeIx) {
+                    this->edgeWeights_[edgeIx] = edgeWeight[key(vertex, ja[edgeIx])];
+                }
+            }
+        }
     };
 
 // Use C linkage for Zoltan interface/query functions.  Ensures maximum compatibility.
@@ -316,8 +412,8 @@ extern "C" {
                     const int        numElmsPerLid,
                     ZOLTAN_ID_PTR    globalIds,
                     ZOLTAN_ID_PTR    localIds,
-                    const int     /* wgtDim */,
-                    float*        /* objWgts */,
+                    const int        wgtDim,
+                    float*           objWgts,
                     int*             ierr)
     {
         if ((numElmsPerGid != numElmsPerLid) || (numElmsPerLid != 1)) {
@@ -340,6 +436,13 @@ extern "C" {
                            return graph->globalId(localCell);
                        });
 
+        if (wgtDim == 1) {
+            for (auto localCell = 0; localCell < graph->numVertices(); ++localCell) {
+                objWgts[localCell] = graph->hasVertexWeights()
+                    ? graph->vertexWeight(localCell) : 1.0f;
+            }
+        }
+
         *ierr = ZOLTAN_OK;
     }
 
@@ -382,8 +485,8 @@ extern "C" {
                   int*          /* numEdges */,
                   ZOLTAN_ID_PTR    neighbourGid,
                   int*             neighbourProc,
-                  int           /* weightDim */,
-                  float*        /* edgeWeights */,
+                  int              weightDim,
+                  float*           edgeWeights,
                   int*             ierr)
     {
         const auto* graph = static_cast<VertexGraph*>(graphPtr);
@@ -410,6 +513,11 @@ extern "C" {
             {
                 neighbourGid [ix] = static_cast<ZOLTAN_ID_TYPE>(graph->globalId(ja[neighIx]));
                 neighbourProc[ix] = graph->myRank();
+
+                if (weightDim == 1) {
+                    edgeWeights[ix] = graph->hasEdgeWeights()
+                        ? graph->edgeWeight(neighIx) : 1.0f;
+                }
             }
         }
     }
@@ -554,13 +662,26 @@ Opm::ParallelNLDDPartitioningZoltan::partitionElements(const ZoltanParamMap& par
 {
     const auto vertexId = EnumerateSeenVertices { this->numElements_, this->conns_ };
 
+    const auto noWeights = std::vector<double>{};
     auto graph = VertexGraph {
         this->comm_.rank(), this->numElements_,
-        this->conns_, vertexId, this->globalCell_
+        this->conns_, vertexId, this->globalCell_,
+        this->weightedConns_ ? this->connWeights_ : noWeights,
+        this->vertexWeights_
     };
 
+    // Weights must be enabled consistently on all ranks, but user-selected
+    // parameters take precedence.
+    auto zoltanParams = params;
+    if (this->comm_.max(static_cast<int>(graph.hasEdgeWeights())) > 0) {
+        zoltanParams.emplace("EDGE_WEIGHT_DIM", "1");
+    }
+    if (this->comm_.max(static_cast<int>(graph.hasVertexWeights())) > 0) {
+        zoltanParams.emplace("OBJ_WEIGHT_DIM", "1");
+    }
+
     const auto partsForReachableCells = Partitioner {
-        this->comm_, params
+        this->comm_, zoltanParams
     }(static_cast<void*>(&graph), graph.numVertices());
 
     // Map reachable cells back to full cell numbering.
@@ -70,6 +70,36 @@ namespace Opm {
         void registerConnection(std::size_t c1, std::size_t c2)
         {
             this->conns_.emplace_back(c1, c2);
+            this->connWeights_.push_back(1.0);
+        }
+
+        /// Insert weighted directed graph edge between two vertices.
+        ///
+        /// The partitioning procedure prefers cutting edges of small
+        /// weight.  Edges registered without a weight get unit weight.
+        ///
+        /// \param[in] c1 Source vertex.
+        ///
+        /// \param[in] c2 Sink/destination vertex.
+        ///
+        /// \param[in] weight Positive edge weight.
+        void registerConnection(std::size_t c1, std::size_t c2, double weight)
+        {
+            this->conns_.emplace_back(c1, c2);
+            this->connWeights_.push_back(weight);
+            this->weightedConns_ = true;
+        }
+
+        /// Assign computational cost of each vertex.
+        ///
+        /// The partitioning procedure balances the total weight of the
+        /// vertices in each domain instead of their number.
+        ///
+        /// \param[in] weights Non-negative weight of each of the \c
+        ///   numElements vertices.
+        void setVertexWeights(std::vector<double>&& weights)
+        {
+            this->vertexWeights_ = std::move(weights);
         }
 
         /// Force collection of cells to be in same result domain.
@@ -117,6 +147,15 @@ namespace Opm {
         /// Connectivity graph edges.
         std::vector<Connection> conns_{};
 
+        /// Weight of each connectivity graph edge.
+        std::vector<double> connWeights_{};
+
+        /// Whether or not any edge was registered with an explicit weight.
+        bool weightedConns_{false};
+
+        /// Weight of each vertex.  Empty for uniform weights.
+        std::vector<double> vertexWeights_{};
+
         /// Collections of vertices/cells which must be coalesced to the
         /// same domain/block.  All vertices within a single collection will
         /// be placed on the same domain, but cells from different
@@ -0,0 +1,229 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/TimerTree.hpp>
+
+#include <opm/simulators/utils/TwoLevelGather.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+
+struct Node
+{
+    std::string name;
+    double seconds = 0.0;
+    std::size_t calls = 0;
+    Node* parent = nullptr;
+    std::vector<std::unique_ptr<Node>> children;
+
+    Node* child(const char* childName)
+    {
+        for (auto& c : children) {
+            if (c->name == childName) {
+                return c.get();
+            }
+        }
+        children.push_back(std::make_unique<Node>());
+        children.back()->name = childName;
+        children.back()->parent = this;
+        return children.back().get();
+    }
+};
+
+Node root;
+Node* current = &root;
+std::thread::id owner;
+std::chrono::steady_clock::time_point resetTime{}; //!< Open scopes count from here
+
+//! \brief Path of every node below node in preorder, with its time and calls.
+void flatten(const Node& node,
+             const std::string& prefix,
+             std::vector<std::string>& paths,
+             std::vector<double>& seconds,
+             std::vector<double>& calls)
+{
+    for (const auto& c : node.children) {
+        const auto path = prefix.empty() ? c->name : prefix + '/' + c->name;
+        paths.push_back(path);
+        seconds.push_back(c->seconds);
+        calls.push_back(static_cast<double>(c->calls));
+        flatten(*c, path, paths, seconds, calls);
+    }
+}
+
+//! \brief Statistics of a timer over processes.
+struct Stats
+{
+    std::string name;
+    double minSeconds, meanSeconds, maxSeconds;
+    double minCalls, meanCalls, maxCalls;
+    std::vector<std::size_t> children;
+};
+
+void writeJson(const std::vector<Stats>& stats,
+               const std::vector<std::size_t>& nodes,
+               const int indent,
+               std::string& out)
+{
+    const std::string pad(indent, ' ');
+    out += "[";
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const auto& s = stats[nodes[i]];
+        const double imbalance = s.meanSeconds > 0.0 ? s.maxSeconds / s.meanSeconds : 1.0;
+        out += i == 0 ? "\n" : ",\n";
+        out += fmt::format("{0}  {{\n"
+                           "{0}    \"name\": \"{1}\",\n"
+                           "{0}    \"seconds\": {{ \"min\": {2}, \"mean\": {3}, \"max\": {4} }},\n"
+                           "{0}    \"calls\": {{ \"min\": {5}, \"mean\": {6}, \"max\": {7} }},\n"
+                           "{0}    \"imbalance\": {8},\n"
+                           "{0}    \"children\": ",
+                           pad, s.name,
+                           s.minSeconds, s.meanSeconds, s.maxSeconds,
+                           s.minCalls, s.meanCalls, s.maxCalls,
+                           imbalance);
+        writeJson(stats, s.children, indent + 4, out);
+        out += "\n" + pad + "  }";
+    }
+    out += nodes.empty() ? "]" : "\n" + pad + "]";
+}
+
+} // Anonymous namespace
+
+namespace Opm {
+
+bool TimerTree::enabled_ = false;
+
+void TimerTree::setEnabled(const bool enable)
+{
+    owner = std::this_thread::get_id();
+    enabled_ = enable;
+}
+
+void TimerTree::reset()
+{
+    // The nodes of the open scopes are kept, as the scopes refer to them,
+    // and only count their time from now on.
+    const Node* open = nullptr;
+    for (Node* node = current; node != nullptr; node = node->parent) {
+        node->seconds = 0.0;
+        node->calls = 0;
+        auto& children = node->children;
+        children.erase(std::remove_if(children.begin(), children.end(),
+                                      [open](const auto& c) { return c.get() != open; }),
+                       children.end());
+        open = node;
+    }
+    resetTime = std::chrono::steady_clock::now();
+}
+
+void TimerTree::Scope::start(const char* name)
+{
+    if (std::this_thread::get_id() != owner) {
+        return;
+    }
+    current = current->child(name);
+    node_ = current;
+    start_ = std::chrono::steady_clock::now();
+}
+
+void TimerTree::Scope::stop()
+{
+    auto* node = static_cast<Node*>(node_);
+    const auto start = std::max(start_, resetTime);
+    node->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ++node->calls;
+    current = node->parent;
+}
+
+std::string TimerTree::json(Parallel::Communication comm)
+{
+    std::vector<std::string> localPaths;
+    std::vector<double> localSeconds;
+    std::vector<double> localCalls;
+    flatten(root, "", localPaths, localSeconds, localCalls);
+
+    // The union of the timers of all processes, in order of first
+    // appearance by rank, which places children after their parents.
+    std::vector<char> buffer;
+    for (const auto& path : localPaths) {
+        buffer.insert(buffer.end(), path.begin(), path.end());
+        buffer.push_back('\n');
+    }
+    std::vector<int> displ;
+    const auto all = allGatherBuffers(buffer, displ, comm, GatherMethod::Flat);
+
+    std::vector<std::string> paths;
+    std::map<std::string, std::size_t> index;
+    std::size_t begin = 0;
+    for (std::size_t pos = 0; pos < all.size(); ++pos) {
+        if (all[pos] == '\n') {
+            std::string path(all.data() + begin, pos - begin);
+            if (index.emplace(path, paths.size()).second) {
+                paths.push_back(std::move(path));
+            }
+            begin = pos + 1;
+        }
+    }
+
+    const std::size_t n = paths.size();
+    std::vector<double> minVal(2 * n, 0.0);
+    for (std::size_t i = 0; i < localPaths.size(); ++i) {
+        const auto j = index.at(localPaths[i]);
+        minVal[j] = localSeconds[i];
+        minVal[n + j] = localCalls[i];
+    }
+    auto maxVal = minVal;
+    auto sumVal = minVal;
+    comm.min(minVal.data(), minVal.size());
+    comm.max(maxVal.data(), maxVal.size());
+    comm.sum(sumVal.data(), sumVal.size());
+
+    if (comm.rank() != 0) {
+        return {};
+    }
+
+    std::vector<Stats> stats(n);
+    std::vector<std::size_t> top;
+    for (std::size_t j = 0; j < n; ++j) {
+        const auto slash = paths[j].rfind('/');
+        stats[j] = {slash == std::string::npos ? paths[j] : paths[j].substr(slash + 1),
+                    minVal[j], sumVal[j] / comm.size(), maxVal[j],
+                    minVal[n + j], sumVal[n + j] / comm.size(), maxVal[n + j],
+                    {}};
+        if (slash == std::string::npos) {
+            top.push_back(j);
+        } else {
+            stats[index.at(paths[j].substr(0, slash))].children.push_back(j);
+        }
+    }
+
+    std::string out = fmt::format("{{\n  \"processes\": {},\n  \"timers\": ", comm.size());
+    writeJson(stats, top, 2, out);
+    out += "\n}\n";
+    return out;
+}
+
+} // namespace Opm
@@ -0,0 +1,102 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TIMER_TREE_HPP
+#define OPM_TIMER_TREE_HPP
+
+#include <opm/common/TimingMacros.hpp>
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+//! \brief Time a block in the built-in timer tree, and in the profiler
+//!        like OPM_TIMEBLOCK.
+#define OPM_TIMEBLOCK_TREE(blockname) \
+    OPM_TIMEBLOCK(blockname);         \
+    ::Opm::TimerTree::Scope opm_timer_tree_##blockname(#blockname)
+
+namespace Opm {
+
+//! \brief Built-in hierarchical timers.
+//! \details Each timed block is a node below the block it is nested in, and
+//!          accumulates the time spent in it and the number of calls. Only
+//!          the thread that enabled the timers records, blocks entered by
+//!          other threads are ignored. When disabled, a timed block costs
+//!          a single branch.
+class TimerTree
+{
+public:
+    //! \brief Start or stop recording on the calling thread.
+    static void setEnabled(bool enable);
+
+    //! \brief Returns true if timed blocks are recorded.
+    static bool enabled()
+    { return enabled_; }
+
+    //! \brief Forget all recorded times.
+    //! \details Blocks that are open keep their nodes, and record the time
+    //!          from the reset on when they close.
+    static void reset();
+
+    //! \brief Times the enclosing block.
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name)
+        {
+            if (enabled_) {
+                start(name);
+            }
+        }
+
+        ~Scope()
+        {
+            if (node_ != nullptr) {
+                stop();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        void start(const char* name);
+        void stop();
+
+        void* node_ = nullptr; //!< Node of the block, null if not recorded
+        std::chrono::steady_clock::time_point start_{};
+    };
+
+    //! \brief Recorded times as JSON, with statistics over processes.
+    //! \details Collective operation. Every timer has the minimum, mean
+    //!          and maximum over all processes of its time and number of
+    //!          calls, where processes that never entered a block count
+    //!          as zero, and the ratio of maximum to mean time.
+    //! \param comm Communicator of the processes
+    //! \return JSON document on rank 0, empty string elsewhere
+    static std::string json(Parallel::Communication comm);
+
+private:
+    static bool enabled_;
+};
+
+} // namespace Opm
+
+#endif // OPM_TIMER_TREE_HPP
@@ -0,0 +1,339 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/TwoLevelGather.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+#if HAVE_MPI
+#include <mpi.h>
+
+#include <cassert>
+#include <memory>
+#endif
+
+#if HAVE_MPI
+
+namespace {
+
+//! \brief Communicators used for two-level gathers.
+//! \details Cached as an attribute of the parent communicator, and freed
+//!          together with it.
+struct NodeComms
+{
+    MPI_Comm node = MPI_COMM_NULL; //!< Processes sharing a node
+    MPI_Comm leaders = MPI_COMM_NULL; //!< Node leaders, null on other processes
+    std::vector<int> leaderOf; //!< Rank in leaders of the node leader of each process
+    std::vector<int> leaderRank; //!< Rank of the node leader of each process
+};
+
+int deleteNodeComms(MPI_Comm, int, void* attr, void*)
+{
+    auto* comms = static_cast<NodeComms*>(attr);
+    MPI_Comm_free(&comms->node);
+    if (comms->leaders != MPI_COMM_NULL) {
+        MPI_Comm_free(&comms->leaders);
+    }
+    delete comms;
+    return MPI_SUCCESS;
+}
+
+const NodeComms& nodeComms(MPI_Comm comm)
+{
+    static int keyval = [] {
+        int key = MPI_KEYVAL_INVALID;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, deleteNodeComms, &key, nullptr);
+        return key;
+    }();
+
+    void* attr = nullptr;
+    int found = 0;
+    MPI_Comm_get_attr(comm, keyval, &attr, &found);
+    if (found) {
+        return *static_cast<NodeComms*>(attr);
+    }
+
+    int rank = 0;
+    int size = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    // The lowest rank on a node is its leader.
+    auto comms = std::make_unique<NodeComms>();
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &comms->node);
+    int node_rank = 0;
+    MPI_Comm_rank(comms->node, &node_rank);
+    MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank, &comms->leaders);
+
+    int leader[2] = {-1, rank};
+    if (node_rank == 0) {
+        MPI_Comm_rank(comms->leaders, &leader[0]);
+    }
+    MPI_Bcast(leader, 2, MPI_INT, 0, comms->node);
+
+    std::vector<int> all(2 * size);
+    MPI_Allgather(leader, 2, MPI_INT, all.data(), 2, MPI_INT, comm);
+    comms->leaderOf.resize(size);
+    comms->leaderRank.resize(size);
+    for (int p = 0; p < size; ++p) {
+        comms->leaderOf[p] = all[2 * p];
+        comms->leaderRank[p] = all[2 * p + 1];
+    }
+
+    MPI_Comm_set_attr(comm, keyval, comms.get());
+    return *comms.release();
+}
+
+//! \brief Offsets of blocks with given sizes, with one trailing entry.
+std::vector<int> offsets(const std::vector<int>& sizes)
+{
+    std::vector<int> displ(sizes.size() + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), displ.begin() + 1);
+    return displ;
+}
+
+template<class T>
+std::vector<T> flatAllGatherv(const std::vector<T>& local,
+                              MPI_Datatype type,
+                              std::vector<int>& displ,
+                              MPI_Comm comm)
+{
+    int size = 0;
+    MPI_Comm_size(comm, &size);
+    int local_size = local.size();
+    std::vector<int> sizes(size);
+    MPI_Allgather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm);
+    displ = offsets(sizes);
+
+    std::vector<T> result(displ.back());
+    MPI_Allgatherv(local.data(), local_size, type,
+                   result.data(), sizes.data(), displ.data(), type, comm);
+    return result;
+}
+
+template<class T>
+std::vector<T> flatGatherv(const std::vector<T>& local,
+                           MPI_Datatype type,
+                           std::vector<int>& displ,
+                           int root,
+                           MPI_Comm comm)
+{
+    int rank = 0;
+    int size = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    int local_size = local.size();
+    std::vector<int> sizes(rank == root ? size : 0);
+    MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, root, comm);
+    displ = rank == root ? offsets(sizes) : std::vector<int>{};
+
+    std::vector<T> result(rank == root ? displ.back() : 0);
+    MPI_Gatherv(local.data(), local_size, type,
+                result.data(), sizes.data(), displ.data(), type, root, comm);
+    return result;
+}
+
+//! \brief Buffers of the processes on a node, gathered on its leader.
+struct NodeBlock
+{
+    //! Number of processes followed by (rank, size) for each process.
+    std::vector<int> header;
+    std::vector<char> data; //!< Concatenated buffers of the processes
+};
+
+NodeBlock gatherNode(const std::vector<char>& local, int rank, MPI_Comm node)
+{
+    int node_rank = 0;
+    int node_size = 0;
+    MPI_Comm_rank(node, &node_rank);
+    MPI_Comm_size(node, &node_size);
+
+    const int info[2] = {rank, static_cast<int>(local.size())};
+    std::vector<int> infos(node_rank == 0 ? 2 * node_size : 0);
+    MPI_Gather(info, 2, MPI_INT, infos.data(), 2, MPI_INT, 0, node);
+
+    NodeBlock block;
+    std::vector<int> sizes;
+    std::vector<int> displ;
+    if (node_rank == 0) {
+        sizes.resize(node_size);
+        for (int p = 0; p < node_size; ++p) {
+            sizes[p] = infos[2 * p + 1];
+        }
+        displ = offsets(sizes);
+        block.header.reserve(infos.size() + 1);
+        block.header.push_back(node_size);
+        block.header.insert(block.header.end(), infos.begin(), infos.end());
+        block.data.resize(displ.back());
+    }
+    MPI_Gatherv(local.data(), local.size(), MPI_PACKED,
+                block.data.data(), sizes.data(), displ.data(), MPI_PACKED, 0, node);
+
+    return block;
+}
+
+//! \brief Reorder node-major buffers to rank order.
+std::vector<char> toRankOrder(const std::vector<int>& headers,
+                              const std::vector<char>& data,
+                              int size,
+                              std::vector<int>& displ)
+{
+    std::vector<int> sizes(size, 0);
+    std::vector<int> source(size, 0);
+    int offset = 0;
+    for (std::size_t pos = 0; pos < headers.size();) {
+        const int count = headers[pos++];
+        for (int i = 0; i < count; ++i, pos += 2) {
+            const int rank = headers[pos];
+            sizes[rank] = headers[pos + 1];
+            source[rank] = offset;
+            offset += sizes[rank];
+        }
+    }
+    assert(offset == static_cast<int>(data.size()));
+
+    displ = offsets(sizes);
+    std::vector<char> result(displ.back());
+    for (int p = 0; p < size; ++p) {
+        std::copy_n(data.begin() + source[p], sizes[p], result.begin() + displ[p]);
+    }
+    return result;
+}
+
+std::vector<char> twoLevelAllGather(const std::vector<char>& local,
+                                    std::vector<int>& displ,
+                                    MPI_Comm comm)
+{
+    const auto& comms = nodeComms(comm);
+    int rank = 0;
+    int size = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    const auto block = gatherNode(local, rank, comms.node);
+
+    std::vector<int> headers;
+    std::vector<char> data;
+    if (comms.leaders != MPI_COMM_NULL) {
+        std::vector<int> unused;
+        headers = flatAllGatherv(block.header, MPI_INT, unused, comms.leaders);
+        data = flatAllGatherv(block.data, MPI_PACKED, unused, comms.leaders);
+    }
+
+    int sizes[2] = {static_cast<int>(headers.size()), static_cast<int>(data.size())};
+    MPI_Bcast(sizes, 2, MPI_INT, 0, comms.node);
+    headers.resize(sizes[0]);
+    data.resize(sizes[1]);
+    MPI_Bcast(headers.data(), sizes[0], MPI_INT, 0, comms.node);
+    MPI_Bcast(data.data(), sizes[1], MPI_PACKED, 0, comms.node);
+
+    return toRankOrder(headers, data, size, displ);
+}
+
+std::vector<char> twoLevelGather(const std::vector<char>& local,
+                                 std::vector<int>& displ,
+                                 int root,
+                                 MPI_Comm comm)
+{
+    const auto& comms = nodeComms(comm);
+    int rank = 0;
+    int size = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    const auto block = gatherNode(local, rank, comms.node);
+
+    // Leaders gather on the leader of the root's node, which forwards
+    // the result to root if it is not the root itself.
+    const int root_leader = comms.leaderRank[root];
+    std::vector<char> result;
+    if (comms.leaders != MPI_COMM_NULL) {
+        std::vector<int> unused;
+        const auto headers = flatGatherv(block.header, MPI_INT, unused,
+                                         comms.leaderOf[root], comms.leaders);
+        const auto data = flatGatherv(block.data, MPI_PACKED, unused,
+                                      comms.leaderOf[root], comms.leaders);
+        if (rank == root_leader) {
+            result = toRankOrder(headers, data, size, displ);
+        }
+    }
+
+    if (root != root_leader) {
+        constexpr int tag = 4711;
+        if (rank == root_leader) {
+            MPI_Send(displ.data(), size + 1, MPI_INT, root, tag, comm);
+            MPI_Send(result.data(), result.size(), MPI_PACKED, root, tag, comm);
+            result.clear();
+            displ.clear();
+        } else if (rank == root) {
+            displ.resize(size + 1);
+            MPI_Recv(displ.data(), size + 1, MPI_INT, root_leader, tag, comm, MPI_STATUS_IGNORE);
+            result.resize(displ.back());
+            MPI_Recv(result.data(), result.size(), MPI_PACKED, root_leader, tag, comm, MPI_STATUS_IGNORE);
+        }
+    }
+
+    if (rank != root) {
+        displ.clear();
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+#endif // HAVE_MPI
+
+namespace Opm {
+
+std::vector<char> allGatherBuffers(const std::vector<char>& local,
+                                   std::vector<int>& displ,
+                                   [[maybe_unused]] Parallel::Communication comm,
+                                   [[maybe_unused]] GatherMethod method)
+{
+#if HAVE_MPI
+    if (comm.size() > 1) {
+        return method == GatherMethod::TwoLevel
+            ? twoLevelAllGather(local, displ, comm)
+            : flatAllGatherv(local, MPI_PACKED, displ, comm);
+    }
+#endif
+
+    displ = {0, static_cast<int>(local.size())};
+    return local;
+}
+
+std::vector<char> gatherBuffers(const std::vector<char>& local,
+                                std::vector<int>& displ,
+                                [[maybe_unused]] int root,
+                                [[maybe_unused]] Parallel::Communication comm,
+                                [[maybe_unused]] GatherMethod method)
+{
+#if HAVE_MPI
+    if (comm.size() > 1) {
+        return method == GatherMethod::TwoLevel
+            ? twoLevelGather(local, displ, root, comm)
+            : flatGatherv(local, MPI_PACKED, displ, root, comm);
+    }
+#endif
+
+    displ = {0, static_cast<int>(local.size())};
+    return local;
+}
+
+} // namespace Opm
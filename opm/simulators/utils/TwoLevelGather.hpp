@@ -0,0 +1,65 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_TWO_LEVEL_GATHER_HPP
+#define OPM_TWO_LEVEL_GATHER_HPP
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <vector>
+
+namespace Opm {
+
+//! \brief Algorithm used to gather packed buffers.
+//! \details With two-level gathers, processes sharing a node first gather
+//!          to a node leader over a shared memory communicator. Only the
+//!          node leaders then communicate across nodes. The gathered data
+//!          are identical for both variants.
+enum class GatherMethod {
+    Flat, //!< Single gather over the communicator
+    TwoLevel, //!< Node aware gather
+};
+
+//! \brief Gather packed buffers of all processes on all processes.
+//! \param local Buffer of this process
+//! \param displ On output, offsets of the buffers of each process in the
+//!              result in rank order, with comm.size() + 1 entries
+//! \param comm Communicator
+//! \param method Gather algorithm
+//! \return Concatenated buffers of all processes in rank order
+std::vector<char> allGatherBuffers(const std::vector<char>& local,
+                                   std::vector<int>& displ,
+                                   Parallel::Communication comm,
+                                   GatherMethod method);
+
+//! \brief Gather packed buffers of all processes on a root process.
+//! \param local Buffer of this process
+//! \param displ On output on root, offsets of the buffers of each process
+//!              in the result in rank order, with comm.size() + 1 entries
+//! \param root Rank receiving the buffers
+//! \param comm Communicator
+//! \param method Gather algorithm
+//! \return Concatenated buffers in rank order on root, empty elsewhere
+std::vector<char> gatherBuffers(const std::vector<char>& local,
+                                std::vector<int>& displ,
+                                int root,
+                                Parallel::Communication comm,
+                                GatherMethod method);
+
+} // namespace Opm
+
+#endif // OPM_TWO_LEVEL_GATHER_HPP
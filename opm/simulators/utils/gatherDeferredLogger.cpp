@@ -26,74 +26,103 @@
 
 #include <cassert>
 #include <cstdint>
-#include <numeric>
-#include <mpi.h>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace
 {
 
-    void packMessages(const std::vector<Opm::DeferredLogger::Message>& local_messages, std::vector<char>& buf, int& offset, const Opm::Parallel::Communication mpi_communicator)
+    // The messages of a process are packed as a table of the distinct tags
+    // and texts, followed by the messages referring to the table:
+    //
+    //   uint32 #strings, { uint32 size, chars }
+    //   uint32 #messages, { int64 flag, uint32 tag, uint32 text,
+    //                       uint32 #values, { double } }
+    //
+    // Structured messages with the same format thus only send it once.
+    // All processes run the same binary, so plain bytes are sufficient.
+
+    template <class T>
+    void pack(const T& value, std::vector<char>& buf)
     {
+        const auto* bytes = reinterpret_cast<const char*>(&value);
+        buf.insert(buf.end(), bytes, bytes + sizeof(T));
+    }
 
-        int messagesize = local_messages.size();
-        MPI_Pack(&messagesize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, mpi_communicator);
+    template <class T>
+    T unpack(const std::vector<char>& buf, std::size_t& offset)
+    {
+        T value;
+        std::memcpy(&value, buf.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
 
-        for (const auto& lm : local_messages) {
-            MPI_Pack(static_cast<void*>(const_cast<std::int64_t*>(&lm.flag)), 1, MPI_INT64_T, buf.data(), buf.size(), &offset, mpi_communicator);
-            int tagsize = lm.tag.size();
-            MPI_Pack(&tagsize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, mpi_communicator);
-            if (tagsize>0) {
-                MPI_Pack(const_cast<char*>(lm.tag.c_str()), lm.tag.size(), MPI_CHAR, buf.data(), buf.size(), &offset, mpi_communicator);
+    std::vector<char> packMessages(const std::vector<Opm::DeferredLogger::Message>& local_messages)
+    {
+        std::vector<const std::string*> strings;
+        std::unordered_map<std::string, std::uint32_t> string_index;
+        auto index = [&strings, &string_index](const std::string& str)
+        {
+            const auto [pos, inserted] = string_index.emplace(str, static_cast<std::uint32_t>(strings.size()));
+            if (inserted) {
+                strings.push_back(&pos->first);
             }
-            int textsize = lm.text.size();
-            MPI_Pack(&textsize, 1, MPI_UNSIGNED, buf.data(), buf.size(), &offset, mpi_communicator);
-            if (textsize>0) {
-                MPI_Pack(const_cast<char*>(lm.text.c_str()), lm.text.size(), MPI_CHAR, buf.data(), buf.size(), &offset, mpi_communicator);
+            return pos->second;
+        };
+
+        std::vector<char> messages;
+        pack(static_cast<std::uint32_t>(local_messages.size()), messages);
+        for (const auto& lm : local_messages) {
+            pack(static_cast<std::int64_t>(lm.flag), messages);
+            pack(index(lm.tag), messages);
+            pack(index(lm.text), messages);
+            pack(static_cast<std::uint32_t>(lm.values.size()), messages);
+            for (const double v : lm.values) {
+                pack(v, messages);
             }
         }
-    }
 
-    Opm::DeferredLogger::Message unpackSingleMessage(const std::vector<char>& recv_buffer, int& offset, const MPI_Comm mpi_communicator)
-    {
-        int64_t flag;
-        auto* data = const_cast<char*>(recv_buffer.data());
-        MPI_Unpack(data, recv_buffer.size(), &offset, &flag, 1, MPI_INT64_T, mpi_communicator);
-
-        // unpack tag
-        unsigned int tagsize;
-        MPI_Unpack(data, recv_buffer.size(), &offset, &tagsize, 1, MPI_UNSIGNED, mpi_communicator);
-        std::string tag;
-        if (tagsize>0) {
-            std::vector<char> tagchars(tagsize);
-            MPI_Unpack(data, recv_buffer.size(), &offset, tagchars.data(), tagsize, MPI_CHAR, mpi_communicator);
-            tag = std::string(tagchars.data(), tagsize);
+        std::vector<char> buf;
+        pack(static_cast<std::uint32_t>(strings.size()), buf);
+        for (const auto* str : strings) {
+            pack(static_cast<std::uint32_t>(str->size()), buf);
+            buf.insert(buf.end(), str->begin(), str->end());
         }
-        // unpack text
-        unsigned int textsize;
-        MPI_Unpack(data, recv_buffer.size(), &offset, &textsize, 1, MPI_UNSIGNED, mpi_communicator);
-        std::string text;
-        if (textsize>0) {
-            std::vector<char> textchars(textsize);
-            MPI_Unpack(data, recv_buffer.size(), &offset, textchars.data(), textsize, MPI_CHAR, mpi_communicator);
-            text = std::string (textchars.data(), textsize);
-        }
-        return Opm::DeferredLogger::Message({flag, tag, text});
+        buf.insert(buf.end(), messages.begin(), messages.end());
+        return buf;
     }
 
-    std::vector<Opm::DeferredLogger::Message> unpackMessages(const std::vector<char>& recv_buffer, const std::vector<int>& displ, const MPI_Comm mpi_communicator)
+    std::vector<Opm::DeferredLogger::Message> unpackMessages(const std::vector<char>& recv_buffer, const std::vector<int>& displ)
     {
         std::vector<Opm::DeferredLogger::Message> messages;
         const int num_processes = displ.size() - 1;
-        auto* data = const_cast<char*>(recv_buffer.data());
         for (int process = 0; process < num_processes; ++process) {
-            int offset = displ[process];
-            // unpack number of messages
-            unsigned int messagesize;
-            MPI_Unpack(data, recv_buffer.size(), &offset, &messagesize, 1, MPI_UNSIGNED, mpi_communicator);
-            for (unsigned int i=0; i<messagesize; i++) {
-                messages.push_back(unpackSingleMessage(recv_buffer, offset, mpi_communicator));
+            std::size_t offset = displ[process];
+
+            const auto num_strings = unpack<std::uint32_t>(recv_buffer, offset);
+            std::vector<std::string> strings(num_strings);
+            for (auto& str : strings) {
+                const auto size = unpack<std::uint32_t>(recv_buffer, offset);
+                str.assign(recv_buffer.data() + offset, size);
+                offset += size;
+            }
+
+            const auto num_messages = unpack<std::uint32_t>(recv_buffer, offset);
+            for (std::uint32_t i = 0; i < num_messages; ++i) {
+                Opm::DeferredLogger::Message message;
+                message.flag = unpack<std::int64_t>(recv_buffer, offset);
+                message.tag = strings.at(unpack<std::uint32_t>(recv_buffer, offset));
+                message.text = strings.at(unpack<std::uint32_t>(recv_buffer, offset));
+                message.values.resize(unpack<std::uint32_t>(recv_buffer, offset));
+                for (auto& v : message.values) {
+                    v = unpack<double>(recv_buffer, offset);
+                }
+                messages.push_back(std::move(message));
             }
-            assert(offset == displ[process + 1]);
+            assert(offset == static_cast<std::size_t>(displ[process + 1]));
         }
         return messages;
     }
@@ -106,56 +135,19 @@ namespace Opm
 
     /// combine (per-process) messages
     Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger,
-                                             Opm::Parallel::Communication mpi_communicator)
+                                             Opm::Parallel::Communication mpi_communicator,
+                                             GatherMethod method)
     {
-
-        int num_messages = local_deferredlogger.messages_.size();
-
-        int int64_mpi_pack_size;
-        MPI_Pack_size(1, MPI_INT64_T, mpi_communicator, &int64_mpi_pack_size);
-        int unsigned_int_mpi_pack_size;
-        MPI_Pack_size(1, MPI_UNSIGNED, mpi_communicator, &unsigned_int_mpi_pack_size);
-
-        // store number of messages;
-        int message_size = unsigned_int_mpi_pack_size;
-        // store 1 int64 per message for flag
-        message_size += num_messages*int64_mpi_pack_size;
-        // store 2 unsigned ints per message for length of tag and length of text
-        message_size += num_messages*2*unsigned_int_mpi_pack_size;
-
-        for (const auto& lm : local_deferredlogger.messages_) {
-            int string_mpi_pack_size;
-            MPI_Pack_size(lm.tag.size(), MPI_CHAR, mpi_communicator, &string_mpi_pack_size);
-            message_size += string_mpi_pack_size;
-            MPI_Pack_size(lm.text.size(), MPI_CHAR, mpi_communicator, &string_mpi_pack_size);
-            message_size += string_mpi_pack_size;
-        }
-
         // Pack local messages.
-        std::vector<char> buffer(message_size);
-
-        int offset = 0;
-        packMessages(local_deferredlogger.messages_, buffer, offset, mpi_communicator);
-        assert(offset == message_size);
-
-        // Get message sizes and create offset/displacement array for gathering.
-        int num_processes = -1;
-        MPI_Comm_size(mpi_communicator, &num_processes);
-        std::vector<int> message_sizes(num_processes);
-        MPI_Allgather(&message_size, 1, MPI_INT, message_sizes.data(), 1, MPI_INT, mpi_communicator);
-        std::vector<int> displ(num_processes + 1, 0);
-        std::partial_sum(message_sizes.begin(), message_sizes.end(), displ.begin() + 1);
+        const auto buffer = packMessages(local_deferredlogger.messages());
 
         // Gather.
-        std::vector<char> recv_buffer(displ.back());
-        MPI_Allgatherv(buffer.data(), buffer.size(), MPI_PACKED,
-                       const_cast<char*>(recv_buffer.data()), message_sizes.data(),
-                       displ.data(), MPI_PACKED,
-                       mpi_communicator);
+        std::vector<int> displ;
+        const auto recv_buffer = allGatherBuffers(buffer, displ, mpi_communicator, method);
 
         // Unpack.
         Opm::DeferredLogger global_deferredlogger;
-        global_deferredlogger.messages_ = unpackMessages(recv_buffer, displ, mpi_communicator);
+        global_deferredlogger.setMessages(unpackMessages(recv_buffer, displ));
         return global_deferredlogger;
     }
 
@@ -166,7 +158,8 @@ namespace Opm
 namespace Opm
 {
     Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger,
-                                             Opm::Parallel::Communication /* dummy communicator */)
+                                             Opm::Parallel::Communication /* dummy communicator */,
+                                             GatherMethod /* method */)
     {
         return local_deferredlogger;
     }
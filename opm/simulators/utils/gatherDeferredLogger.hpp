@@ -22,12 +22,15 @@
 #define OPM_GATHERDEFERREDLOGGER_HEADER_INCLUDED
 
 #include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/utils/TwoLevelGather.hpp>
 
 namespace Opm
 {
 
     /// Create a global log combining local logs
-    Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger, Parallel::Communication communicator);
+    Opm::DeferredLogger gatherDeferredLogger(const Opm::DeferredLogger& local_deferredlogger,
+                                             Parallel::Communication communicator,
+                                             GatherMethod method = GatherMethod::Flat);
 
 } // namespace Opm
 
@@ -78,6 +78,7 @@
 #include <opm/material/densead/Math.hpp>
 
 #include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/utils/TimerTree.hpp>
 
 namespace Opm::Properties {
 
@@ -196,7 +197,7 @@ namespace Opm {
 
             void beginEpisode()
             {
-                OPM_TIMEBLOCK(beginEpsiode);
+                OPM_TIMEBLOCK_TREE(beginEpsiode);
                 beginReportStep(ebosSimulator_.episodeIndex());
             }
 
@@ -204,7 +205,7 @@ namespace Opm {
 
             void beginIteration()
             {
-                OPM_TIMEBLOCK(beginIteration);
+                OPM_TIMEBLOCK_TREE(beginIteration);
                 assemble(ebosSimulator_.model().newtonMethod().numIterations(),
                          ebosSimulator_.timeStepSize());
             }
@@ -214,7 +215,7 @@ namespace Opm {
 
             void endTimeStep()
             {
-                OPM_TIMEBLOCK(endTimeStep);
+                OPM_TIMEBLOCK_TREE(endTimeStep);
                 timeStepSucceeded(ebosSimulator_.time(), ebosSimulator_.timeStepSize());
             }
 
@@ -517,9 +518,17 @@ namespace Opm {
             bool maybeDoGasLiftOptimize(DeferredLogger& deferred_logger);
 
             void gasLiftOptimizationStage1(DeferredLogger& deferred_logger,
+                std::vector<DeferredLogger>& glift_loggers,
                 GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
                 GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map);
 
+            // cannot be const since it accesses the non-const WellState
+            void gasLiftOptimizationStage1Concurrent(
+                std::vector<DeferredLogger>& glift_loggers,
+                GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
+                GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map,
+                GLiftSyncGroups& groups_to_sync);
+
             // cannot be const since it accesses the non-const WellState
             void gasLiftOptimizationStage1SingleWell(WellInterface<TypeTag> *well,
                 DeferredLogger& deferred_logger,
@@ -303,8 +303,21 @@ initializeWellProdIndCalculators()
 
 void
 BlackoilWellModelGeneric::
-initializeWellPerfData()
+initializeWellPerfData(const std::vector<Well>& previousWells)
 {
+    auto previousPerfData = std::move(this->well_perf_data_);
+    auto previousConnIdxMap = std::move(this->conn_idx_map_);
+
+    std::unordered_map<std::string_view, std::size_t> previousIndex;
+    if ((previousPerfData.size() == previousWells.size()) &&
+        (previousConnIdxMap.size() == previousWells.size()))
+    {
+        for (std::size_t i = 0; i < previousWells.size(); ++i) {
+            previousIndex.emplace(previousWells[i].name(), i);
+        }
+    }
+
+    well_perf_data_.clear();
     well_perf_data_.resize(wells_ecl_.size());
 
     this->conn_idx_map_.clear();
@@ -312,6 +325,21 @@ initializeWellPerfData()
 
     int well_index = 0;
     for (const auto& well : wells_ecl_) {
+        const auto previous = previousIndex.find(well.name());
+        if ((previous != previousIndex.end()) &&
+            (previousWells[previous->second].getConnections() == well.getConnections()))
+        {
+            // Connections are unchanged.  The perforations are the same
+            // and so is the parallel well information, whose reset is
+            // collective on the well's communicator.  All processes that
+            // share the well take this branch since the connections are
+            // global.
+            well_perf_data_[well_index] = std::move(previousPerfData[previous->second]);
+            this->conn_idx_map_.push_back(std::move(previousConnIdxMap[previous->second]));
+            ++well_index;
+            continue;
+        }
+
         int connection_index = 0;
 
         // INVALID_ECL_INDEX marks no above perf available
@@ -1292,7 +1320,8 @@ gasLiftOptimizationStage2(DeferredLogger& deferred_logger,
                           GLiftOptWells& glift_wells,
                           GasLiftGroupInfo& group_info,
                           GLiftWellStateMap& glift_well_state_map,
-                          const int episodeIndex)
+                          const int episodeIndex,
+                          const bool concurrent)
 {
     GasLiftStage2 glift {episodeIndex,
                          comm_,
@@ -1305,7 +1334,8 @@ gasLiftOptimizationStage2(DeferredLogger& deferred_logger,
                          glift_wells,
                          group_info,
                          glift_well_state_map,
-                         this->glift_debug
+                         this->glift_debug,
+                         concurrent
     };
     glift.runOptimize();
 }
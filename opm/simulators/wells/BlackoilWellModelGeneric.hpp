@@ -328,7 +328,15 @@ protected:
     std::vector<std::reference_wrapper<ParallelWellInfo>> createLocalParallelWellInfo(const std::vector<Well>& wells);
 
     void initializeWellProdIndCalculators();
-    void initializeWellPerfData();
+
+    /// \brief Set up the perforation data of the local wells
+    /// \param previousWells The local wells the current perforation data
+    ///                      belongs to. Wells whose connections are
+    ///                      unchanged from these keep their perforation
+    ///                      data and parallel well information. The well
+    ///                      objects are still recreated by
+    ///                      createWellContainer().
+    void initializeWellPerfData(const std::vector<Well>& previousWells = {});
 
     bool wasDynamicallyShutThisTimeStep(const int well_index) const;
 
@@ -389,7 +397,8 @@ protected:
                                    GLiftOptWells& glift_wells,
                                    GasLiftGroupInfo& group_info,
                                    GLiftWellStateMap& map,
-                                   const int episodeIndex);
+                                   const int episodeIndex,
+                                   const bool concurrent);
 
     virtual void computePotentials(const std::size_t widx,
                                    const WellState& well_state_copy,
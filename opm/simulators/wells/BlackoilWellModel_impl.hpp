@@ -41,6 +41,7 @@
 #endif
 
 #include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <utility>
 
@@ -291,7 +292,10 @@ namespace Opm {
         const auto& comm = this->ebosSimulator_.vanguard().grid().comm();
 
         // Wells_ecl_ holds this rank's wells, both open and stopped/shut.
-        this->wells_ecl_ = this->getLocalWells(reportStepIdx);
+        // The previous wells are kept to reuse the perforation data of
+        // wells whose connections did not change.
+        const auto previousWells =
+            std::exchange(this->wells_ecl_, this->getLocalWells(reportStepIdx));
         this->local_parallel_well_info_ =
             this->createLocalParallelWellInfo(this->wells_ecl_);
 
@@ -300,7 +304,7 @@ namespace Opm {
         // scope a bit.
         OPM_BEGIN_PARALLEL_TRY_CATCH()
         {
-            this->initializeWellPerfData();
+            this->initializeWellPerfData(previousWells);
             this->initializeWellState(reportStepIdx);
             this->initializeWBPCalculationService();
 
@@ -372,7 +376,7 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     beginTimeStep()
     {
-        OPM_TIMEBLOCK(beginTimeStep);
+        OPM_TIMEBLOCK_TREE(beginTimeStep);
 
         this->updateAverageFormationFactor();
 
@@ -805,6 +809,12 @@ namespace Opm {
 
         const int nw = numLocalWells();
 
+        // All well objects are recreated, also those of wells whose
+        // structure did not change since the last time step.  Only their
+        // perforation data is kept, see initializeWellPerfData().  Reusing
+        // the objects would need a reset that restores the state set up
+        // by construction, such as the well indices of closed completions,
+        // the stopped status and the operability flags.
         well_container_.clear();
 
         if (nw > 0) {
@@ -1097,7 +1107,7 @@ namespace Opm {
     assemble(const int iterationIdx,
              const double dt)
     {
-
+        OPM_TIMEBLOCK_TREE(assembleWells);
         DeferredLogger local_deferredLogger;
         if (this->glift_debug) {
             const std::string msg = fmt::format(
@@ -1288,6 +1298,15 @@ namespace Opm {
         }
 
         if (do_glift_optimization) {
+            // One logger per well when the wells are optimized concurrently,
+            // see gasLiftOptimizationStage1Concurrent(). They must outlive
+            // glift_wells, whose members log to them. The concurrent path is
+            // taken for any number of threads, so that the order of the log
+            // messages does not depend on it.
+            std::vector<DeferredLogger> glift_loggers;
+            if (!this->glift_debug) {
+                glift_loggers.resize(well_container_.size());
+            }
             GLiftOptWells glift_wells;
             GLiftProdWells prod_wells;
             GLiftWellStateMap state_map;
@@ -1315,12 +1334,15 @@ namespace Opm {
             };
             group_info.initialize();
             gasLiftOptimizationStage1(
-                deferred_logger, prod_wells, glift_wells, group_info, state_map);
+                deferred_logger, glift_loggers, prod_wells, glift_wells, group_info, state_map);
             gasLiftOptimizationStage2(
                 deferred_logger, prod_wells, glift_wells, group_info, state_map,
-                ebosSimulator_.episodeIndex());
+                ebosSimulator_.episodeIndex(), /*concurrent=*/!glift_loggers.empty());
             if (this->glift_debug) gliftDebugShowALQ(deferred_logger);
             num_wells_changed = glift_wells.size();
+            for (const auto& logger : glift_loggers) {
+                deferred_logger.append(logger);
+            }
         }
         num_wells_changed = this->comm_.sum(num_wells_changed);
         return num_wells_changed > 0;
@@ -1330,6 +1352,7 @@ namespace Opm {
     void
     BlackoilWellModel<TypeTag>::
     gasLiftOptimizationStage1(DeferredLogger& deferred_logger,
+        std::vector<DeferredLogger>& glift_loggers,
         GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
         GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map)
     {
@@ -1365,13 +1388,21 @@ namespace Opm {
             GLiftSyncGroups groups_to_sync;
             if (comm.rank() ==  i) {
                 // Run stage1: Optimize single wells while also checking group limits
-                for (const auto& well : well_container_) {
-                    // NOTE: Only the wells in "group_info" needs to be optimized
-                    if (group_info.hasWell(well->name())) {
-                        gasLiftOptimizationStage1SingleWell(
-                            well.get(), deferred_logger, prod_wells, glift_wells,
-                            group_info, state_map, groups_to_sync
-                        );
+                if (!glift_loggers.empty()) {
+                    gasLiftOptimizationStage1Concurrent(
+                        glift_loggers, prod_wells, glift_wells,
+                        group_info, state_map, groups_to_sync
+                    );
+                }
+                else {
+                    for (const auto& well : well_container_) {
+                        // NOTE: Only the wells in "group_info" needs to be optimized
+                        if (group_info.hasWell(well->name())) {
+                            gasLiftOptimizationStage1SingleWell(
+                                well.get(), deferred_logger, prod_wells, glift_wells,
+                                group_info, state_map, groups_to_sync
+                            );
+                        }
                     }
                 }
                 num_rates_to_sync = groups_to_sync.size();
@@ -1458,6 +1489,85 @@ namespace Opm {
     }
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    gasLiftOptimizationStage1Concurrent(std::vector<DeferredLogger>& glift_loggers,
+        GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
+        GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map,
+        GLiftSyncGroups& groups_to_sync)
+    {
+        // A well without any group limit only affects the other wells through
+        // the group rates it adds to, which no limited well reads. Such wells
+        // are optimized concurrently with their updates deferred. The updates
+        // are then applied in the order of well_container_, interleaved with
+        // the serial optimization of the other wells, which gives the same
+        // result as optimizing all wells in order. Wells distributed over
+        // several processes are optimized serially as they communicate.
+        const auto& summary_state = ebosSimulator_.vanguard().summaryState();
+        const int iteration_idx = ebosSimulator_.model().newtonMethod().numIterations();
+        const int num_wells = well_container_.size();
+        std::vector<std::unique_ptr<GasLiftSingleWell>> glifts(num_wells);
+        std::vector<int> concurrent;
+        for (int w = 0; w < num_wells; ++w) {
+            const auto& well = well_container_[w];
+            if (!group_info.hasWell(well->name())) {
+                continue;
+            }
+            glifts[w] = std::make_unique<GasLiftSingleWell>(
+                *well, ebosSimulator_, summary_state,
+                glift_loggers[w], this->wellState(), this->groupState(),
+                group_info, groups_to_sync, this->comm_, this->glift_debug);
+            if (!group_info.hasAnyGroupLimit(well->name()) &&
+                well->parallelWellInfo().communication().size() == 1)
+            {
+                glifts[w]->deferUpdates();
+                concurrent.push_back(w);
+            }
+        }
+
+        std::vector<std::unique_ptr<GasLiftWellState>> states(num_wells);
+        std::vector<std::exception_ptr> errors(num_wells);
+        const int num_concurrent = concurrent.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < num_concurrent; ++i) {
+            const int w = concurrent[i];
+            try {
+                states[w] = glifts[w]->runOptimize(iteration_idx);
+            }
+            catch (...) {
+                errors[w] = std::current_exception();
+            }
+        }
+
+        auto next_concurrent = concurrent.begin();
+        for (int w = 0; w < num_wells; ++w) {
+            if (!glifts[w]) {
+                continue;
+            }
+            if (next_concurrent != concurrent.end() && *next_concurrent == w) {
+                ++next_concurrent;
+                if (errors[w]) {
+                    std::rethrow_exception(errors[w]);
+                }
+                glifts[w]->commitDeferredUpdates();
+            }
+            else {
+                states[w] = glifts[w]->runOptimize(iteration_idx);
+            }
+            const auto& name = well_container_[w]->name();
+            if (states[w]) {
+                state_map.insert({name, std::move(states[w])});
+                glift_wells.insert({name, std::move(glifts[w])});
+            }
+            else {
+                prod_wells.insert({name, well_container_[w].get()});
+            }
+        }
+    }
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -1836,8 +1946,9 @@ namespace Opm {
         }
 
         const Opm::Parallel::Communication comm = grid().comm();
-        DeferredLogger global_deferredLogger = gatherDeferredLogger(local_deferredLogger, comm);
-        ConvergenceReport report = gatherConvergenceReport(local_report, comm);
+        auto [report, global_deferredLogger] =
+            gatherConvergenceReportAndLogger(local_report, local_deferredLogger,
+                                             comm, param_.gather_method_);
 
         // the well_group_control_changed info is already communicated
         if (checkWellGroupControls) {
@@ -1884,6 +1995,7 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     updateWellControls(const bool mandatory_network_balance, DeferredLogger& deferred_logger, const bool relax_network_tolerance)
     {
+        OPM_TIMEBLOCK_TREE(updateWellControls);
         const int episodeIdx = ebosSimulator_.episodeIndex();
         const auto& network = schedule()[episodeIdx].network();
         if (!wellsActive() && !network.active()) {
@@ -210,6 +210,18 @@ hasAnyTarget(const std::string& group_name) const
         || waterTarget(group_name) || liquidTarget(group_name);
 }
 
+bool
+GasLiftGroupInfo::
+hasAnyGroupLimit(const std::string& well_name)
+{
+    for (const auto& [group_name, efficiency] : getWellGroups(well_name)) {
+        (void)efficiency;
+        if (hasAnyTarget(group_name) || maxAlq(group_name) || maxTotalGasRate(group_name))
+            return true;
+    }
+    return false;
+}
+
 bool
 GasLiftGroupInfo::
 hasWell(const std::string& well_name)
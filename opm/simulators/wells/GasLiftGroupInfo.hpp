@@ -101,6 +101,9 @@ public:
         Rate rate_type, const std::string& group_name) const;
     const std::string& groupIdxToName(int group_idx) const;
     bool hasAnyTarget(const std::string& group_name) const;
+    // Returns true if any group of the well has a rate target, an ALQ
+    // limit or a total gas limit.
+    bool hasAnyGroupLimit(const std::string& well_name);
     bool hasWell(const std::string& well_name);
     void initialize();
     std::optional<double> liquidTarget(const std::string& group_name) const;
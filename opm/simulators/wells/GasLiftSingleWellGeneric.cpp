@@ -149,7 +149,6 @@ GasLiftSingleWellGeneric::runOptimize(const int iteration_idx)
                 double alq = state->alq();
                 if (this->debug)
                     logSuccess_(alq, iteration_idx);
-                this->well_state_.setALQ(this->well_name_, alq);
                 const auto& pu = this->phase_usage_;
                 std::vector<double> well_pot(pu.num_phases, 0.0);
                 if (pu.phase_used[BlackoilPhases::PhaseIndex::Liquid])
@@ -159,13 +158,42 @@ GasLiftSingleWellGeneric::runOptimize(const int iteration_idx)
                 if (pu.phase_used[BlackoilPhases::PhaseIndex::Vapour])
                     well_pot[pu.phase_pos[BlackoilPhases::PhaseIndex::Vapour]] = state->gasRate();
 
-                this->well_state_[this->well_name_].well_potentials = well_pot;
+                if (this->defer_updates_) {
+                    this->deferred_alq_update_.emplace(alq, std::move(well_pot));
+                } else {
+                    this->well_state_.setALQ(this->well_name_, alq);
+                    this->well_state_[this->well_name_].well_potentials = well_pot;
+                }
             }
         }
     }
     return state;
 }
 
+void
+GasLiftSingleWellGeneric::commitDeferredUpdates()
+{
+    for (const auto& update : this->deferred_group_updates_) {
+        this->sync_groups_.insert(this->group_info_.getGroupIdx(update.group_name));
+        this->group_info_.update(update.group_name,
+                                 update.delta_oil,
+                                 update.delta_gas,
+                                 update.delta_water,
+                                 update.delta_alq);
+    }
+    if (this->deferred_alq_count_update_) {
+        this->well_state_.gliftUpdateAlqIncreaseCount(this->well_name_, *this->deferred_alq_count_update_);
+    }
+    if (this->deferred_alq_update_) {
+        this->well_state_.setALQ(this->well_name_, this->deferred_alq_update_->first);
+        this->well_state_[this->well_name_].well_potentials = this->deferred_alq_update_->second;
+    }
+    this->deferred_group_updates_.clear();
+    this->deferred_alq_count_update_.reset();
+    this->deferred_alq_update_.reset();
+    this->defer_updates_ = false;
+}
+
 /****************************************
  * Protected methods in alphabetical order
  ****************************************/
@@ -1247,7 +1275,10 @@ GasLiftSingleWellGeneric::runOptimizeLoop_(bool increase)
     }
     std::optional<bool> increase_opt;
     if (success) {
-        this->well_state_.gliftUpdateAlqIncreaseCount(this->well_name_, increase);
+        if (this->defer_updates_)
+            this->deferred_alq_count_update_ = increase;
+        else
+            this->well_state_.gliftUpdateAlqIncreaseCount(this->well_name_, increase);
         increase_opt = increase;
     } else {
         increase_opt = std::nullopt;
@@ -1351,6 +1382,14 @@ GasLiftSingleWellGeneric::updateGroupRates_(const LimitedRates& rates,
     double delta_water = new_rates.water - rates.water;
     const auto& pairs = this->group_info_.getWellGroups(this->well_name_);
     for (const auto& [group_name, efficiency] : pairs) {
+        if (this->defer_updates_) {
+            this->deferred_group_updates_.push_back({group_name,
+                                                     efficiency * delta_oil,
+                                                     efficiency * delta_gas,
+                                                     efficiency * delta_water,
+                                                     efficiency * delta_alq});
+            continue;
+        }
         int idx = this->group_info_.getGroupIdx(group_name);
         // This will notify the optimize loop in BlackoilWellModel, see
         //   gasLiftOptimizationStage1() in BlackoilWellModel_impl.hpp
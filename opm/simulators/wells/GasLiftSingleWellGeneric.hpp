@@ -103,6 +103,14 @@ public:
 
     std::unique_ptr<GasLiftWellState> runOptimize(const int iteration_idx);
 
+    // Record the updates of the group rates and of the well state made by
+    // runOptimize() instead of applying them. This allows wells that are not
+    // affected by any group limit to be optimized concurrently. The updates
+    // are applied by commitDeferredUpdates(), which must be called for the
+    // wells in the same order as the serial optimization.
+    void deferUpdates() { this->defer_updates_ = true; }
+    void commitDeferredUpdates();
+
     virtual const WellInterfaceGeneric& getWell() const = 0;
 
 protected:
@@ -362,6 +370,19 @@ protected:
 
     bool optimize_;
     bool debug_limit_increase_decrease_;
+
+    struct GroupRateUpdate
+    {
+        std::string group_name;
+        double delta_oil;
+        double delta_gas;
+        double delta_water;
+        double delta_alq;
+    };
+    bool defer_updates_ = false;
+    mutable std::vector<GroupRateUpdate> deferred_group_updates_;
+    std::optional<bool> deferred_alq_count_update_;
+    std::optional<std::pair<double, std::vector<double>>> deferred_alq_update_;
     bool debug_abort_if_decrease_and_oil_is_limited_ = false;
     bool debug_abort_if_increase_and_gas_is_limited_ = false;
 };
@@ -26,6 +26,7 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/wells/GasLiftSingleWellGeneric.hpp>
 #include <opm/simulators/wells/GasLiftWellState.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/simulators/wells/GasLiftGroupInfo.hpp>
@@ -34,6 +35,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <exception>
 #include <optional>
 #include <string>
 
@@ -51,7 +53,8 @@ GasLiftStage2::GasLiftStage2(
     GLiftOptWells &glift_wells,
     GasLiftGroupInfo& group_info,
     GLiftWellStateMap &state_map,
-    bool glift_debug
+    bool glift_debug,
+    bool concurrent
 ) :
     GasLiftCommon(well_state, group_state, deferred_logger, comm, glift_debug)
     , prod_wells_{prod_wells}
@@ -62,6 +65,7 @@ GasLiftStage2::GasLiftStage2(
     , summary_state_{summary_state}
     , schedule_{schedule}
     , glo_{schedule_.glo(report_step_idx_)}
+    , concurrent_{concurrent}
 {
 //    this->time_step_idx_
 //        = this->ebos_simulator_.model().newtonMethod().currentTimeStep();
@@ -781,18 +785,59 @@ GasLiftStage2::OptimizeState::
 calculateEcoGradients(std::vector<GasLiftSingleWell *> &wells,
            std::vector<GradPair> &inc_grads, std::vector<GradPair> &dec_grads)
 {
-    for (auto well_ptr : wells) {
-        const auto &gs_well = *well_ptr;  // gs = GasLiftSingleWell
+    // The gradients of the wells do not depend on each other. If each well
+    // logs to its own logger they are computed concurrently, and then stored
+    // in the order of the wells. The rates of wells distributed over several
+    // processes are evaluated collectively, so their gradients are computed
+    // serially afterwards, in the same order on all processes.
+    const int num_wells = wells.size();
+    std::vector<std::optional<GradInfo>> inc_grad(num_wells);
+    std::vector<std::optional<GradInfo>> dec_grad(num_wells);
+    std::vector<std::exception_ptr> errors(num_wells);
+    std::vector<int> concurrent;
+    std::vector<int> serial;
+    for (int i = 0; i < num_wells; ++i) {
+        const bool distributed =
+            wells[i]->getWell().parallelWellInfo().communication().size() > 1;
+        if (this->parent.concurrent_ && !distributed)
+            concurrent.push_back(i);
+        else
+            serial.push_back(i);
+    }
+    const auto calcGradients = [this, &wells, &inc_grad, &dec_grad, &errors](const int i)
+    {
+        const auto &gs_well = *wells[i];  // gs = GasLiftSingleWell
         const auto &name = gs_well.name();
-        auto inc_grad = this->parent.calcIncOrDecGrad_(name, gs_well, group.name(), /*increase=*/true);
-        if (inc_grad) {
-            inc_grads.emplace_back(std::make_pair(name, inc_grad->grad));
-            this->parent.saveIncGrad_(name, *inc_grad);
+        try {
+            inc_grad[i] = this->parent.calcIncOrDecGrad_(name, gs_well, group.name(), /*increase=*/true);
+            dec_grad[i] = this->parent.calcIncOrDecGrad_(name, gs_well, group.name(), /*increase=*/false);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    const int num_concurrent = concurrent.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < num_concurrent; ++c) {
+        calcGradients(concurrent[c]);
+    }
+    for (const int i : serial) {
+        calcGradients(i);
+    }
+    for (int i = 0; i < num_wells; ++i) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+        const auto &name = wells[i]->name();
+        if (inc_grad[i]) {
+            inc_grads.emplace_back(std::make_pair(name, inc_grad[i]->grad));
+            this->parent.saveIncGrad_(name, *inc_grad[i]);
         }
-        auto dec_grad = this->parent.calcIncOrDecGrad_(name, gs_well, group.name(), /*increase=*/false);
-        if (dec_grad) {
-            dec_grads.emplace_back(std::make_pair(name, dec_grad->grad));
-            this->parent.saveDecGrad_(name, *dec_grad);
+        if (dec_grad[i]) {
+            dec_grads.emplace_back(std::make_pair(name, dec_grad[i]->grad));
+            this->parent.saveDecGrad_(name, *dec_grad[i]);
         }
     }
 }
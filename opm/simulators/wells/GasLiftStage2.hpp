@@ -72,7 +72,8 @@ public:
         GLiftOptWells& glift_wells,
         GasLiftGroupInfo& group_info,
         GLiftWellStateMap& state_map,
-        bool glift_debug
+        bool glift_debug,
+        bool concurrent = false
     );
     void runOptimize();
 protected:
@@ -130,6 +131,7 @@ protected:
     const SummaryState& summary_state_;
     const Schedule& schedule_;
     const GasLiftOpt& glo_;
+    bool concurrent_;
     GradMap inc_grads_;
     GradMap dec_grads_;
     int max_iterations_ = 1000;
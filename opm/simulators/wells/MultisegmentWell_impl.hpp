@@ -362,7 +362,11 @@ namespace Opm
                 }
             }
         }
-        this->parallel_well_info_.communication().sum(well_flux.data(), well_flux.size());
+        // Wells on a single process may be evaluated concurrently by the gas
+        // lift optimization and must not communicate.
+        if (this->parallel_well_info_.communication().size() > 1) {
+            this->parallel_well_info_.communication().sum(well_flux.data(), well_flux.size());
+        }
     }
 
 
@@ -1383,11 +1387,16 @@ namespace Opm
 
         // TODO: we should decide whether to keep the updated well_state, or recover to use the old well_state
         if (converged) {
-            std::ostringstream sstr;
-            sstr << "     Well " << this->name() << " converged in " << it << " inner iterations.";
-            if (relax_convergence)
-                sstr << "      (A relaxed tolerance was used after "<< this->param_.strict_inner_iter_wells_ << " iterations)";
-            deferred_logger.debug(sstr.str());
+            if (relax_convergence) {
+                deferred_logger.message(Log::MessageType::Debug, "",
+                                        "     Well " + this->name() + " converged in {} inner iterations."
+                                        "      (A relaxed tolerance was used after {} iterations)",
+                                        {double(it), double(this->param_.strict_inner_iter_wells_)});
+            } else {
+                deferred_logger.message(Log::MessageType::Debug, "",
+                                        "     Well " + this->name() + " converged in {} inner iterations.",
+                                        {double(it)});
+            }
         } else {
             std::ostringstream sstr;
             sstr << "     Well " << this->name() << " did not converge in " << it << " inner iterations.";
@@ -1569,17 +1578,20 @@ namespace Opm
                 // on the outside based on operability status
                 this->wellStatus_ = well_status;
             }
-            std::string message = fmt::format("   Well {} converged in {} inner iterations ("
-                                                    "{} control/status switches).", this->name(), it, switch_count);
             if (relax_convergence) {
-                message.append(fmt::format("   (A relaxed tolerance was used after {} iterations)",
-                                           this->param_.strict_inner_iter_wells_));
+                deferred_logger.message(Log::MessageType::Debug, "",
+                                        "   Well " + this->name() + " converged in {} inner iterations ("
+                                        "{} control/status switches).   (A relaxed tolerance was used after {} iterations)",
+                                        {double(it), double(switch_count), double(this->param_.strict_inner_iter_wells_)});
+            } else {
+                deferred_logger.message(Log::MessageType::Debug, "",
+                                        "   Well " + this->name() + " converged in {} inner iterations ("
+                                        "{} control/status switches).", {double(it), double(switch_count)});
             }
-            deferred_logger.debug(message);
         } else {
-            const std::string message = fmt::format("   Well {} did not converged in {} inner iterations ("
-                                                    "{} control/status switches).", this->name(), it, switch_count);
-            deferred_logger.debug(message);
+            deferred_logger.message(Log::MessageType::Debug, "",
+                                    "   Well " + this->name() + " did not converged in {} inner iterations ("
+                                    "{} control/status switches).", {double(it), double(switch_count)});
         }
 
         return converged;
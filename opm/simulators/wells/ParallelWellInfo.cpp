@@ -476,10 +476,10 @@ void ParallelWellInfo::endReset()
 }
 
 template<typename It>
-typename It::value_type
+typename std::iterator_traits<It>::value_type
 ParallelWellInfo::sumPerfValues(It begin, It end) const
 {
-    using V = typename It::value_type;
+    using V = typename std::iterator_traits<It>::value_type;
     /// \todo cater for overlap later. Currently only owner
     auto local = std::accumulate(begin, end, V());
     return communication().sum(local);
@@ -488,6 +488,7 @@ ParallelWellInfo::sumPerfValues(It begin, It end) const
 using cdIter = typename std::vector<double>::const_iterator;
 template typename cdIter::value_type ParallelWellInfo::sumPerfValues<cdIter>(cdIter,cdIter) const;
 template typename dIter::value_type ParallelWellInfo::sumPerfValues<dIter>(dIter,dIter) const;
+template double ParallelWellInfo::sumPerfValues<const double*>(const double*,const double*) const;
 
 void ParallelWellInfo::clear()
 {
@@ -27,6 +27,7 @@
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <iterator>
 #include <memory>
 
 namespace Opm
@@ -278,7 +279,7 @@ public:
 
     /// \brief Sum all the values of the perforations
     template<typename It>
-    typename It::value_type sumPerfValues(It begin, It end) const;
+    typename std::iterator_traits<It>::value_type sumPerfValues(It begin, It end) const;
 
     /// \brief Do a (in place) partial sum on values attached to all perforations.
     ///
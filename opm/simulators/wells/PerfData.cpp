@@ -25,6 +25,45 @@
 #include <opm/simulators/wells/ConnFiltrateData.hpp>
 #include <opm/simulators/wells/PerfData.hpp>
 
+namespace {
+
+// Copy one field of all wells into a new contiguous array, bind the
+// wells to it and replace the storage.  Fields whose size does not
+// match the well's perforation count (times stride) keep their own
+// values, e.g. the injector-only fields of producers.  Such fields are
+// detached in case they view the previous storage.
+template<class T>
+void bindField(std::vector<T>& storage,
+               const std::vector<Opm::PerfData*>& wells,
+               Opm::PerfVector<T> Opm::PerfData::* field,
+               const std::vector<std::size_t>& offsets,
+               std::size_t stride)
+{
+    std::vector<T> values(offsets.back() * stride);
+    std::vector<bool> bound(wells.size(), false);
+    for (std::size_t w = 0; w < wells.size(); ++w) {
+        const auto& vec = wells[w]->*field;
+        const auto size = (offsets[w + 1] - offsets[w]) * stride;
+        if (size > 0 && vec.size() == size) {
+            std::copy(vec.begin(), vec.end(), values.begin() + offsets[w] * stride);
+            bound[w] = true;
+        }
+    }
+
+    for (std::size_t w = 0; w < wells.size(); ++w) {
+        if (bound[w]) {
+            (wells[w]->*field).bind(values.data() + offsets[w] * stride);
+        } else {
+            (wells[w]->*field).detach();
+        }
+    }
+
+    // The previous storage may still be viewed until this point.
+    storage.swap(values);
+}
+
+} // Anonymous namespace
+
 namespace Opm {
 
 PerfData::PerfData(std::size_t num_perf, double pressure_first_connection_, bool injector_, std::size_t num_phases)
@@ -134,4 +173,89 @@ bool PerfData::operator==(const PerfData& rhs) const
            this->filtrate_data == rhs.filtrate_data;
 }
 
+template<class Storage, class Func>
+void PerfDataStorage::forEachField(Storage& storage, std::size_t num_phases, Func&& f)
+{
+    f(storage.pressure_, &PerfData::pressure, 1);
+    f(storage.rates_, &PerfData::rates, 1);
+    f(storage.phase_rates_, &PerfData::phase_rates, num_phases);
+    f(storage.phase_mixing_rates_, &PerfData::phase_mixing_rates, 1);
+    f(storage.solvent_rates_, &PerfData::solvent_rates, 1);
+    f(storage.polymer_rates_, &PerfData::polymer_rates, 1);
+    f(storage.brine_rates_, &PerfData::brine_rates, 1);
+    f(storage.prod_index_, &PerfData::prod_index, num_phases);
+    f(storage.micp_rates_, &PerfData::micp_rates, 1);
+    f(storage.cell_index_, &PerfData::cell_index, 1);
+    f(storage.connection_transmissibility_factor_,
+      &PerfData::connection_transmissibility_factor, 1);
+    f(storage.connection_d_factor_, &PerfData::connection_d_factor, 1);
+    f(storage.satnum_id_, &PerfData::satnum_id, 1);
+    f(storage.ecl_index_, &PerfData::ecl_index, 1);
+    f(storage.water_throughput_, &PerfData::water_throughput, 1);
+    f(storage.skin_pressure_, &PerfData::skin_pressure, 1);
+    f(storage.water_velocity_, &PerfData::water_velocity, 1);
+}
+
+void PerfDataStorage::bind(const std::vector<PerfData*>& wells,
+                           std::size_t num_phases)
+{
+    std::vector<std::size_t> offsets(wells.size() + 1, 0);
+    for (std::size_t w = 0; w < wells.size(); ++w) {
+        offsets[w + 1] = offsets[w] + wells[w]->size();
+    }
+
+    forEachField(*this, num_phases,
+                 [&wells, &offsets](auto& storage, auto field, std::size_t stride)
+                 {
+                     bindField(storage, wells, field, offsets, stride);
+                 });
+
+    this->offsets_.swap(offsets);
+    this->num_phases_ = num_phases;
+}
+
+bool PerfDataStorage::isBound(std::size_t well_index, const PerfData& perf_data) const
+{
+    if (well_index >= this->numWells()) {
+        return false;
+    }
+
+    const auto num_perf = this->offsets_[well_index + 1] - this->offsets_[well_index];
+    return perf_data.size() == num_perf &&
+           (num_perf == 0 || perf_data.pressure.data() == this->pressure_.data() + this->offsets_[well_index]);
+}
+
+bool PerfDataStorage::isBound(const std::vector<const PerfData*>& wells,
+                              std::size_t num_phases) const
+{
+    if (wells.size() != this->numWells() || num_phases != this->num_phases_) {
+        return false;
+    }
+
+    for (std::size_t w = 0; w < wells.size(); ++w) {
+        if (wells[w]->size() != this->offsets_[w + 1] - this->offsets_[w]) {
+            return false;
+        }
+    }
+
+    // A field of the bound size must view its place in the storage, any
+    // other field must own its values.
+    bool bound = true;
+    forEachField(*this, num_phases,
+                 [&wells, &bound, this](const auto& storage, auto field, std::size_t stride)
+                 {
+                     for (std::size_t w = 0; bound && w < wells.size(); ++w) {
+                         const auto& vec = wells[w]->*field;
+                         const auto size = (this->offsets_[w + 1] - this->offsets_[w]) * stride;
+                         if (size > 0 && vec.size() == size) {
+                             bound = vec.data() == storage.data() + this->offsets_[w] * stride;
+                         } else {
+                             bound = !vec.isView();
+                         }
+                     }
+                 });
+
+    return bound;
+}
+
 }
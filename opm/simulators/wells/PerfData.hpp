@@ -23,12 +23,197 @@
 
 #include <opm/simulators/wells/ConnFiltrateData.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
 #include <vector>
-#include <array>
 
 namespace Opm {
 
+/// Vector of per-perforation values of a single well.
+///
+/// The values are either owned by the object, or they are a view into
+/// contiguous storage shared by all wells of a WellState, see
+/// PerfDataStorage.  Copies always own their values, while assignment
+/// of an equally sized vector writes through to the existing storage.
+/// That way, assigning well states never detaches a well from the
+/// shared storage.  Assigning a vector of a different size makes the
+/// object own its values, and moving a view yields a view of the same
+/// storage.
+template<class T>
+class PerfVector
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    PerfVector() = default;
+
+    explicit PerfVector(std::size_t size, const T& value = T{})
+        : own_(size, value)
+    { this->reset(); }
+
+    PerfVector(std::initializer_list<T> values)
+        : own_(values)
+    { this->reset(); }
+
+    PerfVector(const PerfVector& other)
+        : own_(other.begin(), other.end())
+    { this->reset(); }
+
+    PerfVector(PerfVector&& other) noexcept
+        : own_(std::move(other.own_))
+        , data_(other.data_)
+        , size_(other.size_)
+    { other.release(); }
+
+    PerfVector& operator=(const PerfVector& other)
+    {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    // Not noexcept, writing through or detaching from a view copies.
+    PerfVector& operator=(PerfVector&& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+        if (other.isView() || (this->isView() && this->size_ == other.size_)) {
+            this->assign(other.begin(), other.end());
+        } else {
+            this->own_ = std::move(other.own_);
+            this->reset();
+            other.release();
+        }
+        return *this;
+    }
+
+    PerfVector& operator=(std::initializer_list<T> values)
+    {
+        this->assign(values.begin(), values.end());
+        return *this;
+    }
+
+    template<class It, class = std::enable_if_t<!std::is_integral_v<It>>>
+    void assign(It first, It last)
+    {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n == this->size_) {
+            std::copy(first, last, this->data_);
+        } else {
+            std::vector<T> values(first, last);
+            this->own_.swap(values);
+            this->reset();
+        }
+    }
+
+    void assign(std::size_t n, const T& value)
+    {
+        if (n == this->size_) {
+            std::fill_n(this->data_, n, value);
+        } else {
+            this->own_.assign(n, value);
+            this->reset();
+        }
+    }
+
+    void resize(std::size_t n)
+    {
+        if (n != this->size_) {
+            std::vector<T> values(this->begin(), this->begin() + std::min(n, this->size_));
+            values.resize(n);
+            this->own_.swap(values);
+            this->reset();
+        }
+    }
+
+    /// Make the vector a view of external storage holding size() values.
+    /// The current values are not copied.
+    void bind(T* data)
+    {
+        this->data_ = data;
+        std::vector<T>().swap(this->own_);
+    }
+
+    /// Copy the values of a view into storage owned by the vector.
+    void detach()
+    {
+        if (this->isView()) {
+            this->own_.assign(this->begin(), this->end());
+            this->reset();
+        }
+    }
+
+    /// Returns true if the values live in external storage.
+    bool isView() const
+    { return this->data_ != this->own_.data(); }
+
+    std::size_t size() const { return this->size_; }
+    bool empty() const { return this->size_ == 0; }
+
+    T* data() { return this->data_; }
+    const T* data() const { return this->data_; }
+
+    T& operator[](std::size_t i) { return this->data_[i]; }
+    const T& operator[](std::size_t i) const { return this->data_[i]; }
+
+    T& front() { return this->data_[0]; }
+    const T& front() const { return this->data_[0]; }
+    T& back() { return this->data_[this->size_ - 1]; }
+    const T& back() const { return this->data_[this->size_ - 1]; }
+
+    iterator begin() { return this->data_; }
+    iterator end() { return this->data_ + this->size_; }
+    const_iterator begin() const { return this->data_; }
+    const_iterator end() const { return this->data_ + this->size_; }
+
+    bool operator==(const PerfVector& rhs) const
+    {
+        return this->size_ == rhs.size_ &&
+               std::equal(this->begin(), this->end(), rhs.begin());
+    }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        if (serializer.isSerializing()) {
+            std::vector<T> values(this->begin(), this->end());
+            serializer(values);
+        } else {
+            std::vector<T> values;
+            serializer(values);
+            this->assign(values.begin(), values.end());
+        }
+    }
+
+private:
+    void reset()
+    {
+        this->data_ = this->own_.data();
+        this->size_ = this->own_.size();
+    }
+
+    void release()
+    {
+        this->own_.clear();
+        this->reset();
+    }
+
+    std::vector<T> own_;
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
 class PerfData
 {
 private:
@@ -71,30 +256,113 @@ public:
     bool operator==(const PerfData&) const;
 
     double pressure_first_connection{};
-    std::vector<double> pressure;
-    std::vector<double> rates;
-    std::vector<double> phase_rates;
-    std::vector<std::array<double,4>> phase_mixing_rates;
-    std::vector<double> solvent_rates;
-    std::vector<double> polymer_rates;
-    std::vector<double> brine_rates;
-    std::vector<double> prod_index;
-    std::vector<double> micp_rates;
-    std::vector<std::size_t> cell_index;
-    std::vector<double> connection_transmissibility_factor;
-    std::vector<double> connection_d_factor;
-    std::vector<int> satnum_id;
-    std::vector<std::size_t> ecl_index;
+    PerfVector<double> pressure;
+    PerfVector<double> rates;
+    PerfVector<double> phase_rates;
+    PerfVector<std::array<double,4>> phase_mixing_rates;
+    PerfVector<double> solvent_rates;
+    PerfVector<double> polymer_rates;
+    PerfVector<double> brine_rates;
+    PerfVector<double> prod_index;
+    PerfVector<double> micp_rates;
+    PerfVector<std::size_t> cell_index;
+    PerfVector<double> connection_transmissibility_factor;
+    PerfVector<double> connection_d_factor;
+    PerfVector<int> satnum_id;
+    PerfVector<std::size_t> ecl_index;
 
     // The water_throughput, skin_pressure and water_velocity variables are only
     // used for injectors to check the injectivity.
-    std::vector<double> water_throughput;
-    std::vector<double> skin_pressure;
-    std::vector<double> water_velocity;
+    PerfVector<double> water_throughput;
+    PerfVector<double> skin_pressure;
+    PerfVector<double> water_velocity;
 
     ConnFiltrateData filtrate_data;
 };
 
+/// Contiguous, field-major storage of the perforation data of a set of
+/// wells.
+///
+/// Every perforation quantity of all wells is kept in a single array,
+/// where the values of a well start at its global perforation offset
+/// (times the number of phases for per-phase quantities).  The
+/// PerfVector members of the bound wells are views into these arrays,
+/// so the per-well accessors are unchanged.  Copies of the storage are
+/// empty since copied wells own their values, the owner of the wells
+/// binds them again, see WellState.  Moving the storage keeps the
+/// arrays, so the views stay valid.  The filtrate data are not part of
+/// the shared storage.
+class PerfDataStorage
+{
+public:
+    PerfDataStorage() = default;
+    PerfDataStorage(const PerfDataStorage&) {}
+    PerfDataStorage(PerfDataStorage&&) = default;
+    PerfDataStorage& operator=(const PerfDataStorage&) { return *this; }
+    PerfDataStorage& operator=(PerfDataStorage&&) = default;
+
+    /// Move the values of the given wells into contiguous storage and
+    /// make the wells views of it.  May be called repeatedly, e.g.
+    /// after wells have been added or resized.
+    void bind(const std::vector<PerfData*>& wells, std::size_t num_phases);
+
+    /// Number of wells bound to the storage.
+    std::size_t numWells() const
+    { return this->offsets_.empty() ? 0 : this->offsets_.size() - 1; }
+
+    /// Total number of perforations of all bound wells.
+    std::size_t numPerfs() const
+    { return this->offsets_.empty() ? 0 : this->offsets_.back(); }
+
+    /// Global perforation offset of a bound well.
+    std::size_t offset(std::size_t well_index) const
+    { return this->offsets_[well_index]; }
+
+    /// Returns true if the well is still a view of this storage.
+    bool isBound(std::size_t well_index, const PerfData& perf_data) const;
+
+    /// Returns true if the given wells are exactly the bound wells, with
+    /// unchanged perforation counts and every bound field still a view
+    /// of this storage.  Otherwise, bind() must be called again.
+    bool isBound(const std::vector<const PerfData*>& wells,
+                 std::size_t num_phases) const;
+
+    const std::vector<double>& pressure() const { return this->pressure_; }
+    const std::vector<double>& rates() const { return this->rates_; }
+    const std::vector<double>& phaseRates() const { return this->phase_rates_; }
+    const std::vector<double>& solventRates() const { return this->solvent_rates_; }
+    const std::vector<double>& polymerRates() const { return this->polymer_rates_; }
+    const std::vector<double>& brineRates() const { return this->brine_rates_; }
+    const std::vector<double>& prodIndex() const { return this->prod_index_; }
+    const std::vector<std::size_t>& cellIndex() const { return this->cell_index_; }
+
+private:
+    /// Call f(storage array, PerfData member, stride) for every field
+    /// kept in the storage.
+    template<class Storage, class Func>
+    static void forEachField(Storage& storage, std::size_t num_phases, Func&& f);
+
+    std::vector<std::size_t> offsets_;
+    std::size_t num_phases_ = 0;
+    std::vector<double> pressure_;
+    std::vector<double> rates_;
+    std::vector<double> phase_rates_;
+    std::vector<std::array<double,4>> phase_mixing_rates_;
+    std::vector<double> solvent_rates_;
+    std::vector<double> polymer_rates_;
+    std::vector<double> brine_rates_;
+    std::vector<double> prod_index_;
+    std::vector<double> micp_rates_;
+    std::vector<std::size_t> cell_index_;
+    std::vector<double> connection_transmissibility_factor_;
+    std::vector<double> connection_d_factor_;
+    std::vector<int> satnum_id_;
+    std::vector<std::size_t> ecl_index_;
+    std::vector<double> water_throughput_;
+    std::vector<double> skin_pressure_;
+    std::vector<double> water_velocity_;
+};
+
 } // namespace Opm
 
 #endif // OPM_PERFORATIONDATA_HEADER_INCLUDED
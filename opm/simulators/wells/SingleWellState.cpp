@@ -149,10 +149,6 @@ void SingleWellState::reset_connection_factors(const std::vector<PerforationData
 }
 
 
-double SingleWellState::sum_connection_rates(const std::vector<double>& connection_rates) const {
-    return this->parallel_info.get().sumPerfValues(connection_rates.begin(), connection_rates.end());
-}
-
 double SingleWellState::sum_brine_rates() const {
     return this->sum_connection_rates(this->perf_data.brine_rates);
 }
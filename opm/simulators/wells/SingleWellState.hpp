@@ -136,7 +136,12 @@ public:
     double sum_filtrate_total() const;
 
 private:
-    double sum_connection_rates(const std::vector<double>& connection_rates) const;
+    template<class Container>
+    double sum_connection_rates(const Container& connection_rates) const
+    {
+        return this->parallel_info.get().sumPerfValues(connection_rates.data(),
+                                                       connection_rates.data() + connection_rates.size());
+    }
 };
 
 
@@ -46,8 +46,10 @@
 #include <dune/common/dynvector.hh>
 #include <dune/common/dynmatrix.hh>
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 
 namespace Opm
 {
@@ -260,6 +262,10 @@ namespace Opm
     protected:
         bool regularize_;
 
+        // whether ipr_a_ and ipr_b_ match the current reservoir and well
+        // state, reset by every assembly and well state update
+        mutable bool ipr_valid_ = false;
+
         // updating the well_state based on well solution dwells
         void updateWellState(const SummaryState& summary_state,
                              const BVectorWell& dwells,
@@ -449,6 +455,15 @@ namespace Opm
                                                       const SummaryState& summary_state,
                                                       DeferredLogger& deferred_logger) const;
 
+        // bhp at the THP limit of a producer from the IPR, refined with a few
+        // evaluations of frates, empty if the robust search is needed
+        std::optional<double> computeBhpAtThpLimitProdFromIpr(const Simulator& ebos_simulator,
+                                                              const SummaryState& summary_state,
+                                                              const double alq_value,
+                                                              const double max_pressure,
+                                                              const std::function<std::vector<double>(const double)>& frates,
+                                                              DeferredLogger& deferred_logger) const;
+
     private:
         Eval connectionRateEnergy(const double maxOilSaturation,
                                   const std::vector<EvalWell>& cq_s,
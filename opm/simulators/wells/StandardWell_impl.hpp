@@ -20,6 +20,7 @@
 */
 
 #include <opm/common/Exceptions.hpp>
+#include <opm/common/OpmLog/LogUtil.hpp>
 
 #include <opm/input/eclipse/Units/Units.hpp>
 
@@ -343,6 +344,10 @@ namespace Opm
         // clear all entries
         this->linSys_.clear();
 
+        // the reservoir state may have changed since the IPR was computed,
+        // also within the local solves of NLDD
+        ipr_valid_ = false;
+
         assembleWellEqWithoutIterationImpl(ebosSimulator, dt, inj_controls, prod_controls, well_state, group_state, deferred_logger);
     }
 
@@ -688,6 +693,8 @@ namespace Opm
     {
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
 
+        ipr_valid_ = false;
+
         const bool stop_or_zero_rate_target = this->stopppedOrZeroRateTarget(summary_state, well_state);
         updatePrimaryVariablesNewton(dwells, stop_or_zero_rate_target, deferred_logger);
 
@@ -828,8 +835,13 @@ namespace Opm
                 this->ipr_b_[comp_idx] += ipr_b_perf[comp_idx];
             }
         }
-        this->parallel_well_info_.communication().sum(this->ipr_a_.data(), this->ipr_a_.size());
-        this->parallel_well_info_.communication().sum(this->ipr_b_.data(), this->ipr_b_.size());
+        // Distributed wells are never processed by the threaded gas lift
+        // loops, so the collective is only reached from the main thread.
+        if (this->parallel_well_info_.communication().size() > 1) {
+            this->parallel_well_info_.communication().sum(this->ipr_a_.data(), this->ipr_a_.size());
+            this->parallel_well_info_.communication().sum(this->ipr_b_.data(), this->ipr_b_.size());
+        }
+        ipr_valid_ = true;
     }
 
 
@@ -1247,6 +1259,8 @@ namespace Opm
          // 1. Compute properties required by computePressureDelta().
          //    Note that some of the complexity of this part is due to the function
          //    taking std::vector<double> arguments, and not Eigen objects.
+         ipr_valid_ = false;
+
          WellConnectionProps props;
          computePropertiesForWellConnectionPressures(ebosSimulator, well_state, props);
          computeWellConnectionDensitesPressures(ebosSimulator, well_state,
@@ -1388,7 +1402,11 @@ namespace Opm
                 well_flux[gas_pos] += cq_s[Indices::contiSolventEqIdx];
             }
         }
-        this->parallel_well_info_.communication().sum(well_flux.data(), well_flux.size());
+        // Wells on a single process may be evaluated concurrently by the gas
+        // lift optimization and must not communicate.
+        if (this->parallel_well_info_.communication().size() > 1) {
+            this->parallel_well_info_.communication().sum(well_flux.data(), well_flux.size());
+        }
     }
 
 
@@ -1614,6 +1632,8 @@ namespace Opm
     {
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return;
 
+        ipr_valid_ = false;
+
         const bool stop_or_zero_rate_target = this->stopppedOrZeroRateTarget(summary_state, well_state);
         this->primary_variables_.update(well_state, stop_or_zero_rate_target, deferred_logger);
 
@@ -2037,6 +2057,18 @@ namespace Opm
             double pressure_cell = this->getPerfCellPressure(fs).value();
             max_pressure = std::max(max_pressure, pressure_cell);
         }
+
+        if (this->param_.use_ipr_for_thp_limit_) {
+            const auto bhpFromIpr = computeBhpAtThpLimitProdFromIpr(ebos_simulator, summary_state, alq_value,
+                                                                    max_pressure, frates, deferred_logger);
+            if (bhpFromIpr) {
+                auto v = frates(*bhpFromIpr);
+                if (std::all_of(v.cbegin(), v.cend(), [](double i){ return i <= 0; }) ) {
+                    return bhpFromIpr;
+                }
+            }
+        }
+
         auto bhpAtLimit = WellBhpThpCalculator(*this).computeBhpAtThpLimitProd(frates,
                                                                                summary_state,
                                                                                max_pressure,
@@ -2086,6 +2118,48 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    std::optional<double>
+    StandardWell<TypeTag>::
+    computeBhpAtThpLimitProdFromIpr(const Simulator& ebos_simulator,
+                                    const SummaryState& summary_state,
+                                    const double alq_value,
+                                    const double max_pressure,
+                                    const std::function<std::vector<double>(const double)>& frates,
+                                    DeferredLogger& deferred_logger) const
+    {
+        // The IPR is shared by gas lift and the operability checks until
+        // the reservoir or well state changes.
+        if (!ipr_valid_) {
+            updateIPR(ebos_simulator, deferred_logger);
+        }
+
+        // The IPR in the phase order of frates().
+        const int np = this->number_of_phases_;
+        std::vector<double> ipr_a(np, 0.0);
+        std::vector<double> ipr_b(np, 0.0);
+        for (int p = 0; p < np; ++p) {
+            ipr_a[this->ebosCompIdxToFlowCompIdx(p)] = this->ipr_a_[p];
+            ipr_b[this->ebosCompIdxToFlowCompIdx(p)] = this->ipr_b_[p];
+        }
+        if constexpr (has_solvent) {
+            const int gas_pos = this->phaseUsage().phase_pos[Gas];
+            ipr_a[gas_pos] += this->ipr_a_[Indices::contiSolventEqIdx];
+            ipr_b[gas_pos] += this->ipr_b_[Indices::contiSolventEqIdx];
+        }
+        this->adaptRatesForVFP(ipr_a);
+        this->adaptRatesForVFP(ipr_b);
+
+        return WellBhpThpCalculator(*this).computeBhpAtThpLimitProdFromIpr(frates,
+                                                                           ipr_a,
+                                                                           ipr_b,
+                                                                           summary_state,
+                                                                           max_pressure,
+                                                                           this->connections_.rho(),
+                                                                           alq_value,
+                                                                           this->getTHPConstraint(summary_state));
+    }
+
     template<typename TypeTag>
     std::optional<double>
     StandardWell<TypeTag>::
@@ -2254,9 +2328,9 @@ namespace Opm
                 this->wellStatus_ = well_status;
             }
         } else {
-            const std::string message = fmt::format("   Well {} did not converged in {} inner iterations ("
-                                                    "{} control/status switches).", this->name(), it, switch_count);
-            deferred_logger.debug(message);
+            deferred_logger.message(Log::MessageType::Debug, "",
+                                    "   Well " + this->name() + " did not converged in {} inner iterations ("
+                                    "{} control/status switches).", {double(it), double(switch_count)});
             // add operability here as well ?
         }
         return converged;
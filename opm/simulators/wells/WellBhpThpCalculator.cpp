@@ -33,6 +33,7 @@
 
 #include <opm/material/densead/Evaluation.hpp>
 
+#include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
 #include <opm/simulators/wells/VFPProperties.hpp>
@@ -225,20 +226,7 @@ computeBhpAtThpLimitProd(const std::function<std::vector<double>(const double)>&
     const double dp = wellhelpers::computeHydrostaticCorrection(well_.refDepth(), vfp_ref_depth, rho, well_.gravity());
 
     auto fbhp = [this, &controls, thp_limit, dp, alq_value](const std::vector<double>& rates) {
-        assert(rates.size() == 3);
-        const auto& wfr =  well_.vfpProperties()->getExplicitWFR(controls.vfp_table_number, well_.indexOfWell());
-        const auto& gfr = well_.vfpProperties()->getExplicitGFR(controls.vfp_table_number, well_.indexOfWell());
-        const bool use_vfpexp = well_.useVfpExplicit();
-        const double bhp = well_.vfpProperties()->getProd()->bhp(controls.vfp_table_number,
-                                                     rates[Water],
-                                                     rates[Oil],
-                                                     rates[Gas],
-                                                     thp_limit,
-                                                     alq_value,
-                                                     wfr,
-                                                     gfr,
-                                                     use_vfpexp);
-        return bhp - dp + getVfpBhpAdjustment(bhp, thp_limit);
+        return this->vfpProdBhp(rates, controls.vfp_table_number, thp_limit, alq_value, dp);
     };
 
     // Make the flo() function.
@@ -261,6 +249,72 @@ computeBhpAtThpLimitProd(const std::function<std::vector<double>(const double)>&
     return this->computeBhpAtThpLimit(frates, fbhp, range, deferred_logger);
 }
 
+std::optional<double>
+WellBhpThpCalculator::
+computeBhpAtThpLimitProdFromIpr(const std::function<std::vector<double>(const double)>& frates,
+                                const std::vector<double>& ipr_a,
+                                const std::vector<double>& ipr_b,
+                                const SummaryState& summary_state,
+                                const double maxPerfPress,
+                                const double rho,
+                                const double alq_value,
+                                const double thp_limit) const
+{
+    // The inflow model, with production rates negative like frates().
+    auto frates_ipr = [&ipr_a, &ipr_b](const double bhp) {
+        std::vector<double> rates(ipr_a.size());
+        for (std::size_t i = 0; i < rates.size(); ++i) {
+            rates[i] = ipr_b[i] * bhp - ipr_a[i];
+        }
+        return rates;
+    };
+
+    // Failures are expected for wells the inflow model does not describe
+    // well, they are reported by the robust search the caller falls back to.
+    DeferredLogger local_deferredLogger;
+    const auto bhp_ipr = this->computeBhpAtThpLimitProd(frates_ipr, summary_state, maxPerfPress,
+                                                        rho, alq_value, thp_limit, local_deferredLogger);
+    if (!bhp_ipr.has_value()) {
+        return std::nullopt;
+    }
+
+    const auto& controls = well_.wellEcl().productionControls(summary_state);
+    const auto& table = well_.vfpProperties()->getProd()->getTable(controls.vfp_table_number);
+    const double dp = wellhelpers::computeHydrostaticCorrection(well_.refDepth(), table.getDatumDepth(),
+                                                                rho, well_.gravity());
+    auto eq = [this, &controls, thp_limit, alq_value, dp](const std::vector<double>& rates, const double bhp) {
+        return this->vfpProdBhp(rates, controls.vfp_table_number, thp_limit, alq_value, dp) - bhp;
+    };
+
+    // The exact rates differ from the inflow model by crossflowing and
+    // closed connections and by the mixing of dissolved phases. Refine
+    // with secant steps on the exact equation, where the first step uses
+    // the slope of the inflow model equation.
+    const double bhp_tolerance = 0.01 * unit::barsa;
+    const int max_evaluations = 3;
+    double x0 = *bhp_ipr;
+    double f0 = eq(frates(x0), x0);
+    double slope = 0.0;
+    {
+        const double h = 0.1 * unit::barsa;
+        slope = (eq(frates_ipr(x0 + h), x0 + h) - eq(frates_ipr(x0 - h), x0 - h)) / (2.0 * h);
+    }
+    for (int evaluation = 1; std::fabs(f0) > bhp_tolerance; ++evaluation) {
+        if (evaluation == max_evaluations || slope == 0.0 || !std::isfinite(slope)) {
+            return std::nullopt;
+        }
+        const double x1 = x0 - f0 / slope;
+        if (x1 < controls.bhp_limit || x1 > maxPerfPress) {
+            return std::nullopt;
+        }
+        const double f1 = eq(frates(x1), x1);
+        slope = (f1 - f0) / (x1 - x0);
+        x0 = x1;
+        f0 = f1;
+    }
+    return x0;
+}
+
 std::optional<double>
 WellBhpThpCalculator::
 computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>& frates,
@@ -387,6 +441,32 @@ calculateBhpFromThp(const WellState& well_state,
     return bhp_tab - dp_hydro + bhp_adjustment;
 }
 
+double WellBhpThpCalculator::vfpProdBhp(const std::vector<double>& rates,
+                                        const int table_id,
+                                        const double thp_limit,
+                                        const double alq_value,
+                                        const double dp) const
+{
+    static constexpr int Water = BlackoilPhases::Aqua;
+    static constexpr int Oil = BlackoilPhases::Liquid;
+    static constexpr int Gas = BlackoilPhases::Vapour;
+
+    assert(rates.size() == 3);
+    const auto& wfr = well_.vfpProperties()->getExplicitWFR(table_id, well_.indexOfWell());
+    const auto& gfr = well_.vfpProperties()->getExplicitGFR(table_id, well_.indexOfWell());
+    const bool use_vfpexp = well_.useVfpExplicit();
+    const double bhp = well_.vfpProperties()->getProd()->bhp(table_id,
+                                                             rates[Water],
+                                                             rates[Oil],
+                                                             rates[Gas],
+                                                             thp_limit,
+                                                             alq_value,
+                                                             wfr,
+                                                             gfr,
+                                                             use_vfpexp);
+    return bhp - dp + getVfpBhpAdjustment(bhp, thp_limit);
+}
+
 double WellBhpThpCalculator::getVfpBhpAdjustment(const double bhp_tab, const double thp_limit) const
 {
     return well_.wellEcl().getWVFPDP().getPressureLoss(bhp_tab, thp_limit);
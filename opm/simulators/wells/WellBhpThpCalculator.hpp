@@ -71,6 +71,23 @@ public:
                              const double thp_limit,
                              DeferredLogger& deferred_logger) const;
 
+    //! \brief Compute BHP from THP limit for a producer from a linear inflow model.
+    //! \details Solves for the BHP with the rates given by the inflow
+    //!          performance relationship rates = ipr_b * bhp - ipr_a, which
+    //!          are cheap to evaluate, and refines the solution with at most
+    //!          a few evaluations of the exact rates frates.
+    //! \return BHP, or nothing if the solution is not accurate enough and
+    //!         computeBhpAtThpLimitProd() has to be used.
+    std::optional<double>
+    computeBhpAtThpLimitProdFromIpr(const std::function<std::vector<double>(const double)>& frates,
+                                    const std::vector<double>& ipr_a,
+                                    const std::vector<double>& ipr_b,
+                                    const SummaryState& summary_state,
+                                    const double maxPerfPress,
+                                    const double rho,
+                                    const double alq_value,
+                                    const double thp_limit) const;
+
     //! \brief Compute BHP from THP limit for an injector.
     std::optional<double>
     computeBhpAtThpLimitInj(const std::function<std::vector<double>(const double)>& frates,
@@ -124,6 +141,13 @@ private:
                          const std::array<double, 2>& range,
                          DeferredLogger& deferred_logger) const;
 
+    //! \brief BHP of a producer at the THP limit from the VFP table, for given rates.
+    double vfpProdBhp(const std::vector<double>& rates,
+                      const int table_id,
+                      const double thp_limit,
+                      const double alq_value,
+                      const double dp) const;
+
     //! \brief Get pressure adjustment to the bhp calculated from VFP table
     double getVfpBhpAdjustment(const double bph_tab, const double thp_limit) const;
 
@@ -133,6 +133,31 @@ WellState::WellState(const ParallelWellInfo& pinfo)
                SingleWellState{"dummy", pinfo, false, 0.0, {}, phase_usage_, 0.0});
 }
 
+WellState::WellState(const WellState& other)
+    : phase_usage_(other.phase_usage_)
+    , wells_(other.wells_)
+    , global_well_info(other.global_well_info)
+    , alq_state(other.alq_state)
+    , well_rates(other.well_rates)
+{
+    this->bindPerfData();
+}
+
+WellState& WellState::operator=(const WellState& other)
+{
+    if (this != &other) {
+        this->phase_usage_ = other.phase_usage_;
+        // Wells with unchanged perforation counts are assigned in place.
+        this->wells_ = other.wells_;
+        this->global_well_info = other.global_well_info;
+        this->alq_state = other.alq_state;
+        this->well_rates = other.well_rates;
+        this->updatePerfDataBinding();
+    }
+
+    return *this;
+}
+
 WellState WellState::serializationTestObject(const ParallelWellInfo& pinfo)
 {
     WellState result(PhaseUsage{});
@@ -164,6 +189,29 @@ void WellState::base_init(const std::vector<double>& cellPressures,
     }
 }
 
+void WellState::bindPerfData()
+{
+    std::vector<PerfData*> perf_data;
+    perf_data.reserve(this->wells_.size());
+    for (std::size_t w = 0; w < this->wells_.size(); ++w) {
+        perf_data.push_back(&this->wells_[w].perf_data);
+    }
+    this->perf_storage_.bind(perf_data, this->numPhases());
+}
+
+void WellState::updatePerfDataBinding()
+{
+    std::vector<const PerfData*> perf_data;
+    perf_data.reserve(this->wells_.size());
+    for (std::size_t w = 0; w < this->wells_.size(); ++w) {
+        perf_data.push_back(&this->wells_[w].perf_data);
+    }
+
+    if (!this->perf_storage_.isBound(perf_data, this->numPhases())) {
+        this->bindPerfData();
+    }
+}
+
 void WellState::initSingleProducer(const Well& well,
                                    const ParallelWellInfo& well_info,
                                    double pressure_first_connection,
@@ -250,6 +298,7 @@ void WellState::init(const std::vector<double>& cellPressures,
     // call init on base class
     this->base_init(cellPressures, wells_ecl, parallel_well_info,
                     well_perf_data, summary_state);
+    this->bindPerfData();
     this->global_well_info = std::make_optional<GlobalWellInfo>(schedule,
                                                                 report_step,
                                                                 wells_ecl);
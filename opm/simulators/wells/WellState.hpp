@@ -72,6 +72,16 @@ public:
         : phase_usage_(pu)
     {}
 
+    /// Copies bind their perforation data to their own contiguous storage.
+    WellState(const WellState& other);
+    WellState(WellState&&) = default;
+
+    /// Perforation data stays in the contiguous storage of this object
+    /// unless the number of wells or perforations changes, in which case
+    /// the storage is rebuilt.
+    WellState& operator=(const WellState& other);
+    WellState& operator=(WellState&&) = default;
+
     static WellState serializationTestObject(const ParallelWellInfo& pinfo);
 
     std::size_t size() const {
@@ -283,6 +293,14 @@ public:
         return this->wells_.has(well_name);
     }
 
+    /// Contiguous storage of the perforation data of all wells, indexed
+    /// by global perforation offset.  The perforation data of each well
+    /// is a view of it after init(), copies, assignments and
+    /// deserialization.
+    const PerfDataStorage& perfDataStorage() const {
+        return this->perf_storage_;
+    }
+
     bool operator==(const WellState&) const;
 
     template<class Serializer>
@@ -302,6 +320,9 @@ public:
         for (auto& w : wells_) {
             serializer(w);
         }
+        if (!serializer.isSerializing()) {
+            this->updatePerfDataBinding();
+        }
     }
 
 private:
@@ -312,6 +333,10 @@ private:
     // well might appear in the WellContainer on different processes.
     WellContainer<SingleWellState> wells_;
 
+    // Field-major storage of the perforation data of the wells in wells_,
+    // which are views of it once bound.
+    PerfDataStorage perf_storage_;
+
     // The members alq_state, global_well_info and well_rates are map like
     // structures which will have entries for *all* the wells in the system.
 
@@ -349,6 +374,13 @@ private:
                    const std::vector<std::vector<PerforationData>>& well_perf_data,
                    const SummaryState& summary_state);
 
+    /// Move the perforation data of all wells into contiguous storage.
+    void bindPerfData();
+
+    /// Bind the perforation data again if a well no longer is a view
+    /// of the contiguous storage, e.g. after its perforation count changed.
+    void updatePerfDataBinding();
+
     void initSingleWell(const std::vector<double>& cellPressures,
                         const Well& well,
                         const std::vector<PerforationData>& well_perf_data,
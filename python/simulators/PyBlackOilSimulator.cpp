@@ -31,11 +31,59 @@
 // NOTE: EXIT_SUCCESS, EXIT_FAILURE is defined in cstdlib
 #include <cstdlib>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 namespace py = pybind11;
 
+namespace {
+
+// Array taking over the buffer, no copy is made.
+py::array_t<double> ownedArray(std::unique_ptr<double []> values, std::size_t size)
+{
+    double *data = values.release();
+    py::capsule owner(data, [](void *p) { delete [] static_cast<double *>(p); });
+    return py::array_t<double>(size, data, owner);
+}
+
+// Array with one row per cell taking over the buffer, no copy is made.
+py::array_t<double> ownedArray(std::unique_ptr<double []> values,
+                               std::size_t rows, std::size_t cols)
+{
+    double *data = values.release();
+    py::capsule owner(data, [](void *p) { delete [] static_cast<double *>(p); });
+    return py::array_t<double>(
+        std::vector<py::ssize_t>{static_cast<py::ssize_t>(rows),
+                                 static_cast<py::ssize_t>(cols)},
+        data, owner);
+}
+
+// Dictionary from name to a view on the row of the name, all rows share
+// one buffer owned by the arrays.
+py::dict rowsByName(const std::vector<std::string>& names,
+                    std::vector<double>&& rows,
+                    std::size_t num_columns)
+{
+    auto *buffer = new std::vector<double>(std::move(rows));
+    py::capsule owner(buffer, [](void *p) { delete static_cast<std::vector<double> *>(p); });
+    py::array_t<double> all(
+        std::vector<py::ssize_t>{static_cast<py::ssize_t>(names.size()),
+                                 static_cast<py::ssize_t>(num_columns)},
+        buffer->data(), owner);
+    py::dict result;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        py::object row = all[py::int_(i)];
+        result[py::str(names[i])] = row;
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
 namespace Opm::Pybind {
 PyBlackOilSimulator::PyBlackOilSimulator( const std::string &deck_filename)
     : deck_filename_{deck_filename}
@@ -84,18 +132,81 @@ int PyBlackOilSimulator::currentStep()
 py::array_t<double> PyBlackOilSimulator::getCellVolumes() {
     std::size_t len;
     auto array = getMaterialState().getCellVolumes(&len);
-    return py::array(len, array.get());
+    return ownedArray(std::move(array), len);
 }
 
 double PyBlackOilSimulator::getDT() {
     return getFlowMainEbos().getPreviousReportStepSize();
 }
 
+// Production rates of the groups, see getWellRates().
+py::dict PyBlackOilSimulator::getGroupRates()
+{
+    std::vector<std::string> names;
+    std::size_t num_phases;
+    auto rates = getMaterialState().getGroupRates(&names, &num_phases);
+    return rowsByName(names, std::move(rates), num_phases);
+}
+
 py::array_t<double> PyBlackOilSimulator::getPorosity()
 {
     std::size_t len;
     auto array = getMaterialState().getPorosity(&len);
-    return py::array(len, array.get());
+    return ownedArray(std::move(array), len);
+}
+
+// The arrays of intensive quantities are snapshots owned by the array, later
+// changes of the simulator state are not seen through them.
+py::array_t<double> PyBlackOilSimulator::getPressure()
+{
+    std::size_t len;
+    auto array = getMaterialState().getPressure(&len);
+    return ownedArray(std::move(array), len);
+}
+
+// View on the primary variables of the simulator, with one row per cell.
+// Writing to it changes the state of the simulator, call update_cells()
+// for the changed cells afterwards.
+py::array_t<double> PyBlackOilSimulator::getPrimaryVariables()
+{
+    std::size_t num_cells, num_vars, cell_stride;
+    double *data = getMaterialState().getPrimaryVariables(&num_cells, &num_vars, &cell_stride);
+    return py::array_t<double>(
+        std::vector<py::ssize_t>{static_cast<py::ssize_t>(num_cells),
+                                 static_cast<py::ssize_t>(num_vars)},
+        std::vector<py::ssize_t>{static_cast<py::ssize_t>(cell_stride),
+                                 static_cast<py::ssize_t>(sizeof(double))},
+        data, self());
+}
+
+py::array_t<double> PyBlackOilSimulator::getRs()
+{
+    std::size_t len;
+    auto array = getMaterialState().getRs(&len);
+    return ownedArray(std::move(array), len);
+}
+
+py::array_t<double> PyBlackOilSimulator::getRv()
+{
+    std::size_t len;
+    auto array = getMaterialState().getRv(&len);
+    return ownedArray(std::move(array), len);
+}
+
+py::array_t<double> PyBlackOilSimulator::getSaturation()
+{
+    std::size_t num_cells, num_phases;
+    auto array = getMaterialState().getSaturation(&num_cells, &num_phases);
+    return ownedArray(std::move(array), num_cells, num_phases);
+}
+
+// Surface rates of the wells, by well name, one value per active phase.
+py::dict PyBlackOilSimulator::getWellRates()
+{
+    std::vector<std::string> names;
+    std::size_t num_phases;
+    auto rates = getMaterialState().getWellRates(&names, &num_phases);
+    return rowsByName(names, std::move(rates), num_phases);
 }
 
 int PyBlackOilSimulator::run()
@@ -112,6 +223,23 @@ void PyBlackOilSimulator::setPorosity( py::array_t<double,
     getMaterialState().setPorosity(poro, size_);
 }
 
+// Set the primary variables of the given cells, or of all cells if cells is
+// None, and recompute the intensive quantities of these cells.
+void PyBlackOilSimulator::setPrimaryVariables( py::array_t<double,
+    py::array::c_style | py::array::forcecast> array, py::object cells)
+{
+    std::size_t num_cells, num_vars, cell_stride;
+    getMaterialState().getPrimaryVariables(&num_cells, &num_vars, &cell_stride);
+    const auto cell_list = getCells(cells, num_cells);
+    if (array.ndim() != 2 || static_cast<std::size_t>(array.shape(0)) != cell_list.size()) {
+        const std::string msg = fmt::format(
+            "Cannot set primary variables. Expected array with {} rows, one per cell",
+            cell_list.size());
+        throw std::runtime_error(msg);
+    }
+    getMaterialState().setPrimaryVariables(array.data(), array.shape(1), cell_list);
+}
+
 int PyBlackOilSimulator::step()
 {
     if (!this->has_run_init_) {
@@ -172,9 +300,41 @@ int PyBlackOilSimulator::stepInit()
     }
 }
 
+// Recompute the intensive quantities of the given cells, or of all cells if
+// cells is None, after writing to the view on the primary variables.
+void PyBlackOilSimulator::updateCells(py::object cells)
+{
+    std::size_t num_cells, num_vars, cell_stride;
+    getMaterialState().getPrimaryVariables(&num_cells, &num_vars, &cell_stride);
+    getMaterialState().updateCells(getCells(cells, num_cells));
+}
+
 // Private methods alphabetically sorted
 // ------------------------------------
 
+std::vector<unsigned>
+PyBlackOilSimulator::getCells(py::object cells, std::size_t num_cells) const
+{
+    std::vector<unsigned> result;
+    if (cells.is_none()) {
+        result.resize(num_cells);
+        std::iota(result.begin(), result.end(), 0u);
+        return result;
+    }
+    const auto indices = cells.cast<py::array_t<long long,
+        py::array::c_style | py::array::forcecast>>();
+    result.reserve(indices.size());
+    for (py::ssize_t i = 0; i < indices.size(); ++i) {
+        const long long cell = indices.data()[i];
+        if (cell < 0) {
+            throw std::runtime_error(fmt::format("Negative cell index {}", cell));
+        }
+        result.push_back(static_cast<unsigned>(cell));
+    }
+    return result;
+}
+
+
 Opm::FlowMainEbos<typename Opm::Pybind::PyBlackOilSimulator::TypeTag>&
          PyBlackOilSimulator::getFlowMainEbos() const
 {
@@ -199,6 +359,13 @@ PyBlackOilSimulator::getMaterialState() const
     }
 }
 
+// The Python object of the simulator, used as the owner of views on its
+// buffers to keep it alive while they exist.
+py::object PyBlackOilSimulator::self()
+{
+    return py::cast(this, py::return_value_policy::reference);
+}
+
 // Exported functions
 void export_PyBlackOilSimulator(py::module& m)
 {
@@ -209,13 +376,22 @@ void export_PyBlackOilSimulator(py::module& m)
             std::shared_ptr<Opm::EclipseState>,
             std::shared_ptr<Opm::Schedule>,
             std::shared_ptr<Opm::SummaryConfig> >())
-        .def("get_cell_volumes", &PyBlackOilSimulator::getCellVolumes,
-            py::return_value_policy::copy)
+        .def("get_cell_volumes", &PyBlackOilSimulator::getCellVolumes)
         .def("get_dt", &PyBlackOilSimulator::getDT)
-        .def("get_porosity", &PyBlackOilSimulator::getPorosity,
-            py::return_value_policy::copy)
+        .def("get_group_rates", &PyBlackOilSimulator::getGroupRates)
+        .def("get_porosity", &PyBlackOilSimulator::getPorosity)
+        .def("get_pressure", &PyBlackOilSimulator::getPressure)
+        .def("get_primary_variables", &PyBlackOilSimulator::getPrimaryVariables)
+        .def("get_rs", &PyBlackOilSimulator::getRs)
+        .def("get_rv", &PyBlackOilSimulator::getRv)
+        .def("get_saturation", &PyBlackOilSimulator::getSaturation)
+        .def("get_well_rates", &PyBlackOilSimulator::getWellRates)
         .def("run", &PyBlackOilSimulator::run)
         .def("set_porosity", &PyBlackOilSimulator::setPorosity)
+        .def("set_primary_variables", &PyBlackOilSimulator::setPrimaryVariables,
+            py::arg("values"), py::arg("cells") = py::none())
+        .def("update_cells", &PyBlackOilSimulator::updateCells,
+            py::arg("cells") = py::none())
         .def("current_step", &PyBlackOilSimulator::currentStep)
         .def("step", &PyBlackOilSimulator::step)
         .def("advance", &PyBlackOilSimulator::advance, py::arg("report_step"))
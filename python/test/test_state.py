@@ -0,0 +1,57 @@
+import os
+import unittest
+from pathlib import Path
+import numpy as np
+from opm.simulators import BlackOilSimulator
+from .pytest_common import pushd
+
+class TestState(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        # NOTE: See comment in test_basic.py for the reason why we are
+        #   only using a single test_all() function instead of splitting
+        #   it up in multiple test functions
+        test_dir = Path(os.path.dirname(__file__))
+        cls.data_dir = test_dir.parent.joinpath("test_data/SPE1CASE1a")
+
+    def test_all(self):
+        with pushd(self.data_dir):
+            sim = BlackOilSimulator("SPE1CASE1.DATA")
+            sim.step_init()
+            sim.step()
+
+            pressure = sim.get_pressure()
+            self.assertEqual(pressure.shape, (300,), 'shape of pressure')
+            sat = sim.get_saturation()
+            self.assertEqual(sat.shape, (300, 3), 'shape of saturation')
+            np.testing.assert_allclose(sat.sum(axis=1), 1.0, rtol=1e-10)
+            self.assertEqual(sim.get_rs().shape, (300,), 'shape of rs')
+            self.assertEqual(sim.get_rv().shape, (300,), 'shape of rv')
+
+            rates = sim.get_well_rates()
+            self.assertEqual(sorted(rates.keys()), ['INJ', 'PROD'], 'well names')
+            self.assertEqual(len(rates['PROD']), 3, 'phases of well rates')
+            groups = sim.get_group_rates()
+            self.assertIn('G1', groups, 'group names')
+
+            # Changes written through the view are seen by the simulator
+            # once the changed cells are updated.
+            pv = sim.get_primary_variables()
+            self.assertEqual(pv.shape, (300, 3), 'shape of primary variables')
+            self.assertFalse(pv.flags.owndata, 'primary variables is a view')
+            p0 = sim.get_pressure()[0]
+            pv[0, 0] += 1.0e5
+            sim.update_cells([0])
+            self.assertAlmostEqual(sim.get_pressure()[0], p0 + 1.0e5, places=3,
+                                   msg='pressure after changing the view')
+            self.assertEqual(pressure[0], p0, 'earlier pressure is a snapshot')
+
+            values = np.array(pv[[1, 2]])
+            values[:, 0] += 2.0e5
+            p1 = pressure[1]
+            sim.set_primary_variables(values, cells=[1, 2])
+            self.assertAlmostEqual(sim.get_pressure()[1], p1 + 2.0e5, places=3,
+                                   msg='pressure after setting primary variables')
+            with self.assertRaises(RuntimeError):
+                sim.set_primary_variables(values, cells=[1, 300])
+            sim.step()
@@ -0,0 +1,176 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/DeltaCheckpoint.hpp>
+
+#define BOOST_TEST_MODULE DeltaCheckpointTest
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+
+using namespace Opm;
+
+namespace {
+
+std::vector<char> makeBuffer(std::size_t size)
+{
+    std::vector<char> buffer(size);
+    std::iota(buffer.begin(), buffer.end(), 0);
+    return buffer;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Unchanged)
+{
+    const auto base = makeBuffer(100);
+    DeltaCheckpoint dc(16);
+    dc.setBase(3, base);
+    BOOST_CHECK(dc.hasBase());
+    BOOST_CHECK_EQUAL(dc.baseStep(), 3);
+
+    const auto delta = dc.computeDelta(base);
+    BOOST_CHECK_EQUAL(delta.baseStep, 3);
+    BOOST_CHECK_EQUAL(delta.size, 100u);
+    BOOST_CHECK(delta.chunks.empty());
+    BOOST_CHECK(delta.data.empty());
+
+    auto restored = base;
+    DeltaCheckpoint::apply(delta, restored);
+    BOOST_CHECK(restored == base);
+}
+
+BOOST_AUTO_TEST_CASE(ChangedChunks)
+{
+    const auto base = makeBuffer(100);
+    DeltaCheckpoint dc(16);
+    dc.setBase(1, base);
+
+    auto current = base;
+    current[3] = 42;
+    current[99] = 42;
+
+    const auto delta = dc.computeDelta(current);
+    BOOST_REQUIRE_EQUAL(delta.chunks.size(), 2u);
+    BOOST_CHECK_EQUAL(delta.chunks[0], 0u);
+    BOOST_CHECK_EQUAL(delta.chunks[1], 6u);
+    // Full first chunk and the partial last chunk
+    BOOST_CHECK_EQUAL(delta.data.size(), 16u + 4u);
+
+    auto restored = base;
+    DeltaCheckpoint::apply(delta, restored);
+    BOOST_CHECK(restored == current);
+}
+
+BOOST_AUTO_TEST_CASE(ResizedBuffer)
+{
+    const auto base = makeBuffer(100);
+    DeltaCheckpoint dc(16);
+    dc.setBase(1, base);
+
+    auto grown = makeBuffer(130);
+    auto delta = dc.computeDelta(grown);
+    auto restored = base;
+    DeltaCheckpoint::apply(delta, restored);
+    BOOST_CHECK(restored == grown);
+
+    auto shrunk = makeBuffer(40);
+    delta = dc.computeDelta(shrunk);
+    restored = base;
+    DeltaCheckpoint::apply(delta, restored);
+    BOOST_CHECK(restored == shrunk);
+}
+
+BOOST_AUTO_TEST_CASE(SingleByteChanges)
+{
+    // Every single byte change must be detected. Only chunk hashes
+    // of the base image are kept, so it may change after setBase().
+    auto base = makeBuffer(64);
+    DeltaCheckpoint dc(8);
+    dc.setBase(1, base);
+    base[0] = 17;
+
+    const auto original = makeBuffer(64);
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        auto current = original;
+        current[i] ^= 1;
+        const auto delta = dc.computeDelta(current);
+        BOOST_REQUIRE_EQUAL(delta.chunks.size(), 1u);
+        BOOST_CHECK_EQUAL(delta.chunks[0], i / 8);
+
+        auto restored = original;
+        DeltaCheckpoint::apply(delta, restored);
+        BOOST_CHECK(restored == current);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConfirmWithBase)
+{
+    const auto base = makeBuffer(100);
+    DeltaCheckpoint dc(16);
+    dc.setBase(1, base);
+
+    auto current = base;
+    current[40] = 42;
+
+    // The stored base image differs in chunk 4 from the hashed one, as
+    // for a hash collision. Matching chunks are compared to it.
+    auto stored = base;
+    stored[70] = 17;
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    const auto delta = dc.computeDelta(current,
+                                       [&stored, &ranges](const std::size_t offset,
+                                                          const std::size_t size)
+                                       {
+                                           ranges.emplace_back(offset, size);
+                                           return std::vector<char>(stored.begin() + offset,
+                                                                    stored.begin() + offset + size);
+                                       });
+
+    BOOST_REQUIRE_EQUAL(delta.chunks.size(), 2u);
+    BOOST_CHECK_EQUAL(delta.chunks[0], 2u);
+    BOOST_CHECK_EQUAL(delta.chunks[1], 4u);
+
+    // Consecutive matching chunks are read together.
+    BOOST_REQUIRE_EQUAL(ranges.size(), 2u);
+    BOOST_CHECK_EQUAL(ranges[0].first, 0u);
+    BOOST_CHECK_EQUAL(ranges[0].second, 32u);
+    BOOST_CHECK_EQUAL(ranges[1].first, 48u);
+    BOOST_CHECK_EQUAL(ranges[1].second, 52u);
+
+    auto restored = stored;
+    DeltaCheckpoint::apply(delta, restored);
+    BOOST_CHECK(restored == current);
+}
+
+BOOST_AUTO_TEST_CASE(InconsistentDelta)
+{
+    DeltaCheckpoint::Delta delta;
+    delta.size = 32;
+    delta.chunkSize = 16;
+    delta.chunks = {1};
+    std::vector<char> buffer(32);
+    BOOST_CHECK_THROW(DeltaCheckpoint::apply(delta, buffer), std::runtime_error);
+
+    BOOST_CHECK_THROW(DeltaCheckpoint(0), std::invalid_argument);
+}
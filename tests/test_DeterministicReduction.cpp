@@ -0,0 +1,150 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/DeterministicReduction.hpp>
+
+#define BOOST_TEST_MODULE DeterministicReductionTest
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Opm;
+
+namespace {
+
+struct SumAndMax
+{
+    double sum = 0.0;
+    double max = std::numeric_limits<double>::lowest();
+    int maxIdx = -1;
+};
+
+SumAndMax reduce(const std::vector<double>& values, std::size_t chunkSize)
+{
+    return deterministicReduce(values.size(), SumAndMax{},
+                               [&values](const std::size_t i, SumAndMax& part)
+                               {
+                                   part.sum += values[i];
+                                   if (values[i] > part.max) {
+                                       part.max = values[i];
+                                       part.maxIdx = i;
+                                   }
+                               },
+                               [](SumAndMax& result, const SumAndMax& part)
+                               {
+                                   result.sum += part.sum;
+                                   if (part.max > result.max) {
+                                       result.max = part.max;
+                                       result.maxIdx = part.maxIdx;
+                                   }
+                               },
+                               chunkSize);
+}
+
+std::vector<double> makeValues(std::size_t size)
+{
+    std::vector<double> values(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values[i] = std::sin(0.1 * i) * 1e3 + 1e-7 * i;
+    }
+    return values;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+    const auto result = reduce({}, 16);
+    BOOST_CHECK_EQUAL(result.sum, 0.0);
+    BOOST_CHECK_EQUAL(result.maxIdx, -1);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesSerial)
+{
+    // Repeating values, so the maximum is attained in several chunks.
+    std::vector<double> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>((i * 37) % 101);
+    }
+
+    double sum = 0.0;
+    double max = values[0];
+    int maxIdx = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        sum += values[i];
+        if (values[i] > max) {
+            max = values[i];
+            maxIdx = i;
+        }
+    }
+
+    const auto result = reduce(values, 64);
+    BOOST_CHECK_EQUAL(result.sum, sum);
+    BOOST_CHECK_EQUAL(result.max, max);
+    // Ties are resolved to the first index, as in a serial loop.
+    BOOST_CHECK_EQUAL(result.maxIdx, maxIdx);
+}
+
+BOOST_AUTO_TEST_CASE(IndependentOfThreads)
+{
+    const auto values = makeValues(100000);
+    const auto reference = reduce(values, 1024);
+
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+    for (const int threads : {1, 2, 3, 4}) {
+        omp_set_num_threads(threads);
+        const auto result = reduce(values, 1024);
+        BOOST_CHECK_EQUAL(result.sum, reference.sum);
+        BOOST_CHECK_EQUAL(result.maxIdx, reference.maxIdx);
+    }
+    omp_set_num_threads(maxThreads);
+#else
+    const auto result = reduce(values, 1024);
+    BOOST_CHECK_EQUAL(result.sum, reference.sum);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Throws)
+{
+    const auto body = [](const std::size_t i, double& part)
+    {
+        if (i == 700 || i == 5000) {
+            throw std::runtime_error("index " + std::to_string(i));
+        }
+        part += 1.0;
+    };
+    const auto combine = [](double& result, const double part) { result += part; };
+
+    // The exception of the first failing chunk is rethrown.
+    try {
+        deterministicReduce(std::size_t{10000}, 0.0, body, combine, 256);
+        BOOST_FAIL("No exception thrown");
+    } catch (const std::runtime_error& e) {
+        BOOST_CHECK_EQUAL(std::string(e.what()), "index 700");
+    }
+}
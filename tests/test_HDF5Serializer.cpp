@@ -23,6 +23,8 @@
 
 #include <ebos/hdf5serializer.hh>
 
+#include <opm/simulators/utils/HDF5CheckpointWriter.hpp>
+
 #include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
@@ -95,6 +97,117 @@ BOOST_AUTO_TEST_CASE(WriteRead)
     std::filesystem::remove(path);
 }
 
+BOOST_AUTO_TEST_CASE(CheckpointWriter)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "rw.hdf5").string();
+#if HAVE_MPI
+    Parallel::Communication comm(MPI_COMM_SELF);
+#else
+    Parallel::Communication comm{};
+#endif
+    const auto output = Group::serializationTestObject();
+    {
+        HDF5CheckpointWriter::Options options;
+        options.stepsToKeep = 2;
+        options.chunkSize = 16;
+        HDF5CheckpointWriter writer(rwpath, comm, options);
+        for (int step = 1; step <= 4; ++step) {
+            HDF5CheckpointWriter::Checkpoint checkpoint;
+            checkpoint.reportStep = step;
+            checkpoint.newFile = step == 1;
+            checkpoint.header = HDF5CheckpointWriter::pack(std::string{"foo"}, std::string{"bar"},
+                                                           std::string{"foobar"}, std::string{"bob"},
+                                                           std::string{"bobbar"}, 1);
+            checkpoint.state = HDF5CheckpointWriter::pack(output);
+            checkpoint.timer = HDF5CheckpointWriter::pack(step);
+            BOOST_CHECK_NO_THROW(writer.write(std::move(checkpoint)));
+        }
+        BOOST_CHECK_NO_THROW(writer.wait());
+    }
+    {
+        HDF5Serializer ser(rwpath, HDF5File::OpenMode::READ, comm);
+        const auto steps = ser.reportSteps();
+        BOOST_REQUIRE_EQUAL(steps.size(), 2u);
+        BOOST_CHECK_EQUAL(steps[0], 3);
+        BOOST_CHECK_EQUAL(steps[1], 4);
+
+        Group input;
+        ser.read(input, "/report_step/4", "simulator_data");
+        BOOST_CHECK_MESSAGE(input == output, "Deserialized data does not match input");
+
+        int timer = 0;
+        ser.read(timer, "/report_step/4", "simulator_timer",
+                 HDF5File::DataSetMode::ROOT_ONLY);
+        BOOST_CHECK_EQUAL(timer, 4);
+
+        std::tuple<std::array<std::string,5>,int> header;
+        ser.read(header, "/", "simulator_info", HDF5File::DataSetMode::ROOT_ONLY);
+        BOOST_CHECK_EQUAL(std::get<0>(header)[4], "bobbar");
+    }
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaCheckpoint)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "rw.hdf5").string();
+#if HAVE_MPI
+    Parallel::Communication comm(MPI_COMM_SELF);
+#else
+    Parallel::Communication comm{};
+#endif
+    std::vector<std::vector<double>> states;
+    {
+        HDF5CheckpointWriter::Options options;
+        options.deltaChunkSize = 64;
+        options.stepsToKeep = 2;
+        HDF5CheckpointWriter writer(rwpath, comm, options);
+        std::vector<double> state(1000, 1.0);
+        for (int step = 1; step <= 4; ++step) {
+            state[10 * step] = step;
+            states.push_back(state);
+
+            HDF5CheckpointWriter::Checkpoint checkpoint;
+            checkpoint.reportStep = step;
+            checkpoint.newFile = step == 1;
+            checkpoint.header = HDF5CheckpointWriter::pack(std::string{"foo"}, std::string{"bar"},
+                                                           std::string{"foobar"}, std::string{"bob"},
+                                                           std::string{"bobbar"}, 1);
+            checkpoint.state = HDF5CheckpointWriter::pack(state);
+            checkpoint.timer = HDF5CheckpointWriter::pack(step);
+            writer.write(std::move(checkpoint));
+            if (step > 1) {
+                BOOST_CHECK_LT(writer.lastStoredSize(), writer.lastStateSize() / 4);
+            }
+        }
+        writer.wait();
+    }
+    {
+        HDF5Serializer ser(rwpath, HDF5File::OpenMode::READ, comm);
+        // Base step 1 is kept since steps 3 and 4 refer to it
+        const auto steps = ser.reportSteps();
+        BOOST_REQUIRE_EQUAL(steps.size(), 3u);
+        BOOST_CHECK_EQUAL(steps[0], 1);
+        BOOST_CHECK_EQUAL(steps[1], 3);
+        BOOST_CHECK_EQUAL(steps[2], 4);
+
+        for (int step : {1, 3, 4}) {
+            std::vector<double> input;
+            ser.readCheckpoint(input, "/report_step/" + std::to_string(step), "simulator_data");
+            BOOST_CHECK_MESSAGE(input == states[step - 1],
+                                "Deserialized data does not match input for step " << step);
+        }
+    }
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
 bool init_unit_test_func()
 {
     return true;
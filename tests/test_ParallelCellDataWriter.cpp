@@ -0,0 +1,182 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/common/utility/FileSystem.hpp>
+
+#include <opm/input/eclipse/Units/UnitSystem.hpp>
+
+#include <opm/output/data/Solution.hpp>
+
+#include <opm/simulators/utils/ParallelCellDataWriter.hpp>
+
+#define BOOST_TEST_MODULE ParallelCellDataWriterTest
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+
+BOOST_AUTO_TEST_CASE(WriteAndAssemble)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "cells.hdf5").string();
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_SELF};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+
+    // Three local cells, the last one is an overlap cell and not written.
+    Opm::data::Solution sol;
+    sol.insert("PRESSURE", Opm::UnitSystem::measure::pressure,
+               std::vector<double>{1.0, 2.0, 3.0},
+               Opm::data::TargetType::RESTART_SOLUTION);
+    sol.insert("SWAT", Opm::UnitSystem::measure::identity,
+               std::vector<double>{0.1, 0.2, 0.3},
+               Opm::data::TargetType::RESTART_SOLUTION);
+
+    {
+        Opm::ParallelCellDataWriter writer(rwpath, comm, {0, 1}, {4, 1});
+        BOOST_CHECK_NO_THROW(writer.write(1, sol));
+        BOOST_CHECK_NO_THROW(writer.write(2, sol));
+    }
+
+    const auto global = Opm::ParallelCellDataWriter::readGlobal(rwpath, 2, 6, comm);
+    BOOST_REQUIRE_EQUAL(global.size(), 2u);
+
+    const std::vector<double> pressure{0.0, 2.0, 0.0, 0.0, 1.0, 0.0};
+    const auto& p = global.at("PRESSURE");
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.begin(), p.end(),
+                                  pressure.begin(), pressure.end());
+
+    const std::vector<double> swat{0.0, 0.2, 0.0, 0.0, 0.1, 0.0};
+    const auto& s = global.at("SWAT");
+    BOOST_CHECK_EQUAL_COLLECTIONS(s.begin(), s.end(),
+                                  swat.begin(), swat.end());
+
+    BOOST_CHECK_THROW(Opm::ParallelCellDataWriter::readGlobal(rwpath, 3, 6, comm),
+                      std::runtime_error);
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(RewriteStep)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "cells.hdf5").string();
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_SELF};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+
+    auto solution = [](const double value)
+    {
+        Opm::data::Solution sol;
+        sol.insert("KRW", Opm::UnitSystem::measure::identity,
+                   std::vector<double>{value, value},
+                   Opm::data::TargetType::RESTART_AUXILIARY);
+        return sol;
+    };
+
+    {
+        // Writing the same step again, as after a restart, replaces it.
+        Opm::ParallelCellDataWriter writer(rwpath, comm, {0, 1}, {0, 1});
+        BOOST_CHECK_NO_THROW(writer.write(1, solution(1.0)));
+        BOOST_CHECK_NO_THROW(writer.write(2, solution(2.0)));
+        BOOST_CHECK_NO_THROW(writer.write(2, solution(3.0)));
+    }
+
+    const auto step1 = Opm::ParallelCellDataWriter::readGlobal(rwpath, 1, 2, comm);
+    BOOST_CHECK_EQUAL(step1.at("KRW")[1], 1.0);
+    const auto step2 = Opm::ParallelCellDataWriter::readGlobal(rwpath, 2, 2, comm);
+    BOOST_CHECK_EQUAL(step2.at("KRW")[0], 3.0);
+    BOOST_CHECK_EQUAL(step2.at("KRW")[1], 3.0);
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(AppendOnRestart)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "cells.hdf5").string();
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_SELF};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+
+    auto solution = [](const double value)
+    {
+        Opm::data::Solution sol;
+        sol.insert("KRW", Opm::UnitSystem::measure::identity,
+                   std::vector<double>{value, value},
+                   Opm::data::TargetType::RESTART_AUXILIARY);
+        return sol;
+    };
+
+    {
+        Opm::ParallelCellDataWriter writer(rwpath, comm, {0, 1}, {0, 1});
+        BOOST_CHECK_NO_THROW(writer.write(1, solution(1.0)));
+        BOOST_CHECK_NO_THROW(writer.write(2, solution(2.0)));
+    }
+
+    {
+        // Restarted run from step 2 with a different set of cells.
+        Opm::ParallelCellDataWriter writer(rwpath, comm, {1}, {1}, /*append=*/true);
+        BOOST_CHECK_NO_THROW(writer.write(2, solution(3.0)));
+        BOOST_CHECK_NO_THROW(writer.write(3, solution(4.0)));
+    }
+
+    const auto step1 = Opm::ParallelCellDataWriter::readGlobal(rwpath, 1, 2, comm);
+    BOOST_CHECK_EQUAL(step1.at("KRW")[0], 1.0);
+    BOOST_CHECK_EQUAL(step1.at("KRW")[1], 1.0);
+    const auto step2 = Opm::ParallelCellDataWriter::readGlobal(rwpath, 2, 2, comm);
+    BOOST_CHECK_EQUAL(step2.at("KRW")[0], 0.0);
+    BOOST_CHECK_EQUAL(step2.at("KRW")[1], 3.0);
+    const auto step3 = Opm::ParallelCellDataWriter::readGlobal(rwpath, 3, 2, comm);
+    BOOST_CHECK_EQUAL(step3.at("KRW")[1], 4.0);
+
+    {
+        // A run which is not restarted starts a new file.
+        Opm::ParallelCellDataWriter writer(rwpath, comm, {0, 1}, {0, 1});
+        BOOST_CHECK_NO_THROW(writer.write(3, solution(5.0)));
+    }
+
+    BOOST_CHECK_THROW(Opm::ParallelCellDataWriter::readGlobal(rwpath, 1, 2, comm),
+                      std::runtime_error);
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
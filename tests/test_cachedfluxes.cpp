@@ -0,0 +1,240 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE CachedFluxes
+
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hh>
+#include <ebos/eclproblem.hh>
+#include <ebos/ebos.hh>
+#include <ebos/ecloutputblackoilmodule.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/output/data/InterRegFlowMap.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::EbosTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using ElementMapper = Opm::GetPropType<TypeTag, Opm::Properties::ElementMapper>;
+using ElementContext = Opm::GetPropType<TypeTag, Opm::Properties::ElementContext>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using OutputModule = Opm::EclOutputBlackOilModule<TypeTag>;
+
+std::unique_ptr<Simulator> initSimulator(const char* filename)
+{
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+
+    const char* argv[] = {
+        "test_cachedfluxes",
+        filename_arg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/true);
+
+    Opm::EclGenericVanguard::readDeck(filename);
+
+    return std::make_unique<Simulator>();
+}
+
+//! All cells are on this rank in a serial run.
+struct SerialCollectToIORank
+{
+    bool isCartIdxOnThisRank(const int) const
+    {
+        return true;
+    }
+};
+
+//! Inter-region flows of all region sets from either processFluxes() or
+//! processCachedFluxes().
+std::vector<Opm::data::InterRegFlowMap>
+interRegionFlows(const Simulator& simulator, OutputModule& module, const bool cached)
+{
+    const auto& gridView = simulator.vanguard().gridView();
+
+    const auto elemMapper = ElementMapper { gridView, Dune::mcmgElementLayout() };
+    const auto activeIndex = [&elemMapper](const auto& elem)
+    {
+        return elemMapper.index(elem);
+    };
+
+    const auto cartesianIndex = [&simulator](const int elemIndex)
+    {
+        return simulator.vanguard().cartesianIndex(elemIndex);
+    };
+
+    module.initializeFluxData();
+
+    if (cached) {
+        BOOST_REQUIRE(module.processCachedFluxes(activeIndex, cartesianIndex));
+    }
+    else {
+        auto elemCtx = ElementContext { simulator };
+        for (const auto& elem : elements(gridView, Dune::Partitions::interiorBorder)) {
+            elemCtx.updateStencil(elem);
+            elemCtx.updateIntensiveQuantities(/*timeIdx=*/0);
+            elemCtx.updateExtensiveQuantities(/*timeIdx=*/0);
+
+            module.processFluxes(elemCtx, activeIndex, cartesianIndex);
+        }
+    }
+
+    module.finalizeFluxData();
+
+    return module.getInterRegFlows().getInterRegFlows();
+}
+
+struct CachedFluxesFixture
+{
+    CachedFluxesFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::EclGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+}
+
+BOOST_GLOBAL_FIXTURE(CachedFluxesFixture);
+
+BOOST_AUTO_TEST_CASE(MatchesElementContext)
+{
+    static_assert(OutputModule::canProcessCachedFluxes());
+
+    auto simulator = initSimulator("cached_fluxes.DATA");
+    auto& model = simulator->model();
+
+    model.applyInitialSolution();
+
+    // Disturb the hydrostatic equilibrium.  Some of the pressure
+    // differences between the equilibration regions are below the
+    // threshold pressure.
+    auto& solution = model.solution(/*timeIdx=*/0);
+    for (unsigned cellIdx = 0; cellIdx < solution.size(); ++cellIdx) {
+        const auto cartIdx = simulator->vanguard().cartesianIndex(cellIdx);
+        solution[cellIdx][Indices::pressureSwitchIdx] +=
+            0.6e5*(cartIdx % 4) + 2.0e5*((cartIdx / 12) % 2);
+    }
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    auto module = OutputModule { *simulator, SerialCollectToIORank{} };
+
+    const auto expect = interRegionFlows(*simulator, module, /*cached=*/false);
+    const auto flows = interRegionFlows(*simulator, module, /*cached=*/true);
+
+    using Component = Opm::data::InterRegFlowMap::Component;
+    const auto components = {
+        Component::Oil, Component::Gas, Component::Water,
+        Component::Disgas, Component::Vapoil,
+    };
+
+    BOOST_REQUIRE_EQUAL(flows.size(), expect.size());
+    BOOST_REQUIRE(! flows.empty());
+
+    auto numInterRegionFlows = 0;
+    for (auto i = 0*flows.size(); i < flows.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(flows[i].numRegions(), expect[i].numRegions());
+
+        for (auto r1 = 0*flows[i].numRegions(); r1 < flows[i].numRegions(); ++r1) {
+            for (auto r2 = r1 + 1; r2 < flows[i].numRegions(); ++r2) {
+                BOOST_TEST_CONTEXT("regions " << r1 << " and " << r2) {
+                    const auto q = flows[i].getInterRegFlows(r1, r2);
+                    const auto qExpect = expect[i].getInterRegFlows(r1, r2);
+                    BOOST_REQUIRE_EQUAL(q.has_value(), qExpect.has_value());
+                    if (! q.has_value()) {
+                        continue;
+                    }
+
+                    ++numInterRegionFlows;
+
+                    const auto& [rate, sign] = q.value();
+                    const auto& [rateExpect, signExpect] = qExpect.value();
+                    BOOST_CHECK_EQUAL(sign, signExpect);
+
+                    for (const auto component : components) {
+                        const auto diff = rate.flow(component) - rateExpect.flow(component);
+                        BOOST_CHECK_SMALL(diff, 1.0e-10*(1.0 + std::abs(rateExpect.flow(component))));
+                    }
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK(numInterRegionFlows > 0);
+}
+
+BOOST_AUTO_TEST_CASE(FallbackWithoutCache)
+{
+    auto simulator = initSimulator("cached_fluxes.DATA");
+    auto& model = simulator->model();
+
+    model.applyInitialSolution();
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    auto module = OutputModule { *simulator, SerialCollectToIORank{} };
+
+    const auto& gridView = simulator->vanguard().gridView();
+    const auto elemMapper = ElementMapper { gridView, Dune::mcmgElementLayout() };
+    const auto activeIndex = [&elemMapper](const auto& elem)
+    {
+        return elemMapper.index(elem);
+    };
+    const auto cartesianIndex = [&simulator](const int elemIndex)
+    {
+        return simulator->vanguard().cartesianIndex(elemIndex);
+    };
+
+    module.initializeFluxData();
+    BOOST_CHECK(module.processCachedFluxes(activeIndex, cartesianIndex));
+
+    // Without up to date intensive quantities nothing is captured, the
+    // caller must use processFluxes() instead.
+    model.invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+
+    module.initializeFluxData();
+    BOOST_CHECK(! module.processCachedFluxes(activeIndex, cartesianIndex));
+}
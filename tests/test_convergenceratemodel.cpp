@@ -0,0 +1,95 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#define BOOST_TEST_MODULE ConvergenceRateModelTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/timestepping/ConvergenceRateModel.hpp>
+
+#include <cmath>
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+    Opm::ConvergenceRateModel model;
+    BOOST_CHECK_EQUAL(model.iterations(), 0);
+    BOOST_CHECK_EQUAL(model.rate(), 1.0);
+    BOOST_CHECK(std::isinf(model.remainingIterations()));
+
+    model.addIteration(100.0);
+    BOOST_CHECK_EQUAL(model.rate(), 1.0);
+    BOOST_CHECK(std::isinf(model.remainingIterations()));
+}
+
+BOOST_AUTO_TEST_CASE(GeometricDecay)
+{
+    Opm::ConvergenceRateModel model;
+    double measure = 1.0e4;
+    for (int it = 0; it < 3; ++it) {
+        model.addIteration(measure);
+        measure *= 0.1;
+    }
+    BOOST_CHECK_CLOSE(model.rate(), 0.1, 1e-10);
+    // The last measure is 100, two more iterations reach one.
+    BOOST_CHECK_CLOSE(model.remainingIterations(), 2.0, 1e-10);
+
+    model.addIteration(0.5);
+    BOOST_CHECK_EQUAL(model.remainingIterations(), 0.0);
+
+    model.reset();
+    BOOST_CHECK_EQUAL(model.iterations(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+    // Only the last three iterations are fitted: a stagnating start does
+    // not hide the decay that follows.
+    Opm::ConvergenceRateModel model(3);
+    for (const double measure : {1.0e3, 1.0e3, 1.0e3, 1.0e2, 1.0e1}) {
+        model.addIteration(measure);
+    }
+    BOOST_CHECK_CLOSE(model.rate(), 0.1, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(Stagnation)
+{
+    Opm::ConvergenceRateModel model;
+    for (const double measure : {50.0, 40.0, 45.0, 60.0}) {
+        model.addIteration(measure);
+    }
+    BOOST_CHECK_GT(model.rate(), 1.0);
+    BOOST_CHECK(std::isinf(model.remainingIterations()));
+
+    // The retry factor is bounded.
+    BOOST_CHECK_LT(model.timeStepFactor(5, 0.01, 1.0), 1.0);
+    BOOST_CHECK_EQUAL(model.timeStepFactor(5, 0.01, 0.3), 0.3);
+    BOOST_CHECK_EQUAL(model.timeStepFactor(5, 0.6, 0.9), 0.6);
+}
+
+BOOST_AUTO_TEST_CASE(TimeStepFactor)
+{
+    // r0 = 10 and rho = 0.5, so with f = 0.5 the retried step starts at 5
+    // and contracts by 0.25 per iteration: log(5) + n log(0.25) <= 0 for
+    // n >= 1.16. The factor for n = 2 is exp(-(log 10 + 2 log 0.5) / 3).
+    Opm::ConvergenceRateModel model;
+    for (const double measure : {10.0, 5.0, 2.5}) {
+        model.addIteration(measure);
+    }
+    const double expected = std::exp(-(std::log(10.0) + 2.0 * std::log(0.5)) / 3.0);
+    BOOST_CHECK_CLOSE(model.timeStepFactor(2, 0.01, 1.0), expected, 1e-10);
+    BOOST_CHECK_EQUAL(model.timeStepFactor(2, 0.01, 0.5), 0.5);
+}
@@ -33,6 +33,10 @@
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <opm/common/OpmLog/LogUtil.hpp>
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace Opm;
 
 void initLogger(std::ostringstream& log_stream) {
@@ -98,3 +102,91 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     BOOST_CHECK_EQUAL(log_stream.str(), expected);
 
 }
+
+BOOST_AUTO_TEST_CASE(structuredmessages)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Warning, "rate 1.250e+02 for 2 wells {}") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "plain {}") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    auto deferred_logger = Opm::DeferredLogger();
+    deferred_logger.message(Log::MessageType::Warning, "", "rate {:.3e} for {} wells {{}}", {125.0, 2.0});
+    deferred_logger.info("plain {}");
+    deferred_logger.logMessages();
+
+    BOOST_CHECK(deferred_logger.empty());
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(concurrentmessages)
+{
+    const int num_messages = 1000;
+
+    auto deferred_logger = Opm::DeferredLogger();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < num_messages; ++i) {
+        deferred_logger.message(Log::MessageType::Note, "", "message {}", {double(i)});
+    }
+
+    Opm::DeferredLogger copy;
+    copy.append(deferred_logger);
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    copy.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL(num_messages, counter->numMessages(Log::MessageType::Note));
+    BOOST_CHECK(!deferred_logger.empty());
+    BOOST_CHECK(copy.empty());
+}
+
+BOOST_AUTO_TEST_CASE(morethreadsthanbuffers)
+{
+    const int num_messages = 1000;
+
+#if HAVE_OPENMP
+    const int max_threads = omp_get_max_threads();
+    const int max_levels = omp_get_max_active_levels();
+    omp_set_num_threads(1);
+#endif
+    // Created with a single buffer.
+    auto deferred_logger = Opm::DeferredLogger();
+#if HAVE_OPENMP
+    omp_set_num_threads(4);
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < num_messages; ++i) {
+        deferred_logger.message(Log::MessageType::Note, "", "message {}", {double(i)});
+    }
+
+    // Thread numbers are not unique in nested parallel regions.
+#if HAVE_OPENMP
+    omp_set_max_active_levels(2);
+#pragma omp parallel num_threads(2)
+#pragma omp parallel for num_threads(2)
+#endif
+    for (int i = 0; i < num_messages; ++i) {
+        deferred_logger.warning("nested");
+    }
+#if HAVE_OPENMP
+    omp_set_max_active_levels(max_levels);
+    omp_set_num_threads(max_threads);
+#endif
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    deferred_logger.logMessages();
+
+    auto counter = OpmLog::getBackend<CounterLog>("COUNTER");
+    BOOST_CHECK_EQUAL(num_messages, counter->numMessages(Log::MessageType::Note));
+#if HAVE_OPENMP
+    BOOST_CHECK_EQUAL(2*num_messages, counter->numMessages(Log::MessageType::Warning));
+#else
+    BOOST_CHECK_EQUAL(num_messages, counter->numMessages(Log::MessageType::Warning));
+#endif
+    BOOST_CHECK(deferred_logger.empty());
+}
@@ -600,6 +600,25 @@ BOOST_AUTO_TEST_CASE(CheckerBoard_Internal)
     }
 }
 
+BOOST_AUTO_TEST_CASE(InterRegionConnection)
+{
+    const auto flows = Opm::EclInterRegFlowMapSingleFIP{ left_right_split_region() };
+
+    BOOST_CHECK_MESSAGE(  flows.isInterRegionConnection({ 0, 0, true }, { 1, 1, true }),
+                        "Connection 0->1 must be inter-regional");
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 0, 0, true }, { 2, 2, true }),
+                        "Connection 0->2 must be internal to a region");
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 1, 1, true }, { 3, 3, true }),
+                        "Connection 1->3 must be internal to a region");
+    BOOST_CHECK_MESSAGE(  flows.isInterRegionConnection({ 2, 2, true }, { 3, 3, false }),
+                        "Connection 2->3 must be inter-regional");
+
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 1, 1, true }, { 0, 0, true }),
+                        "Connection 1->0 must be handled from cell 0");
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 0, 0, false }, { 1, 1, true }),
+                        "Connection 0->1 must be handled on the rank owning cell 0");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Left_Right_Split_Region
 
 // =====================================================================
@@ -2381,6 +2400,34 @@ namespace {
     }
 }
 
+BOOST_AUTO_TEST_CASE(InterRegionConnection)
+{
+    const auto fipnum = all_same_region();
+    const auto fipspl = left_right_split_region();
+
+    const auto single = Opm::EclInterRegFlowMap {
+        fipnum.size(), { { "FIPNUM", std::cref(fipnum) }, }
+    };
+
+    BOOST_CHECK_MESSAGE(! single.isInterRegionConnection({ 0, 0, true }, { 1, 1, true }),
+                        "Connection 0->1 must be internal to all regions");
+
+    const auto flows = Opm::EclInterRegFlowMap {
+        fipnum.size(),
+        {
+            { "FIPNUM", std::cref(fipnum) },
+            { "FIPSPL", std::cref(fipspl) },
+        }
+    };
+
+    BOOST_CHECK_MESSAGE(  flows.isInterRegionConnection({ 0, 0, true }, { 1, 1, true }),
+                        "Connection 0->1 must be inter-regional in FIPSPL");
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 0, 0, true }, { 2, 2, true }),
+                        "Connection 0->2 must be internal to all regions");
+    BOOST_CHECK_MESSAGE(! flows.isInterRegionConnection({ 1, 1, true }, { 0, 0, true }),
+                        "Connection 1->0 must be handled from cell 0");
+}
+
 BOOST_AUTO_TEST_CASE(Single_Process)
 {
     const auto fipnum = all_same_region();
@@ -0,0 +1,128 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestEclTableSegmentCache
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/ecltablesegmentcache.hh>
+
+#include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/densead/Evaluation.hpp>
+
+#include <vector>
+
+namespace {
+
+using Table = Opm::Tabulated1DFunction<double>;
+
+Table makeTable(const std::vector<double>& x, const std::vector<double>& y)
+{
+    Table table;
+    table.setXYContainers(x, y);
+    return table;
+}
+
+// Evaluate with the cache and directly, one cell following the arguments.
+void checkSequence(const Opm::EclTableSegmentCache<double>& cache,
+                   const Table& table,
+                   unsigned cellIdx,
+                   const std::vector<double>& args)
+{
+    for (const double x : args) {
+        BOOST_TEST_CONTEXT("x = " << x) {
+            BOOST_CHECK_CLOSE(cache.eval(table, cellIdx, x),
+                              table.eval(x, /*extrapolation=*/true), 1.0e-12);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+    Opm::EclTableSegmentCache<double> cache;
+    BOOST_CHECK(cache.empty());
+
+    cache.resize(3);
+    BOOST_CHECK(!cache.empty());
+}
+
+BOOST_AUTO_TEST_CASE(SegmentBoundaries)
+{
+    const auto table = makeTable({ 1.0, 2.0, 4.0, 8.0, 16.0 },
+                                 { 1.0, 3.0, 2.0, 5.0, 4.0 });
+
+    Opm::EclTableSegmentCache<double> cache;
+    cache.resize(2);
+
+    // Arguments at the sample points, where the remembered segment and its
+    // neighbours both contain the argument, and moving across boundaries.
+    checkSequence(cache, table, 0, { 2.0, 2.0, 4.0, 3.0, 4.0, 5.0, 4.0, 2.0, 1.0 });
+    checkSequence(cache, table, 0, { 8.0, 16.0, 8.0, 12.0, 16.0 });
+
+    // Extrapolation from the first and last segments.
+    checkSequence(cache, table, 1, { 0.5, -3.0, 1.0, 1.5, 20.0, 100.0, 16.0, 0.0 });
+
+    // Jumps over several segments.
+    checkSequence(cache, table, 1, { 1.5, 12.0, 3.0, 100.0, -1.0 });
+}
+
+BOOST_AUTO_TEST_CASE(Derivatives)
+{
+    using Eval = Opm::DenseAd::Evaluation<double, 1>;
+
+    const auto table = makeTable({ 0.0, 1.0, 3.0 }, { 0.0, 2.0, 3.0 });
+
+    Opm::EclTableSegmentCache<double> cache;
+    cache.resize(1);
+
+    for (const double x : { 0.5, 1.0, 2.0, 4.0, -1.0 }) {
+        const auto arg = Eval::createVariable(x, 0);
+        const auto cached = cache.eval(table, 0, arg);
+        const auto direct = table.eval(arg, /*extrapolation=*/true);
+        BOOST_TEST_CONTEXT("x = " << x) {
+            BOOST_CHECK_CLOSE(cached.value(), direct.value(), 1.0e-12);
+            BOOST_CHECK_CLOSE(cached.derivative(0), direct.derivative(0), 1.0e-12);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Invalidation)
+{
+    const auto large = makeTable({ 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 },
+                                 { 0.0, 1.0, 4.0, 9.0, 16.0, 25.0 });
+    const auto small = makeTable({ 0.0, 10.0, 20.0 }, { 5.0, 6.0, 8.0 });
+
+    Opm::EclTableSegmentCache<double> cache;
+    cache.resize(1);
+
+    // The segment remembered for the large table does not exist in the
+    // small one and must not be used for it.
+    checkSequence(cache, large, 0, { 4.5 });
+    checkSequence(cache, small, 0, { 4.5, 15.0 });
+
+    // The segment of the small table exists in the large one, but does
+    // not contain the argument.
+    checkSequence(cache, large, 0, { 4.5, 0.5 });
+
+    // Resizing forgets the remembered segments.
+    cache.resize(4);
+    checkSequence(cache, large, 3, { 4.5, 2.5 });
+}
@@ -0,0 +1,201 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE ExplicitQuantities
+
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/parametersystem.hh>
+#include <ebos/eclproblem.hh>
+#include <ebos/ebos.hh>
+#include <opm/models/utils/start.hh>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::EbosTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Evaluation = Opm::GetPropType<TypeTag, Opm::Properties::Evaluation>;
+using FluidSystem = Opm::GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using PrimaryVariables = Opm::GetPropType<TypeTag, Opm::Properties::PrimaryVariables>;
+
+std::unique_ptr<Simulator> initSimulator(const char* filename)
+{
+    std::string filename_arg = "--ecl-deck-file-name=";
+    filename_arg += filename;
+
+    const char* argv[] = {
+        "test_explicitquantities",
+        filename_arg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/true);
+
+    Opm::EclGenericVanguard::readDeck(filename);
+
+    return std::make_unique<Simulator>();
+}
+
+//! The parts of the intensive quantities of a cell which depend on the
+//! explicitly treated quantities.
+std::vector<Evaluation> cellQuantities(const Simulator& simulator, unsigned cellIdx)
+{
+    const auto& iq = simulator.model().intensiveQuantities(cellIdx, /*timeIdx=*/0);
+    const auto& fs = iq.fluidState();
+    std::vector<Evaluation> result{iq.porosity()};
+    for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+        if (!FluidSystem::phaseIsActive(phaseIdx)) {
+            continue;
+        }
+        result.push_back(fs.pressure(phaseIdx));
+        result.push_back(fs.saturation(phaseIdx));
+        result.push_back(iq.mobility(phaseIdx));
+    }
+    return result;
+}
+
+std::vector<std::vector<Evaluation>> allQuantities(const Simulator& simulator)
+{
+    std::vector<std::vector<Evaluation>> result;
+    for (unsigned cellIdx = 0; cellIdx < simulator.model().numGridDof(); ++cellIdx) {
+        result.push_back(cellQuantities(simulator, cellIdx));
+    }
+    return result;
+}
+
+//! Change the solution, start a time step and compare the intensive
+//! quantities updated for the changed cells with a full update.
+//! \return True if the explicit update changed any intensive quantity
+bool checkTimeStep(Simulator& simulator,
+                   const std::function<void(unsigned, PrimaryVariables&)>& change)
+{
+    auto& model = simulator.model();
+    auto& solution = model.solution(/*timeIdx=*/0);
+    for (unsigned cellIdx = 0; cellIdx < solution.size(); ++cellIdx) {
+        change(cellIdx, solution[cellIdx]);
+    }
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    const auto before = allQuantities(simulator);
+
+    // Updates the explicit quantities and the intensive quantities of
+    // the cells for which they changed.
+    simulator.problem().beginTimeStep();
+    const auto partial = allQuantities(simulator);
+
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    const auto full = allQuantities(simulator);
+
+    BOOST_REQUIRE_EQUAL(partial.size(), full.size());
+    for (std::size_t cellIdx = 0; cellIdx < full.size(); ++cellIdx) {
+        BOOST_TEST_CONTEXT("cell " << cellIdx) {
+            BOOST_CHECK(partial[cellIdx] == full[cellIdx]);
+        }
+    }
+
+    return before != full;
+}
+
+struct ExplicitQuantitiesFixture
+{
+    ExplicitQuantitiesFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::EclGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+}
+
+BOOST_GLOBAL_FIXTURE(ExplicitQuantitiesFixture);
+
+BOOST_AUTO_TEST_CASE(ChangedCellsMatchFullUpdate)
+{
+    auto simulator = initSimulator("explicit_quantities.DATA");
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(86400.0);
+    simulator->problem().beginEpisode();
+
+    // Only cells with water saturation as primary variable are changed.
+    const auto changeSw = [](double delta)
+    {
+        return [delta](unsigned cellIdx, PrimaryVariables& priVars)
+        {
+            if (cellIdx % 3 != 0 ||
+                priVars.primaryVarsMeaningWater() != PrimaryVariables::WaterMeaning::Sw) {
+                return;
+            }
+            priVars[Indices::waterSwitchIdx] =
+                std::clamp(priVars[Indices::waterSwitchIdx] + delta, 0.15, 0.95);
+        };
+    };
+    const auto changePressure = [](double delta)
+    {
+        return [delta](unsigned cellIdx, PrimaryVariables& priVars)
+        {
+            if (cellIdx % 2 == 0) {
+                priVars[Indices::pressureSwitchIdx] += delta;
+            }
+        };
+    };
+
+    // Drainage and imbibition update the hysteresis state.
+    checkTimeStep(*simulator, changeSw(-0.2));
+    checkTimeStep(*simulator, changeSw(0.3));
+    checkTimeStep(*simulator, changeSw(-0.1));
+
+    // The pressure drop lowers the minimum pressure of the irreversible
+    // compaction, which removes the pressure derivative of the porosity.
+    BOOST_CHECK(checkTimeStep(*simulator, changePressure(-20.0e5)));
+
+    // A pressure increase does not change the minimum pressure, but the
+    // full update must still agree.
+    checkTimeStep(*simulator, changePressure(10.0e5));
+
+    // No change at all.
+    BOOST_CHECK(!checkTimeStep(*simulator, [](unsigned, PrimaryVariables&) {}));
+}
@@ -87,6 +87,22 @@ BOOST_AUTO_TEST_CASE(copySubMatrixAndMatrixEqual)
     BOOST_CHECK(Opm::Details::matrixEqual(m2, m3));
 }
 
+BOOST_AUTO_TEST_CASE(copySubMatrixWithOffsets)
+{
+    auto m1 = build3x3BlockMatrix();
+    std::vector<int> indices = {1, 2};
+    auto m2 = Opm::Details::extractMatrix(m1, indices);
+    const auto offsets = Opm::Details::subMatrixOffsets(m1, indices, m2);
+    BOOST_CHECK_EQUAL(offsets.size(), m2.nonzeroes());
+
+    // A copy of m1 has the same pattern, so the offsets remain valid.
+    auto m3 = m1;
+    m3[2][1][0][0] = 0.1234;
+    m3[1][1][1][1] = 0.5678;
+    Opm::Details::copySubMatrix(m3, offsets, m2);
+    BOOST_CHECK(Opm::Details::matrixEqual(m2, Opm::Details::extractMatrix(m3, indices)));
+}
+
 BOOST_AUTO_TEST_CASE(vectorOps)
 {
     V v1(4);
@@ -0,0 +1,70 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestFusedReduction
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/FusedReduction.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(SumAndMax)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    const int rank = cc.rank();
+    const int size = cc.size();
+
+    Opm::FusedReduction reduction(cc);
+    const auto maxRank = reduction.addMax(rank);
+    const auto sumRank = reduction.addSum(rank);
+    const auto maxNeg = reduction.addMax(-rank - 1.0);
+    const auto sumOne = reduction.addSum(1.0);
+    reduction.start();
+    reduction.finish();
+
+    BOOST_CHECK_EQUAL(reduction.max(maxRank), size - 1.0);
+    BOOST_CHECK_EQUAL(reduction.sum(sumRank), size * (size - 1) / 2.0);
+    BOOST_CHECK_EQUAL(reduction.max(maxNeg), -1.0);
+    BOOST_CHECK_EQUAL(reduction.sum(sumOne), static_cast<double>(size));
+}
+
+BOOST_AUTO_TEST_CASE(OnlyMax)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+
+    Opm::FusedReduction reduction(cc);
+    const auto idx = reduction.addMax(cc.rank() == 0 ? 1.0 : 0.0);
+    reduction.start();
+    reduction.finish();
+
+    BOOST_CHECK_EQUAL(reduction.max(idx), 1.0);
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
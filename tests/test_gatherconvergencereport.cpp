@@ -106,6 +106,36 @@ BOOST_AUTO_TEST_CASE(EvenHaveFailure)
     }
 }
 
+BOOST_AUTO_TEST_CASE(NoFailuresNoMessages)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    using CR = Opm::ConvergenceReport;
+    CR cr{static_cast<double>(cc.rank())};
+    Opm::DeferredLogger logger;
+    const auto [global_cr, global_logger] = gatherConvergenceReportAndLogger(cr, logger, cc);
+    BOOST_CHECK(global_cr.converged());
+    BOOST_CHECK(global_cr.wellFailures().empty());
+    BOOST_CHECK_EQUAL(global_cr.reportTime(), cc.size() - 1.0);
+    BOOST_CHECK(global_logger.empty());
+}
+
+BOOST_AUTO_TEST_CASE(OneHasFailureAndMessage)
+{
+    auto cc = Dune::MPIHelper::getCollectiveCommunication();
+    using CR = Opm::ConvergenceReport;
+    CR cr;
+    Opm::DeferredLogger logger;
+    if (cc.rank() == cc.size() - 1) {
+        cr.setWellFailed({CR::WellFailure::Type::ControlBHP, CR::Severity::Normal, -1, "LASTWELL"});
+        logger.info("from last rank");
+    }
+    const auto [global_cr, global_logger] = gatherConvergenceReportAndLogger(cr, logger, cc);
+    BOOST_CHECK(!global_cr.converged());
+    BOOST_REQUIRE_EQUAL(global_cr.wellFailures().size(), 1u);
+    BOOST_CHECK_EQUAL(global_cr.wellFailures()[0].wellName(), "LASTWELL");
+    BOOST_CHECK(!global_logger.empty());
+}
+
 int main(int argc, char** argv)
 {
     Dune::MPIHelper::instance(argc, argv);
@@ -165,6 +165,34 @@ BOOST_AUTO_TEST_CASE(AllHaveOneMessage)
     }
 }
 
+BOOST_AUTO_TEST_CASE(StructuredMessages)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+
+    Opm::DeferredLogger local_deferredlogger;
+    local_deferredlogger.message(Log::MessageType::Info, "", "value {:.1f} from rank {}",
+                                 {0.5, static_cast<double>(cc.rank())});
+    local_deferredlogger.message(Log::MessageType::Info, "", "value {:.1f} from rank {}",
+                                 {1.5, static_cast<double>(cc.rank())});
+
+    Opm::DeferredLogger global_deferredlogger = gatherDeferredLogger(local_deferredlogger, cc);
+
+    if (cc.rank() == 0) {
+
+        global_deferredlogger.logMessages();
+
+        std::string expected;
+        for (int i=0; i<cc.size(); i++) {
+            expected += Log::prefixMessage(Log::MessageType::Info, "value 0.5 from rank "+std::to_string(i)) + "\n";
+            expected += Log::prefixMessage(Log::MessageType::Info, "value 1.5 from rank "+std::to_string(i)) + "\n";
+        }
+        BOOST_CHECK_EQUAL(log_stream.str(), expected);
+    }
+}
+
 int main(int argc, char** argv)
 {
     Dune::MPIHelper::instance(argc, argv);
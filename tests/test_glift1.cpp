@@ -31,6 +31,10 @@
 #include <ebos/ebos.hh>
 #include <opm/models/utils/start.hh>
 
+#include <opm/common/OpmLog/LogUtil.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/StreamLog.hpp>
+
 #include <opm/input/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
@@ -49,10 +53,15 @@
 #include <dune/common/parallel/mpihelper.hh>
 #endif
 
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #include <exception>
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -64,12 +73,35 @@
 #include <boost/test/tools/floating_point_comparison.hpp>
 #endif
 
+namespace Opm {
+    // Exposes the gas lift optimization of the well model.
+    template<class TypeTag>
+    class TestGliftWellModel : public BlackoilWellModel<TypeTag>
+    {
+    public:
+        using BlackoilWellModel<TypeTag>::BlackoilWellModel;
+        using BlackoilWellModel<TypeTag>::maybeDoGasLiftOptimize;
+
+        // The gas lift debug output disables the concurrent optimization.
+        void setGliftDebug(bool glift_debug)
+        { this->glift_debug = glift_debug; }
+    };
+}
+
 namespace Opm::Properties {
     namespace TTag {
         struct TestGliftTypeTag {
             using InheritsFrom = std::tuple<EbosTypeTag>;
         };
+        struct TestGliftConcurrentTypeTag {
+            using InheritsFrom = std::tuple<TestGliftTypeTag>;
+        };
     }
+
+    template<class TypeTag>
+    struct EclWellModel<TypeTag, TTag::TestGliftConcurrentTypeTag> {
+        using type = TestGliftWellModel<TypeTag>;
+    };
 }
 
 template <class TypeTag>
@@ -202,3 +234,76 @@ BOOST_AUTO_TEST_CASE(G1)
     BOOST_CHECK(!state->increase().has_value());
 }
 
+namespace {
+
+struct GliftResult {
+    std::vector<double> alq;
+    std::string log;
+};
+
+GliftResult runGasLift(const int num_threads, const bool serial)
+{
+    using TypeTag = Opm::Properties::TTag::TestGliftConcurrentTypeTag;
+
+#if HAVE_OPENMP
+    omp_set_num_threads(num_threads);
+#else
+    (void)num_threads;
+#endif
+
+    auto simulator = initSimulator<TypeTag>("GLIFT_CONCURRENT.DATA");
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(43200);  // 12 hours
+    simulator->model().newtonMethod().setIterationIndex(0);
+    auto& well_model = simulator->problem().wellModel();
+    const int report_step_idx = 0;
+    well_model.beginReportStep(report_step_idx);
+    well_model.beginTimeStep();
+    Opm::DeferredLogger deferred_logger;
+    well_model.calculateExplicitQuantities(deferred_logger);
+    well_model.prepareTimeStep(deferred_logger);
+    well_model.updateWellControls(false, deferred_logger);
+    well_model.initPrimaryVariablesEvaluation();
+
+    well_model.setGliftDebug(serial);
+    Opm::DeferredLogger glift_logger;
+    well_model.maybeDoGasLiftOptimize(glift_logger);
+
+    GliftResult result;
+    for (const auto& well : simulator->vanguard().schedule().getWells(report_step_idx)) {
+        if (well.isProducer()) {
+            result.alq.push_back(well_model.wellState().getALQ(well.name()));
+        }
+    }
+
+    std::ostringstream log_stream;
+    Opm::OpmLog::removeAllBackends();
+    Opm::OpmLog::addBackend("STREAM", std::make_shared<Opm::StreamLog>(log_stream, Opm::Log::DefaultMessageTypes));
+    glift_logger.logMessages();
+    Opm::OpmLog::removeAllBackends();
+    result.log = log_stream.str();
+
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentMatchesSerial)
+{
+    const auto serial = runGasLift(/*num_threads=*/1, /*serial=*/true);
+    const auto single_thread = runGasLift(/*num_threads=*/1, /*serial=*/false);
+    const auto multi_thread = runGasLift(/*num_threads=*/4, /*serial=*/false);
+
+    BOOST_REQUIRE_EQUAL(serial.alq.size(), 5);
+    BOOST_CHECK_EQUAL_COLLECTIONS(single_thread.alq.begin(), single_thread.alq.end(),
+                                  serial.alq.begin(), serial.alq.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(multi_thread.alq.begin(), multi_thread.alq.end(),
+                                  serial.alq.begin(), serial.alq.end());
+
+    // The messages are ordered by well, whatever the number of threads.
+    BOOST_CHECK_EQUAL(multi_thread.log, single_thread.log);
+}
@@ -0,0 +1,87 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestLoadBalanceMonitor
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(Balanced)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::LoadBalanceMonitor monitor(cc, 1.1);
+    BOOST_CHECK(monitor.active());
+
+    Opm::SimulatorReportSingle report;
+    report.assemble_time = 2.0;
+    report.assemble_time_well = 0.5;
+    report.linear_solve_time = 1.0;
+    BOOST_CHECK(!monitor.reportStepCompleted(report));
+    BOOST_CHECK_CLOSE(monitor.imbalance(), 1.0, 1e-12);
+    BOOST_CHECK_CLOSE(monitor.maxCost(Opm::LoadBalanceMonitor::Assembly), 1.5, 1e-12);
+    BOOST_CHECK_CLOSE(monitor.maxCost(Opm::LoadBalanceMonitor::Wells), 0.5, 1e-12);
+    BOOST_CHECK_CLOSE(monitor.maxCost(Opm::LoadBalanceMonitor::Total), 3.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(Imbalanced)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::LoadBalanceMonitor monitor(cc, 1.1);
+
+    // First report step is balanced, second one costs rank + 1 seconds.
+    Opm::SimulatorReportSingle report;
+    report.linear_solve_time = 10.0;
+    monitor.reportStepCompleted(report);
+
+    report.linear_solve_time += cc.rank() + 1.0;
+    const bool imbalanced = monitor.reportStepCompleted(report);
+
+    const double mean = (cc.size() + 1.0) / 2.0;
+    BOOST_CHECK_EQUAL(imbalanced, cc.size() > 1);
+    BOOST_CHECK_CLOSE(monitor.meanCost(Opm::LoadBalanceMonitor::LinearSolve), mean, 1e-12);
+    BOOST_CHECK_CLOSE(monitor.maxCost(Opm::LoadBalanceMonitor::LinearSolve), cc.size(), 1e-12);
+    BOOST_CHECK_CLOSE(monitor.imbalance(), cc.size() / mean, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(Inactive)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::LoadBalanceMonitor monitor(cc, 0.0);
+    BOOST_CHECK(!monitor.active());
+
+    Opm::SimulatorReportSingle report;
+    report.assemble_time = cc.rank();
+    BOOST_CHECK(!monitor.reportStepCompleted(report));
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,111 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestMemoryUsage
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/MemoryUsage.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(Vectors)
+{
+    std::vector<double> v;
+    v.reserve(100);
+    BOOST_CHECK_EQUAL(Opm::heapBytes(v), 100 * sizeof(double));
+
+    // The inner vectors are counted as well.
+    const std::vector<std::vector<int>> vv(10, std::vector<int>(20));
+    BOOST_CHECK_EQUAL(Opm::heapBytes(vv),
+                      10 * sizeof(std::vector<int>) + 10 * 20 * sizeof(int));
+
+    std::array<std::pair<std::string, std::pair<std::vector<int>, std::vector<double>>>, 3> flows{};
+    flows[1].second.first.resize(5);
+    flows[1].second.second.resize(5);
+    BOOST_CHECK_EQUAL(Opm::heapBytes(flows), 5 * sizeof(int) + 5 * sizeof(double));
+
+    BOOST_CHECK_EQUAL(Opm::totalHeapBytes(v, vv, flows),
+                      Opm::heapBytes(v) + Opm::heapBytes(vv) + Opm::heapBytes(flows));
+}
+
+BOOST_AUTO_TEST_CASE(Maps)
+{
+    std::map<int, std::vector<double>> m;
+    BOOST_CHECK_EQUAL(Opm::heapBytes(m), 0u);
+    m[1].resize(10);
+    BOOST_CHECK(Opm::heapBytes(m) > 10 * sizeof(double) + sizeof(std::pair<const int, std::vector<double>>));
+
+    std::unordered_map<std::uint64_t, double> um;
+    um.reserve(1000);
+    const auto empty = Opm::heapBytes(um);
+    BOOST_CHECK(empty >= um.bucket_count() * sizeof(void*));
+    um[1] = 1.0;
+    BOOST_CHECK(Opm::heapBytes(um) > empty);
+
+    // Short strings do not allocate.
+    BOOST_CHECK_EQUAL(Opm::heapBytes(std::string("PRESSURE")), 0u);
+    BOOST_CHECK(Opm::heapBytes(std::string(100, 'x')) > 100u);
+}
+
+BOOST_AUTO_TEST_CASE(Report)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+
+    // Every process holds as many MiB as its rank.
+    Opm::MemoryReport report;
+    report.add("Subsystem", cc.rank() * 1024 * 1024);
+    report.add("Empty", 0);
+    BOOST_CHECK_EQUAL(report.total(), static_cast<std::size_t>(cc.rank()) * 1024 * 1024);
+
+    const auto table = report.table(cc, "Title");
+    if (cc.rank() != 0) {
+        BOOST_CHECK(table.empty());
+        return;
+    }
+
+    BOOST_CHECK_EQUAL(table.rfind("Title (" + std::to_string(cc.size()) + " processes)", 0), 0u);
+    const auto expected = fmt::format("{:<32}{:>12.1f}{:>12.1f}{:>12.1f}{:>10}\n",
+                                      "Subsystem", 0.0, (cc.size() - 1) / 2.0,
+                                      static_cast<double>(cc.size() - 1), cc.size() - 1);
+    BOOST_CHECK(table.find(expected) != std::string::npos);
+    BOOST_CHECK(table.find("Process peak resident") != std::string::npos);
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
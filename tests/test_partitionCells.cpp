@@ -24,6 +24,38 @@
 
 #include <opm/simulators/flow/partitionCells.hpp>
 
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct MPIFixture
+{
+    MPIFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+        Dune::MPIHelper::instance(argc, argv);
+    }
+};
+
+Opm::Parallel::Communication comm()
+{
+    return Dune::MPIHelper::getCommunication();
+}
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
 
 BOOST_AUTO_TEST_CASE(FileBased)
 {
@@ -57,3 +89,89 @@ BOOST_AUTO_TEST_CASE(Simple2)
 
 }
 
+BOOST_AUTO_TEST_CASE(BalancedDomainsNotRepartitioned)
+{
+    if (comm().size() > 1) {
+        return;
+    }
+
+    // Two domains of four cells with the same cost, one cell outside.
+    const std::vector<int> cell_domain = { 0, 0, 0, 0, 1, 1, 1, 1, -1 };
+    BOOST_CHECK(Opm::imbalancedDomainCellWeights(cell_domain, { 3.0, 3.0 }, 1.1, comm()).empty());
+
+    // Small domain with many iterations costs as much as large domain with few.
+    const std::vector<int> uneven = { 0, 0, 1, 1, 1, 1, 1, 1 };
+    BOOST_CHECK(Opm::imbalancedDomainCellWeights(uneven, { 2.0, 0.0 }, 1.1, comm()).empty());
+
+    // Without any cells there is nothing to balance.
+    BOOST_CHECK(Opm::imbalancedDomainCellWeights({ -1, -1 }, { 5.0, 0.0 }, 1.1, comm()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ImbalancedDomainsRepartitioned)
+{
+    if (comm().size() > 1) {
+        return;
+    }
+
+    // Costs 4*(1 + 5) = 24 and 4*(1 + 1) = 8, largest is 1.5 times the mean.
+    const std::vector<int> cell_domain = { 0, 0, 0, 0, 1, 1, 1, 1, -1 };
+    const std::vector<double> iterations = { 5.0, 1.0 };
+
+    const auto weights = Opm::imbalancedDomainCellWeights(cell_domain, iterations, 1.2, comm());
+    const std::vector<double> expected = { 6.0, 6.0, 6.0, 6.0, 2.0, 2.0, 2.0, 2.0, 1.0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), weights.begin(), weights.end());
+
+    // Imbalance below the threshold.
+    BOOST_CHECK(Opm::imbalancedDomainCellWeights(cell_domain, iterations, 1.5, comm()).empty());
+}
+
+#if HAVE_MPI && HAVE_ZOLTAN
+BOOST_AUTO_TEST_CASE(ZoltanDomainsFromWeights)
+{
+    if (comm().size() > 1) {
+        return;
+    }
+
+    Dune::CpGrid grid;
+    grid.createCartesian(std::array<int, 3>{ 40, 1, 1 }, std::array<double, 3>{ 1.0, 1.0, 1.0 });
+    const auto& grid_view = grid.leafGridView();
+
+    using GridView = std::remove_cv_t<std::remove_reference_t<decltype(grid_view)>>;
+    using Element = typename GridView::template Codim<0>::Entity;
+
+    // Cost of previous local solves, the first domain was the expensive one.
+    const std::vector<int> cell_domain = [] {
+        std::vector<int> part(40, 1);
+        std::fill(part.begin(), part.begin() + 20, 0);
+        return part;
+    }();
+    const auto weights = Opm::imbalancedDomainCellWeights(cell_domain, { 8.0, 0.0 }, 1.1, comm());
+    BOOST_REQUIRE_EQUAL(weights.size(), cell_domain.size());
+
+    auto zoltan_ctrl = Opm::ZoltanPartitioningControl<Element>{};
+    zoltan_ctrl.index = [&grid_view](const Element& element)
+    {
+        return grid_view.indexSet().index(element);
+    };
+    zoltan_ctrl.local_to_global = [](const int elemIdx) { return elemIdx; };
+    zoltan_ctrl.cell_weight = [&weights](const int elemIdx) { return weights[elemIdx]; };
+
+    const auto [part, num_part] = Opm::partitionCells("zoltan", 2, grid_view,
+                                                      std::vector<Opm::Well>{}, zoltan_ctrl);
+    BOOST_REQUIRE_EQUAL(num_part, 2);
+    BOOST_REQUIRE_EQUAL(part.size(), cell_domain.size());
+
+    // Cost of the new domains, with the same iterations per cell.
+    std::array<double, 2> cost{};
+    std::array<int, 2> size{};
+    for (std::size_t cell = 0; cell < part.size(); ++cell) {
+        cost[part[cell]] += weights[cell];
+        ++size[part[cell]];
+    }
+
+    // The new domains are balanced by cost rather than by size.
+    BOOST_CHECK(size[0] != size[1]);
+    const double mean_cost = 0.5 * (cost[0] + cost[1]);
+    BOOST_CHECK_LT(std::max(cost[0], cost[1]), 1.1 * mean_cost);
+}
+#endif // HAVE_MPI && HAVE_ZOLTAN
@@ -0,0 +1,176 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestTimerTree
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/TimerTree.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <thread>
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+namespace {
+
+void inner()
+{
+    OPM_TIMEBLOCK_TREE(inner);
+}
+
+void outer(const int calls)
+{
+    OPM_TIMEBLOCK_TREE(outer);
+    for (int i = 0; i < calls; ++i) {
+        inner();
+    }
+}
+
+std::size_t count(const std::string& text, const std::string& pattern)
+{
+    std::size_t n = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::TimerTree::setEnabled(false);
+    Opm::TimerTree::reset();
+    outer(2);
+
+    const auto json = Opm::TimerTree::json(cc);
+    if (cc.rank() == 0) {
+        BOOST_CHECK_EQUAL(count(json, "\"name\""), 0u);
+    } else {
+        BOOST_CHECK(json.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Nested)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::TimerTree::setEnabled(true);
+    Opm::TimerTree::reset();
+
+    // Every process calls inner() once per rank, the last process also
+    // enters a block no other process has.
+    outer(cc.rank() + 1);
+    if (cc.rank() == cc.size() - 1) {
+        OPM_TIMEBLOCK_TREE(last);
+    }
+    Opm::TimerTree::setEnabled(false);
+
+    const auto json = Opm::TimerTree::json(cc);
+    if (cc.rank() != 0) {
+        BOOST_CHECK(json.empty());
+        return;
+    }
+
+    BOOST_CHECK(json.find("\"processes\": " + std::to_string(cc.size())) != std::string::npos);
+    BOOST_CHECK_EQUAL(count(json, "\"name\""), 3u);
+
+    // inner is a child of outer.
+    const auto outerPos = json.find("\"name\": \"outer\"");
+    const auto innerPos = json.find("\"name\": \"inner\"");
+    const auto lastPos = json.find("\"name\": \"last\"");
+    BOOST_REQUIRE(outerPos != std::string::npos);
+    BOOST_REQUIRE(innerPos != std::string::npos);
+    BOOST_REQUIRE(lastPos != std::string::npos);
+    BOOST_CHECK(outerPos < innerPos);
+    BOOST_CHECK(innerPos < lastPos);
+
+    const auto innerCalls = json.find("\"calls\"", innerPos);
+    const double mean = (cc.size() + 1.0) / 2.0;
+    BOOST_CHECK_EQUAL(json.substr(innerCalls, json.find('\n', innerCalls) - innerCalls),
+                      "\"calls\": { \"min\": 1, \"mean\": " + fmt::format("{}", mean) +
+                      ", \"max\": " + std::to_string(cc.size()) + " },");
+
+    // Processes that never entered a block count as zero.
+    const auto lastCalls = json.find("\"calls\"", lastPos);
+    const std::string lastMin = "\"calls\": { \"min\": " + std::string(cc.size() > 1 ? "0," : "1,");
+    BOOST_CHECK_EQUAL(json.substr(lastCalls, lastMin.size()), lastMin);
+}
+
+BOOST_AUTO_TEST_CASE(OtherThread)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::TimerTree::setEnabled(true);
+    Opm::TimerTree::reset();
+    std::thread worker([]() { outer(1); });
+    worker.join();
+    Opm::TimerTree::setEnabled(false);
+
+    const auto json = Opm::TimerTree::json(cc);
+    if (cc.rank() == 0) {
+        BOOST_CHECK_EQUAL(count(json, "\"name\""), 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ResetInOpenBlock)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    Opm::TimerTree::setEnabled(true);
+    Opm::TimerTree::reset();
+    outer(1);
+    {
+        OPM_TIMEBLOCK_TREE(step);
+        outer(1);
+        Opm::TimerTree::reset();
+        inner();
+    }
+    Opm::TimerTree::setEnabled(false);
+
+    // Only the open block and what was recorded after the reset remain.
+    const auto json = Opm::TimerTree::json(cc);
+    if (cc.rank() != 0) {
+        return;
+    }
+    BOOST_CHECK_EQUAL(count(json, "\"name\""), 2u);
+    const auto stepPos = json.find("\"name\": \"step\"");
+    const auto innerPos = json.find("\"name\": \"inner\"");
+    BOOST_REQUIRE(stepPos != std::string::npos);
+    BOOST_REQUIRE(innerPos != std::string::npos);
+    BOOST_CHECK(stepPos < innerPos);
+    BOOST_CHECK(json.find("\"name\": \"outer\"") == std::string::npos);
+
+    const auto stepCalls = json.find("\"calls\"", stepPos);
+    const std::string one = "\"calls\": { \"min\": 1, \"mean\": 1, \"max\": 1 },";
+    BOOST_CHECK_EQUAL(json.substr(stepCalls, one.size()), one);
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
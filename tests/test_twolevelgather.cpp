@@ -0,0 +1,97 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestTwoLevelGather
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/TwoLevelGather.hpp>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Buffer with a size and content depending on the rank. Rank 1 is empty.
+std::vector<char> localBuffer(int rank)
+{
+    const auto text = std::string(rank == 1 ? 0 : 3 * rank + 1, 'a' + rank);
+    return {text.begin(), text.end()};
+}
+
+void checkGathered(const std::vector<char>& buffer,
+                   const std::vector<int>& displ,
+                   int size)
+{
+    BOOST_REQUIRE_EQUAL(displ.size(), static_cast<std::size_t>(size + 1));
+    BOOST_CHECK_EQUAL(displ.back(), static_cast<int>(buffer.size()));
+    for (int p = 0; p < size; ++p) {
+        const auto expected = localBuffer(p);
+        BOOST_CHECK_EQUAL_COLLECTIONS(buffer.begin() + displ[p],
+                                      buffer.begin() + displ[p + 1],
+                                      expected.begin(), expected.end());
+    }
+}
+
+} // Anonymous namespace
+
+bool
+init_unit_test_func()
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(AllGather)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    const auto local = localBuffer(cc.rank());
+
+    for (const auto method : {Opm::GatherMethod::Flat, Opm::GatherMethod::TwoLevel}) {
+        std::vector<int> displ;
+        const auto buffer = Opm::allGatherBuffers(local, displ, cc, method);
+        checkGathered(buffer, displ, cc.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Gather)
+{
+    const auto& cc = Dune::MPIHelper::getCommunication();
+    const auto local = localBuffer(cc.rank());
+
+    for (const auto method : {Opm::GatherMethod::Flat, Opm::GatherMethod::TwoLevel}) {
+        for (int root = 0; root < cc.size(); root += 2) {
+            std::vector<int> displ;
+            const auto buffer = Opm::gatherBuffers(local, displ, root, cc, method);
+            if (cc.rank() == root) {
+                checkGathered(buffer, displ, cc.size());
+            } else {
+                BOOST_CHECK(buffer.empty());
+                BOOST_CHECK(displ.empty());
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,312 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE WellPerfDataTest
+
+#include "MpiFixture.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/BlackoilWellModelGeneric.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/simulators/wells/PerforationData.hpp>
+
+#include <opm/core/props/phaseUsageFromDeck.hpp>
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+#include <opm/input/eclipse/Python/Python.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/SummaryState.hpp>
+#include <opm/input/eclipse/Schedule/Well/Connection.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
+
+#include <opm/common/utility/TimeService.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+namespace {
+
+    Opm::Deck createDeck()
+    {
+        return Opm::Parser{}.parseString(R"(RUNSPEC
+DIMENS
+  5 5 3 /
+OIL
+WATER
+START
+ 1 JAN 2020 /
+GRID
+DXV
+  5*100.0 /
+DYV
+  5*100.0 /
+DZV
+  3*10.0 /
+DEPTHZ
+  36*2000.0 /
+PERMX
+  75*100.0 /
+PERMY
+  75*100.0 /
+PERMZ
+  75*10.0 /
+PORO
+  75*0.3 /
+SCHEDULE
+WELSPECS
+  'P1' 'G' 1 1 1* 'OIL' /
+  'P2' 'G' 5 5 1* 'OIL' /
+  'P3' 'G' 3 3 1* 'OIL' /
+/
+COMPDAT
+  'P1' 0 0 1 3 'OPEN' 1* 1* 0.2 /
+  'P2' 0 0 1 3 'OPEN' 1* 1* 0.2 /
+  'P3' 0 0 1 3 'OPEN' 1* 1* 0.2 /
+/
+WCONPROD
+  'P1' 'OPEN' 'ORAT' 1000 /
+  'P2' 'OPEN' 'ORAT' 1000 /
+  'P3' 'OPEN' 'ORAT' 1000 /
+/
+TSTEP
+  10 /
+COMPDAT
+  'P2' 0 0 3 3 'SHUT' 1* 1* 0.2 /
+/
+WELPI
+  'P1' 50.0 /
+/
+TSTEP
+  10 /
+TSTEP
+  10 /
+END
+)");
+    }
+
+    /// Well model which only sets up the local well structure of a
+    /// serial run.
+    class PerfDataWellModel : public Opm::BlackoilWellModelGeneric
+    {
+    public:
+        PerfDataWellModel(Opm::Schedule&                    schedule,
+                          const Opm::SummaryState&          summaryState,
+                          const Opm::EclipseState&          eclState,
+                          const Opm::PhaseUsage&            phaseUsage,
+                          const Opm::Parallel::Communication& comm)
+            : Opm::BlackoilWellModelGeneric(schedule, summaryState, eclState, phaseUsage, comm)
+            , dims_(eclState.gridDims().getNXYZ())
+        {
+            auto names = schedule.wellNames();
+            std::sort(names.begin(), names.end());
+
+            this->parallel_well_info_.reserve(names.size());
+            for (const auto& name : names) {
+                this->parallel_well_info_.emplace_back(std::make_pair(name, true), comm);
+            }
+        }
+
+        /// Local well structure at the start of the simulation.
+        void initialize(const int reportStepIdx)
+        {
+            this->wells_ecl_ = this->getLocalWells(reportStepIdx);
+            this->local_parallel_well_info_ =
+                this->createLocalParallelWellInfo(this->wells_ecl_);
+
+            this->initializeWellPerfData();
+        }
+
+        /// Local well structure at the start of a report step, as in
+        /// BlackoilWellModel::initializeLocalWellStructure().
+        void beginReportStep(const int reportStepIdx)
+        {
+            const auto previousWells =
+                std::exchange(this->wells_ecl_, this->getLocalWells(reportStepIdx));
+            this->local_parallel_well_info_ =
+                this->createLocalParallelWellInfo(this->wells_ecl_);
+
+            this->initializeWellPerfData(previousWells);
+        }
+
+        const std::vector<Opm::PerforationData>& perfData(const std::string& name) const
+        {
+            const auto well = std::find_if(this->wells_ecl_.begin(), this->wells_ecl_.end(),
+                                           [&name](const Opm::Well& w) { return w.name() == name; });
+            BOOST_REQUIRE(well != this->wells_ecl_.end());
+
+            return this->well_perf_data_[std::distance(this->wells_ecl_.begin(), well)];
+        }
+
+    protected:
+        void calcRates(const int, const int, const std::vector<double>&, std::vector<double>&) override
+        {}
+
+        void calcInjRates(const int, const int, std::vector<double>&) override
+        {}
+
+        void computePotentials(const std::size_t, const Opm::WellState&, std::string&,
+                               Opm::ExceptionType::ExcEnum&, Opm::DeferredLogger&) override
+        {}
+
+        void createWellContainer(const int) override
+        {}
+
+        void initWellContainer(const int) override
+        {}
+
+        void calculateProductivityIndexValuesShutWells(const int, Opm::DeferredLogger&) override
+        {}
+
+        void calculateProductivityIndexValues(Opm::DeferredLogger&) override
+        {}
+
+        // All cells of the grid are active.
+        int compressedIndexForInterior(const int cartesian_cell_idx) const override
+        {
+            return (cartesian_cell_idx < this->dims_) ? cartesian_cell_idx : -1;
+        }
+
+    private:
+        int dims_;
+    };
+
+    struct Setup
+    {
+        Setup()
+            : deck    (createDeck())
+            , es      (deck)
+            , pu      (Opm::phaseUsageFromDeck(es))
+            , python  (std::make_shared<Opm::Python>())
+            , sched   (deck, es, python)
+            , st      (Opm::TimeService::from_time_t(sched.getStartTime()))
+            , model   (sched, st, es, pu, comm)
+        {}
+
+        Opm::Parallel::Communication comm{};
+        Opm::Deck deck;
+        Opm::EclipseState es;
+        Opm::PhaseUsage pu;
+        std::shared_ptr<Opm::Python> python;
+        Opm::Schedule sched;
+        Opm::SummaryState st;
+        PerfDataWellModel model;
+    };
+
+    std::vector<double> connectionFactors(const std::vector<Opm::PerforationData>& perfData)
+    {
+        auto cf = std::vector<double>{};
+        for (const auto& pd : perfData) {
+            cf.push_back(pd.connection_transmissibility_factor);
+        }
+
+        return cf;
+    }
+
+    std::vector<double> openConnectionFactors(const Opm::Well& well)
+    {
+        auto cf = std::vector<double>{};
+        for (const auto& conn : well.getConnections()) {
+            if (conn.state() == Opm::Connection::State::OPEN) {
+                cf.push_back(conn.CF());
+            }
+        }
+
+        return cf;
+    }
+
+} // Anonymous namespace
+
+// The perforation data of a well is reused by moving it, which keeps its
+// storage.  Rebuilt perforation data is allocated anew while the previous
+// data is still alive, so its storage differs.
+
+BOOST_AUTO_TEST_CASE(UnchangedConnectionsReused)
+{
+    auto setup = Setup{};
+    auto& model = setup.model;
+
+    model.initialize(0);
+    const auto* p3 = model.perfData("P3").data();
+
+    model.beginReportStep(1);
+
+    BOOST_CHECK_EQUAL(model.perfData("P3").size(), std::size_t{3});
+    BOOST_CHECK_MESSAGE(model.perfData("P3").data() == p3,
+                        "Perforation data of well with unchanged "
+                        "connections must be reused");
+}
+
+BOOST_AUTO_TEST_CASE(ChangedConnectionsRebuilt)
+{
+    auto setup = Setup{};
+    auto& model = setup.model;
+
+    model.initialize(0);
+    const auto* p2 = model.perfData("P2").data();
+    BOOST_CHECK_EQUAL(model.perfData("P2").size(), std::size_t{3});
+
+    model.beginReportStep(1);
+
+    BOOST_CHECK_MESSAGE(model.perfData("P2").data() != p2,
+                        "Perforation data of well with changed "
+                        "connections must be rebuilt");
+    BOOST_CHECK_EQUAL(model.perfData("P2").size(), std::size_t{2});
+}
+
+BOOST_AUTO_TEST_CASE(WellPIScalingRebuilt)
+{
+    auto setup = Setup{};
+    auto& model = setup.model;
+
+    model.initialize(0);
+    model.beginReportStep(1);
+
+    const auto* p1 = model.perfData("P1").data();
+    const auto* p3 = model.perfData("P3").data();
+    const auto cfBefore = connectionFactors(model.perfData("P1"));
+    BOOST_CHECK(cfBefore == openConnectionFactors(setup.sched.getWell("P1", 1)));
+
+    // Rescale as runWellPIScaling() does for a current PI of half the
+    // target PI, which doubles the connection factors.
+    const auto targetPI = setup.sched.getWell("P1", 1).getWellPIScalingFactor(1.0);
+    setup.sched.applyWellProdIndexScaling("P1", 1, 0.5 * targetPI);
+
+    const auto cfScaled = openConnectionFactors(setup.sched.getWell("P1", 2));
+    BOOST_REQUIRE(cfScaled != cfBefore);
+
+    model.beginReportStep(2);
+
+    BOOST_CHECK_MESSAGE(model.perfData("P1").data() != p1,
+                        "Perforation data of rescaled well must be rebuilt");
+    BOOST_CHECK(connectionFactors(model.perfData("P1")) == cfScaled);
+
+    BOOST_CHECK_MESSAGE(model.perfData("P3").data() == p3,
+                        "Perforation data of well with unchanged "
+                        "connections must be reused");
+}
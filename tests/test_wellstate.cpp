@@ -579,6 +579,100 @@ BOOST_AUTO_TEST_CASE(TESTPerfData) {
 }
 
 
+namespace {
+    bool perfDataBound(const Opm::WellState& wstate)
+    {
+        const auto& storage = wstate.perfDataStorage();
+        if (storage.numWells() != wstate.size()) {
+            return false;
+        }
+
+        std::size_t num_perf = 0;
+        for (std::size_t w = 0; w < wstate.size(); ++w) {
+            const auto& perf_data = wstate.well(w).perf_data;
+            if (!storage.isBound(w, perf_data) || storage.offset(w) != num_perf) {
+                return false;
+            }
+            if (!perf_data.empty() &&
+                perf_data.phase_rates.data() != &storage.phaseRates()[wstate.numPhases()*num_perf])
+            {
+                return false;
+            }
+            num_perf += perf_data.size();
+        }
+
+        return storage.numPerfs() == num_perf &&
+               storage.pressure().size() == num_perf;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TESTPerfDataStorage) {
+    const Setup setup{ "msw.data" };
+    const auto tstep = std::size_t{0};
+
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    auto wstate = buildWellState(setup, tstep, pinfos);
+    const auto& storage = wstate.perfDataStorage();
+    BOOST_CHECK(perfDataBound(wstate));
+
+    // Values written through the per-well accessors end up in the storage.
+    const auto last = wstate.size() - 1;
+    auto& ws = wstate.well(last);
+    const auto offset = storage.offset(last);
+    BOOST_REQUIRE(!ws.perf_data.empty());
+    ws.perf_data.pressure[0] = 123.0;
+    BOOST_CHECK_EQUAL(storage.pressure()[offset], 123.0);
+
+    // Copies are bound to their own storage.
+    auto copy = wstate;
+    BOOST_CHECK(copy == wstate);
+    BOOST_CHECK(perfDataBound(copy));
+    BOOST_CHECK(copy.perfDataStorage().pressure().data() != storage.pressure().data());
+    copy.well(last).perf_data.pressure[0] = 456.0;
+    BOOST_CHECK_EQUAL(storage.pressure()[offset], 123.0);
+    BOOST_CHECK_EQUAL(copy.perfDataStorage().pressure()[offset], 456.0);
+
+    // Assignment with unchanged perforation counts writes through.
+    const auto* pressure = storage.pressure().data();
+    wstate = copy;
+    BOOST_CHECK(perfDataBound(wstate));
+    BOOST_CHECK(storage.pressure().data() == pressure);
+    BOOST_CHECK_EQUAL(storage.pressure()[offset], 456.0);
+
+    // Moves keep the storage.
+    auto moved = std::move(copy);
+    BOOST_CHECK(perfDataBound(moved));
+}
+
+BOOST_AUTO_TEST_CASE(TESTPerfDataStorageResize) {
+    const Setup setup{ "msw.data" };
+    const auto tstep = std::size_t{0};
+
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    auto wstate = buildWellState(setup, tstep, pinfos);
+    const auto num_perf = wstate.perfDataStorage().numPerfs();
+
+    // Change the perforation count of one well in a copy.
+    auto copy = wstate;
+    auto& ws = copy.well(0);
+    const auto injector = !ws.producer;
+    ws.perf_data = Opm::PerfData(ws.perf_data.size() + 1, 0.0, injector, copy.numPhases());
+    ws.perf_data.pressure.back() = 789.0;
+
+    wstate = copy;
+    BOOST_CHECK(perfDataBound(wstate));
+    BOOST_CHECK_EQUAL(wstate.perfDataStorage().numPerfs(), num_perf + 1);
+    BOOST_CHECK_EQUAL(wstate.well(0).perf_data.pressure.back(), 789.0);
+    BOOST_CHECK(wstate == copy);
+
+    // Fewer wells.
+    Opm::ParallelWellInfo pinfo;
+    const auto dummy = Opm::WellState{pinfo};
+    wstate = dummy;
+    BOOST_CHECK(perfDataBound(wstate));
+    BOOST_CHECK_EQUAL(wstate.perfDataStorage().numWells(), std::size_t{1});
+}
+
 BOOST_AUTO_TEST_CASE(TestSingleWellState) {
     Opm::ParallelWellInfo pinfo;
     std::vector<Opm::PerforationData> connections = {{0,1,1,0,0},{1,1,1,0,1},{2,1,1,0,2}};